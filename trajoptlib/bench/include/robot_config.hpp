@@ -0,0 +1,67 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/geometry/translation2.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+
+/// A robot configuration from a Choreo project.
+struct RobotConfig {
+  /// The front left module's position relative to the robot's origin (m).
+  trajopt::Translation2d front_left{0.2794, 0.2794};
+
+  /// The back left module's position relative to the robot's origin (m).
+  trajopt::Translation2d back_left{-0.2794, 0.2794};
+
+  /// The mass of the robot (kg).
+  double mass = 68.0388555;
+
+  /// The moment of inertia of the robot about the origin (kg−m²).
+  double inertia = 6.0;
+
+  /// The gear ratio between the motors and the wheels.
+  double gearing = 6.5;
+
+  /// The radius of the wheels (m).
+  double radius = 0.0508;
+
+  /// The maximum angular velocity of the motors (rad/s).
+  double vmax = 628.3185307179587;
+
+  /// The maximum torque of the motors (N−m).
+  double tmax = 1.2;
+
+  /// The Coefficient of Friction (CoF) of the wheels.
+  double cof = 1.5;
+
+  /// The distance from the robot's origin to the front bumper (m).
+  double bumper_front = 0.4064;
+
+  /// The distance from the robot's origin to each side bumper (m).
+  double bumper_side = 0.4064;
+
+  /// The distance from the robot's origin to the back bumper (m).
+  double bumper_back = 0.4064;
+
+  /// The distance between the differential drivetrain's driverails (m).
+  double differential_trackwidth = 0.5588;
+
+  /// Returns the swerve drivetrain this configuration describes.
+  trajopt::SwerveDrivetrain swerve_drivetrain() const;
+
+  /// Returns the differential drivetrain this configuration describes.
+  trajopt::DifferentialDrivetrain differential_drivetrain() const;
+};
+
+/// Reads a robot configuration from the "config" object of a Choreo project or
+/// trajectory file.
+///
+/// Each value may be a plain number, as in a trajectory file, or an expression
+/// object with a "val" field, as in a project file. Missing values keep their
+/// defaults, which are those of a new Choreo project.
+///
+/// @param config The "config" object.
+/// @return The robot configuration.
+RobotConfig parse_robot_config(const nlohmann::json& config);
@@ -0,0 +1,260 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <concepts>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <trajopt/constraint/constraint.hpp>
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/geometry/pose2.hpp>
+#include <trajopt/geometry/translation2.hpp>
+
+/// Adds the waypoints, constraints, and control interval counts of a Choreo
+/// trajectory file's "snapshot" to a path builder.
+///
+/// This mirrors how Choreo's generator converts a snapshot into a path:
+/// waypoints that are only initial guesses become guess points of the
+/// surrounding segment, and field regions constrain the robot's origin and
+/// each bumper corner. The builder's bumpers must be set first.
+///
+/// @tparam Builder The path builder type (e.g., swerve, differential).
+/// @param builder The path builder.
+/// @param snapshot The "snapshot" object.
+template <typename Builder>
+void apply_snapshot(Builder& builder, const nlohmann::json& snapshot) {
+  constexpr bool is_differential =
+      std::same_as<Builder, trajopt::DifferentialPathBuilder>;
+
+  const auto& waypoints = snapshot.at("waypoints");
+  size_t snapshot_wpt_cnt = waypoints.size();
+
+  auto is_guess_point = [](const nlohmann::json& wpt) {
+    return wpt.value("isInitialGuess", false) &&
+           !wpt.at("fixHeading").get<bool>() &&
+           !wpt.at("fixTranslation").get<bool>();
+  };
+
+  // Snapshot indices of waypoints that are only initial guesses, and the
+  // positions of the remaining waypoints
+  std::vector<size_t> guess_point_indices;
+  std::vector<trajopt::Translation2d> wpt_translations;
+
+  std::vector<size_t> control_interval_counts;
+  std::vector<trajopt::Pose2d> guess_points_after_waypoint;
+  size_t wpt_cnt = 0;
+  for (size_t i = 0; i < snapshot_wpt_cnt; ++i) {
+    const auto& wpt = waypoints.at(i);
+    double x = wpt.at("x").get<double>();
+    double y = wpt.at("y").get<double>();
+    double heading = wpt.at("heading").get<double>();
+    size_t intervals = wpt.at("intervals").get<size_t>();
+
+    if (is_guess_point(wpt)) {
+      guess_point_indices.push_back(i);
+      guess_points_after_waypoint.emplace_back(x, y, heading);
+      if (!control_interval_counts.empty()) {
+        control_interval_counts.back() += intervals;
+      }
+      continue;
+    }
+
+    if (wpt_cnt > 0) {
+      builder.sgmt_initial_guess_points(wpt_cnt - 1,
+                                        guess_points_after_waypoint);
+    }
+    guess_points_after_waypoint.clear();
+
+    bool fix_translation = wpt.at("fixTranslation").get<bool>();
+    bool fix_heading = wpt.at("fixHeading").get<bool>();
+    if (fix_translation && fix_heading) {
+      builder.pose_wpt(wpt_cnt, x, y, heading);
+    } else if (fix_translation) {
+      builder.translation_wpt(wpt_cnt, x, y, heading);
+    } else {
+      builder.wpt_initial_guess_point(wpt_cnt, {x, y, heading});
+    }
+    wpt_translations.emplace_back(x, y);
+    ++wpt_cnt;
+
+    if (i != snapshot_wpt_cnt - 1) {
+      control_interval_counts.push_back(intervals);
+    }
+  }
+  builder.set_control_interval_counts(std::move(control_interval_counts));
+
+  // Returns the snapshot waypoint index a constraint scope refers to
+  auto snapshot_index =
+      [&](const nlohmann::json& id) -> std::optional<size_t> {
+    if (id.is_string()) {
+      if (snapshot_wpt_cnt > 0 && id == "first") {
+        return 0;
+      } else if (snapshot_wpt_cnt > 0 && id == "last") {
+        return snapshot_wpt_cnt - 1;
+      }
+    } else if (id.is_number_unsigned() &&
+               id.get<size_t>() < snapshot_wpt_cnt) {
+      return id.get<size_t>();
+    }
+    return std::nullopt;
+  };
+
+  // Converts a snapshot waypoint index to a path waypoint index
+  auto path_index = [&](size_t index) {
+    size_t guess_points_before = 0;
+    for (size_t guess_point_index : guess_point_indices) {
+      if (guess_point_index < index) {
+        ++guess_points_before;
+      }
+    }
+    return index - guess_points_before;
+  };
+
+  const auto& bumpers = builder.get_bumpers();
+
+  // Applies a constraint to a waypoint, or to a segment if to_index is set
+  auto apply = [&](size_t from_index, std::optional<size_t> to_index,
+                   const trajopt::Constraint& constraint) {
+    if (to_index.has_value()) {
+      builder.sgmt_constraint(from_index, to_index.value(), constraint);
+    } else {
+      builder.wpt_constraint(from_index, constraint);
+    }
+  };
+
+  for (const auto& entry : snapshot.at("constraints")) {
+    if (!entry.value("enabled", true)) {
+      continue;
+    }
+
+    const auto& data = entry.at("data");
+    std::string type = data.at("type").get<std::string>();
+    const auto& props = data.at("props");
+
+    // A scope end that isn't a valid waypoint makes this a waypoint
+    // constraint, the same as having no end
+    auto from = snapshot_index(entry.at("from"));
+    std::optional<size_t> to;
+    if (entry.contains("to") && !entry.at("to").is_null()) {
+      to = snapshot_index(entry.at("to"));
+    }
+    if (!from.has_value()) {
+      continue;
+    }
+
+    // Stop points only apply to waypoints, and lanes only to segments
+    if ((type == "StopPoint" && to.has_value()) ||
+        (type == "KeepInLane" && !to.has_value())) {
+      continue;
+    }
+    if (to.has_value() && to.value() < from.value()) {
+      std::swap(from, to);
+    }
+    if (to.has_value() && to.value() == from.value()) {
+      if (type == "KeepInLane") {
+        continue;
+      }
+      to.reset();
+    }
+
+    size_t from_index = path_index(from.value());
+    std::optional<size_t> to_index;
+    if (to.has_value()) {
+      to_index = path_index(to.value());
+    }
+
+    if (type == "PointAt") {
+      // Differential drivetrains can't point at a target along a segment
+      if (is_differential && to_index.has_value()) {
+        continue;
+      }
+      apply(from_index, to_index,
+            trajopt::PointAtConstraint{
+                {props.at("x").get<double>(), props.at("y").get<double>()},
+                props.at("tolerance").get<double>(),
+                props.at("flip").get<bool>()});
+    } else if (type == "MaxVelocity") {
+      apply(from_index, to_index,
+            trajopt::LinearVelocityMaxMagnitudeConstraint{
+                props.at("max").get<double>()});
+    } else if (type == "MaxAcceleration") {
+      apply(from_index, to_index,
+            trajopt::LinearAccelerationMaxMagnitudeConstraint{
+                props.at("max").get<double>()});
+    } else if (type == "MaxAngularVelocity") {
+      apply(from_index, to_index,
+            trajopt::AngularVelocityMaxMagnitudeConstraint{
+                props.at("max").get<double>()});
+    } else if (type == "StopPoint") {
+      apply(from_index, to_index,
+            trajopt::LinearVelocityMaxMagnitudeConstraint{0.0});
+      apply(from_index, to_index,
+            trajopt::AngularVelocityMaxMagnitudeConstraint{0.0});
+    } else if (type == "KeepInCircle") {
+      trajopt::Translation2d center{props.at("x").get<double>(),
+                                    props.at("y").get<double>()};
+      double radius = props.at("r").get<double>();
+      for (const auto& bumper : bumpers) {
+        for (const auto& corner : bumper.points) {
+          apply(from_index, to_index,
+                trajopt::PointPointMaxConstraint{corner, center, radius});
+        }
+      }
+      if (!to_index.has_value()) {
+        apply(from_index, to_index,
+              trajopt::PointPointMaxConstraint{{0.0, 0.0}, center, radius});
+      }
+    } else if (type == "KeepInRectangle") {
+      double x = props.at("x").get<double>();
+      double y = props.at("y").get<double>();
+      double w = props.at("w").get<double>();
+      double h = props.at("h").get<double>();
+      std::vector<trajopt::Translation2d> corners{
+          {x, y}, {x + w, y}, {x + w, y + h}, {x, y + h}};
+      for (size_t i = 0; i < corners.size(); ++i) {
+        const auto& start = corners[i];
+        const auto& end = corners[(i + 1) % corners.size()];
+        apply(from_index, to_index,
+              trajopt::PointLineRegionConstraint{{0.0, 0.0}, start, end,
+                                                 trajopt::Side::ABOVE});
+        for (const auto& bumper : bumpers) {
+          for (const auto& corner : bumper.points) {
+            apply(from_index, to_index,
+                  trajopt::PointLineRegionConstraint{corner, start, end,
+                                                     trajopt::Side::ABOVE});
+          }
+        }
+      }
+    } else if (type == "KeepInLane") {
+      if (to_index.value() >= wpt_translations.size()) {
+        continue;
+      }
+      apply(from_index, to_index,
+            trajopt::LaneConstraint{wpt_translations.at(from_index),
+                                    wpt_translations.at(to_index.value()),
+                                    props.at("tolerance").get<double>()});
+    } else if (type == "KeepOutCircle") {
+      trajopt::Translation2d center{props.at("x").get<double>(),
+                                    props.at("y").get<double>()};
+      double radius = props.at("r").get<double>();
+      for (const auto& bumper : bumpers) {
+        for (size_t i = 0; i < bumper.points.size(); ++i) {
+          const auto& corner = bumper.points.at(i);
+          const auto& next_corner =
+              bumper.points.at((i + 1) % bumper.points.size());
+          apply(from_index, to_index,
+                trajopt::PointPointMinConstraint{corner, center, radius});
+          apply(from_index, to_index,
+                trajopt::LinePointConstraint{corner, next_corner, center,
+                                             radius});
+        }
+      }
+    }
+  }
+}
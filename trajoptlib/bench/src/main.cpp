@@ -0,0 +1,232 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <print>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <sleipnir/optimization/solver/exit_status.hpp>
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/generation_stats.hpp>
+
+#include "robot_config.hpp"
+#include "snapshot.hpp"
+
+// Replays the snapshots of Choreo trajectory files through TrajoptLib and
+// reports how long each took to build and solve as JSON.
+//
+// Each trajectory's robot configuration comes from, in order of preference,
+// the project passed with --project, the only project file in the
+// trajectory's directory, the configuration the trajectory was last generated
+// with, or a new Choreo project's defaults.
+
+namespace {
+
+constexpr std::string_view usage =
+    "Usage: trajoptlib_bench [--repeat N] [--project FILE] [--output FILE] "
+    "[PATH...]\n"
+    "\n"
+    "Replays the snapshot of each .traj file, or of each .traj file under\n"
+    "each directory, and prints the results as JSON. With no paths, replays\n"
+    "the trajectories in Choreo's test-jsons directory.\n"
+    "\n"
+    "  --repeat N      Solve each trajectory N times (default: 5)\n"
+    "  --project FILE  Use the robot configuration of this .chor project\n"
+    "  --output FILE   Write the results to FILE instead of stdout";
+
+nlohmann::json read_json(const std::filesystem::path& path) {
+  std::ifstream file{path};
+  return nlohmann::json::parse(file);
+}
+
+/// Returns the .traj files at the given paths, searching directories
+/// recursively.
+std::vector<std::filesystem::path> find_trajectories(
+    std::span<const std::filesystem::path> paths) {
+  std::vector<std::filesystem::path> trajectories;
+  for (const auto& path : paths) {
+    if (std::filesystem::is_directory(path)) {
+      for (const auto& entry :
+           std::filesystem::recursive_directory_iterator{path}) {
+        if (entry.is_regular_file() && entry.path().extension() == ".traj") {
+          trajectories.push_back(entry.path());
+        }
+      }
+    } else {
+      trajectories.push_back(path);
+    }
+  }
+  std::ranges::sort(trajectories);
+  return trajectories;
+}
+
+/// Returns the only .chor project in a directory, if there's exactly one.
+std::optional<std::filesystem::path> find_project(
+    const std::filesystem::path& directory) {
+  std::optional<std::filesystem::path> project;
+  for (const auto& entry : std::filesystem::directory_iterator{directory}) {
+    if (entry.is_regular_file() && entry.path().extension() == ".chor") {
+      if (project.has_value()) {
+        return std::nullopt;
+      }
+      project = entry.path();
+    }
+  }
+  return project;
+}
+
+/// Rebuilds and solves a trajectory repeatedly.
+template <typename Builder, typename Generator>
+nlohmann::json run_trajectory(const nlohmann::json& snapshot,
+                              const RobotConfig& config, size_t repeat) {
+  nlohmann::json runs = nlohmann::json::array();
+  std::vector<double> solve_times;
+
+  for (size_t run = 0; run < repeat; ++run) {
+    auto build_start = std::chrono::steady_clock::now();
+
+    Builder builder;
+    if constexpr (std::same_as<Builder, trajopt::SwervePathBuilder>) {
+      builder.set_drivetrain(config.swerve_drivetrain());
+    } else {
+      builder.set_drivetrain(config.differential_drivetrain());
+    }
+    builder.set_bumpers(config.bumper_front, config.bumper_side,
+                        config.bumper_side, config.bumper_back);
+    apply_snapshot(builder, snapshot);
+    Generator generator{std::move(builder)};
+
+    std::chrono::duration<double> build_time =
+        std::chrono::steady_clock::now() - build_start;
+
+    trajopt::GenerationStats stats;
+    auto solution = generator.generate(false, &stats);
+    auto status =
+        solution.has_value() ? slp::ExitStatus::SUCCESS : solution.error();
+
+    solve_times.push_back(stats.solve_time);
+    runs.push_back({{"build_time", build_time.count()},
+                    {"initial_guess_time", stats.initial_guess_time},
+                    {"solve_time", stats.solve_time},
+                    {"callback_time", stats.callback_time},
+                    {"iterations", stats.iterations},
+                    {"exit_status", static_cast<int>(status)},
+                    {"peak_memory", stats.peak_memory}});
+  }
+
+  std::ranges::sort(solve_times);
+  return {{"median_solve_time",
+           solve_times.empty() ? 0.0 : solve_times[solve_times.size() / 2]},
+          {"runs", std::move(runs)}};
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  size_t repeat = 5;
+  std::optional<std::filesystem::path> project_path;
+  std::optional<std::filesystem::path> output_path;
+  std::vector<std::filesystem::path> paths;
+
+  std::vector<std::string_view> args(argv + 1, argv + argc);
+  for (size_t i = 0; i < args.size(); ++i) {
+    bool has_value = i + 1 < args.size();
+    if (args[i] == "--repeat" && has_value) {
+      repeat = std::stoul(std::string{args[++i]});
+    } else if (args[i] == "--project" && has_value) {
+      project_path = std::filesystem::path{args[++i]};
+    } else if (args[i] == "--output" && has_value) {
+      output_path = std::filesystem::path{args[++i]};
+    } else if (args[i].starts_with("--")) {
+      std::println(stderr, "{}", usage);
+      return 1;
+    } else {
+      paths.emplace_back(args[i]);
+    }
+  }
+  if (paths.empty()) {
+    paths.emplace_back(TRAJOPT_BENCH_CORPUS);
+  }
+
+  std::optional<nlohmann::json> project;
+  if (project_path.has_value()) {
+    project = read_json(project_path.value());
+  }
+
+  nlohmann::json results = nlohmann::json::array();
+  for (const auto& path : find_trajectories(paths)) {
+    nlohmann::json result{{"file", path.generic_string()}};
+
+    try {
+      auto trajectory = read_json(path);
+
+      auto file_project = project;
+      if (!file_project.has_value()) {
+        if (auto sibling = find_project(path.parent_path())) {
+          file_project = read_json(sibling.value());
+        }
+      }
+
+      RobotConfig config;
+      std::string type = "Swerve";
+      if (file_project.has_value()) {
+        config = parse_robot_config(file_project->at("config"));
+        type = file_project->value("type", type);
+      } else if (trajectory.contains("trajectory") &&
+                 trajectory.at("trajectory").is_object()) {
+        const auto& output = trajectory.at("trajectory");
+        if (output.contains("config") && output.at("config").is_object()) {
+          config = parse_robot_config(output.at("config"));
+        }
+        if (output.contains("sampleType") &&
+            output.at("sampleType").is_string()) {
+          type = output.at("sampleType").get<std::string>();
+        } else if (output.contains("samples") &&
+                   !output.at("samples").empty() &&
+                   output.at("samples").at(0).contains("vl")) {
+          // Older files only tell drivetrains apart by their samples
+          type = "Differential";
+        }
+      }
+
+      const auto& snapshot = trajectory.at("snapshot");
+      result["drivetrain"] = type;
+      if (type == "Differential") {
+        result.update(run_trajectory<trajopt::DifferentialPathBuilder,
+                                     trajopt::DifferentialTrajectoryGenerator>(
+            snapshot, config, repeat));
+      } else {
+        result.update(run_trajectory<trajopt::SwervePathBuilder,
+                                     trajopt::SwerveTrajectoryGenerator>(
+            snapshot, config, repeat));
+      }
+    } catch (const std::exception& e) {
+      result["error"] = e.what();
+    }
+
+    results.push_back(std::move(result));
+  }
+
+  auto output = nlohmann::json{{"repeat", repeat}, {"results", results}};
+  if (output_path.has_value()) {
+    std::ofstream file{output_path.value()};
+    file << output.dump(2) << '\n';
+  } else {
+    std::println("{}", output.dump(2));
+  }
+
+  return 0;
+}
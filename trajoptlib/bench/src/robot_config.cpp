@@ -0,0 +1,85 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "robot_config.hpp"
+
+#include <nlohmann/json.hpp>
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+
+namespace {
+
+/// Reads a value that's either a number or an expression object, keeping the
+/// default if it's missing.
+void read_value(const nlohmann::json& object, const char* key, double& value) {
+  if (!object.contains(key)) {
+    return;
+  }
+
+  const auto& field = object.at(key);
+  value = field.is_object() ? field.at("val").get<double>()
+                            : field.get<double>();
+}
+
+void read_translation(const nlohmann::json& object, const char* key,
+                      trajopt::Translation2d& translation) {
+  if (!object.contains(key)) {
+    return;
+  }
+
+  double x = translation.x();
+  double y = translation.y();
+  read_value(object.at(key), "x", x);
+  read_value(object.at(key), "y", y);
+  translation = trajopt::Translation2d{x, y};
+}
+
+}  // namespace
+
+trajopt::SwerveDrivetrain RobotConfig::swerve_drivetrain() const {
+  // Modules are ordered FL, BL, BR, FR, the same as Choreo's generator
+  return trajopt::SwerveDrivetrain{
+      .mass = mass,
+      .moi = inertia,
+      .wheel_radius = radius,
+      .wheel_max_angular_velocity = vmax / gearing,
+      .wheel_max_torque = tmax * gearing,
+      .wheel_cof = cof,
+      .modules = {front_left,
+                  back_left,
+                  {back_left.x(), -back_left.y()},
+                  {front_left.x(), -front_left.y()}}};
+}
+
+trajopt::DifferentialDrivetrain RobotConfig::differential_drivetrain() const {
+  return trajopt::DifferentialDrivetrain{
+      .mass = mass,
+      .moi = inertia,
+      .wheel_radius = radius,
+      .wheel_max_angular_velocity = vmax / gearing,
+      .wheel_max_torque = tmax * gearing,
+      .wheel_cof = cof,
+      .trackwidth = differential_trackwidth};
+}
+
+RobotConfig parse_robot_config(const nlohmann::json& config) {
+  RobotConfig robot;
+
+  read_translation(config, "frontLeft", robot.front_left);
+  read_translation(config, "backLeft", robot.back_left);
+  read_value(config, "mass", robot.mass);
+  read_value(config, "inertia", robot.inertia);
+  read_value(config, "gearing", robot.gearing);
+  read_value(config, "radius", robot.radius);
+  read_value(config, "vmax", robot.vmax);
+  read_value(config, "tmax", robot.tmax);
+  read_value(config, "cof", robot.cof);
+  if (config.contains("bumper")) {
+    const auto& bumper = config.at("bumper");
+    read_value(bumper, "front", robot.bumper_front);
+    read_value(bumper, "side", robot.bumper_side);
+    read_value(bumper, "back", robot.bumper_back);
+  }
+  read_value(config, "differentialTrackWidth", robot.differential_trackwidth);
+
+  return robot;
+}
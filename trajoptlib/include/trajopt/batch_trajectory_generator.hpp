@@ -0,0 +1,166 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stdint.h>
+
+#include <exception>
+#include <expected>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <sleipnir/optimization/solver/exit_status.hpp>
+
+#include "trajopt/differential_trajectory_generator.hpp"
+#include "trajopt/swerve_trajectory_generator.hpp"
+#include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/generation_stats.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+#include "trajopt/util/work_stealing_pool.hpp"
+
+namespace trajopt {
+
+/// The state of a job in a batch generation.
+enum class BatchJobState : uint8_t {
+  /// The job's problem is being built and solved.
+  RUNNING,
+  /// The job finished, either with a solution or an error.
+  FINISHED,
+};
+
+/// The outcome of one job in a batch generation.
+///
+/// @tparam Solution The solution type (e.g., swerve, differential).
+template <typename Solution>
+struct TRAJOPT_DLLEXPORT BatchResult {
+  /// The handle the job was added with.
+  int64_t handle;
+
+  /// The job's solution, or the solver's exit status on failure.
+  std::expected<Solution, slp::ExitStatus> solution;
+
+  /// The exception the job threw while building or solving its problem, if
+  /// any. Its solution then holds CALLBACK_REQUESTED_STOP.
+  std::exception_ptr exception;
+
+  /// The job's timing and size statistics. Empty if the job was cancelled
+  /// before its problem was built.
+  GenerationStats stats;
+};
+
+/// Generates many trajectories concurrently on a work-stealing thread pool.
+///
+/// Each job builds and solves its own problem on a worker thread. Path
+/// callbacks keep receiving the job's handle, so progress can be attributed to
+/// individual jobs; they may be called from several threads at once.
+///
+/// @tparam Builder The path builder type.
+/// @tparam Generator The trajectory generator type.
+/// @tparam Solution The solution type.
+template <typename Builder, typename Generator, typename Solution>
+class TRAJOPT_DLLEXPORT BatchTrajectoryGenerator {
+ public:
+  /// Adds a job to the batch.
+  ///
+  /// @param path_builder The path to generate.
+  /// @param handle An identifier for the job, passed to its state callbacks.
+  /// @return A token that cancels only this job, whether it's queued or
+  ///     running. Cancellation only lasts for the generate() call it's
+  ///     requested during; each call starts with every job's token cleared.
+  CancellationToken add_job(Builder path_builder, int64_t handle = 0) {
+    CancellationToken token;
+    m_jobs.emplace_back(std::move(path_builder), handle, token);
+    return token;
+  }
+
+  /// Sets a callback that's called when a job changes state.
+  ///
+  /// @param callback A callback whose first parameter is the job's handle and
+  ///     second parameter is the job's new state.
+  void set_job_state_callback(
+      std::function<void(int64_t handle, BatchJobState state)> callback) {
+    m_job_state_callback = std::move(callback);
+  }
+
+  /// Generates every job in the batch.
+  ///
+  /// This function blocks until every job has finished. Jobs must not be added
+  /// while it's running. Cancellations requested before it's called are
+  /// cleared, so a job cancelled in one call runs again in the next.
+  ///
+  /// @param concurrency The maximum number of jobs solved at once. If zero, one
+  ///     job per hardware thread is solved at once.
+  /// @param diagnostics Enables diagnostic prints.
+  /// @return The result of each job, in the order the jobs were added.
+  std::vector<BatchResult<Solution>> generate(size_t concurrency = 0,
+                                              bool diagnostics = false) const {
+    std::vector<BatchResult<Solution>> results;
+    results.reserve(m_jobs.size());
+    for (const auto& job : m_jobs) {
+      job.token.reset();
+      results.push_back(BatchResult<Solution>{
+          .handle = job.handle,
+          .solution =
+              std::unexpected{slp::ExitStatus::CALLBACK_REQUESTED_STOP}});
+    }
+
+    WorkStealingPool pool{concurrency};
+    for (size_t i = 0; i < m_jobs.size(); ++i) {
+      pool.submit([this, &results, i, diagnostics] {
+        const auto& job = m_jobs[i];
+
+        // Skip building the problem if the job was cancelled while queued
+        if (job.token.is_cancelled()) {
+          notify(job.handle, BatchJobState::FINISHED);
+          return;
+        }
+
+        notify(job.handle, BatchJobState::RUNNING);
+        try {
+          Generator generator{job.path_builder, job.handle};
+          generator.set_cancellation_token(job.token);
+          results[i].solution =
+              generator.generate(diagnostics, &results[i].stats);
+        } catch (...) {
+          // Tasks must not throw, so the exception is kept for the caller
+          results[i].exception = std::current_exception();
+        }
+        notify(job.handle, BatchJobState::FINISHED);
+      });
+    }
+    pool.wait();
+
+    return results;
+  }
+
+ private:
+  struct Job {
+    Builder path_builder;
+    int64_t handle;
+    CancellationToken token;
+  };
+
+  std::vector<Job> m_jobs;
+  std::function<void(int64_t handle, BatchJobState state)>
+      m_job_state_callback;
+
+  void notify(int64_t handle, BatchJobState state) const {
+    if (m_job_state_callback) {
+      m_job_state_callback(handle, state);
+    }
+  }
+};
+
+/// Generates many swerve trajectories concurrently.
+using SwerveBatchTrajectoryGenerator =
+    BatchTrajectoryGenerator<SwervePathBuilder, SwerveTrajectoryGenerator,
+                             SwerveSolution>;
+
+/// Generates many differential trajectories concurrently.
+using DifferentialBatchTrajectoryGenerator =
+    BatchTrajectoryGenerator<DifferentialPathBuilder,
+                             DifferentialTrajectoryGenerator,
+                             DifferentialSolution>;
+
+}  // namespace trajopt
@@ -2,13 +2,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <span>
+#include <vector>
 
 #include <sleipnir/autodiff/variable.hpp>
 #include <sleipnir/optimization/problem.hpp>
 
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/content_hash.hpp"
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
@@ -48,6 +53,77 @@ class TRAJOPT_DLLEXPORT AngularVelocityMaxMagnitudeConstraint {
     }
   }
 
+  /// Returns the maximum angular velocity magnitude.
+  ///
+  /// @return The maximum angular velocity magnitude.
+  double max_magnitude() const { return m_max_magnitude; }
+
+  /// Returns the values of this constraint that can change without rebuilding
+  /// the problem.
+  ///
+  /// @return The maximum magnitude, or nothing if it's zero since a zero
+  ///     magnitude changes the constraint's structure.
+  std::vector<double> parameter_values() const {
+    if (m_max_magnitude == 0.0) {
+      return {};
+    } else {
+      return {m_max_magnitude};
+    }
+  }
+
+  /// Applies this constraint to the given problem with its parameter values
+  /// replaced by the given parameters.
+  ///
+  /// @param problem The optimization problem.
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  /// @param parameters The parameters, in the order parameter_values() returns
+  ///     their values.
+  void apply_parametric(
+      slp::Problem<double>& problem, const Pose2v<double>& pose,
+      const Translation2v<double>& linear_velocity,
+      const slp::Variable<double>& angular_velocity,
+      const Translation2v<double>& linear_acceleration,
+      const slp::Variable<double>& angular_acceleration,
+      std::span<const slp::Variable<double>> parameters) {
+    if (m_max_magnitude == 0.0) {
+      apply(problem, pose, linear_velocity, angular_velocity,
+            linear_acceleration, angular_acceleration);
+    } else {
+      problem.subject_to(-parameters[0] <= angular_velocity);
+      problem.subject_to(angular_velocity <= parameters[0]);
+    }
+  }
+
+  /// Returns how far the given state is from satisfying this constraint.
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  /// @return The violation (rad/s), which is zero if the constraint is
+  ///     satisfied.
+  double violation(
+      [[maybe_unused]] const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    return std::max(std::abs(angular_velocity) - m_max_magnitude, 0.0);
+  }
+
+  /// Adds this constraint's values to a content hash.
+  ///
+  /// @param hasher The content hasher.
+  void hash(ContentHasher& hasher) const { hasher.add(m_max_magnitude); }
+
+  /// Returns true if both constraints are equal.
+  bool operator==(const AngularVelocityMaxMagnitudeConstraint&) const = default;
+
  private:
   double m_max_magnitude;
 };
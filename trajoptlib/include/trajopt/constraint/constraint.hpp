@@ -2,8 +2,14 @@
 
 #pragma once
 
+#include <stddef.h>
+
+#include <algorithm>
 #include <concepts>
+#include <optional>
+#include <span>
 #include <variant>
+#include <vector>
 
 #include <sleipnir/autodiff/variable.hpp>
 #include <sleipnir/optimization/problem.hpp>
@@ -19,6 +25,7 @@
 #include "trajopt/constraint/point_line_region_constraint.hpp"
 #include "trajopt/constraint/point_point_max_constraint.hpp"
 #include "trajopt/constraint/point_point_min_constraint.hpp"
+#include "trajopt/constraint/polygon_keep_out_constraint.hpp"
 #include "trajopt/constraint/pose_equality_constraint.hpp"
 #include "trajopt/constraint/translation_equality_constraint.hpp"
 #include "trajopt/geometry/pose2.hpp"
@@ -27,6 +34,10 @@
 namespace trajopt {
 
 /// ConstraintLike concept.
+///
+/// Applying a constraint may add decision variables of its own to the problem.
+/// Constraints that do declare how many each application adds with a static
+/// decision_variable_count.
 template <typename T>
 concept ConstraintLike =
     requires(T self, slp::Problem<double>& problem, const Pose2v<double>& pose,
@@ -40,6 +51,38 @@ concept ConstraintLike =
       } -> std::same_as<void>;
     };
 
+/// ParametricConstraintLike concept.
+///
+/// Parametric constraints can be applied with some of their values replaced by
+/// parameters, so those values can change without rebuilding the problem.
+template <typename T>
+concept ParametricConstraintLike =
+    ConstraintLike<T> &&
+    requires(T self, slp::Problem<double>& problem, const Pose2v<double>& pose,
+             const Translation2v<double>& linear_velocity,
+             const slp::Variable<double>& angular_velocity,
+             const Translation2v<double>& linear_acceleration,
+             const slp::Variable<double>& angular_acceleration,
+             std::span<const slp::Variable<double>> parameters) {
+      { self.parameter_values() } -> std::same_as<std::vector<double>>;
+      {
+        self.apply_parametric(problem, pose, linear_velocity, angular_velocity,
+                              linear_acceleration, angular_acceleration,
+                              parameters)
+      } -> std::same_as<void>;
+    };
+
+/// GeometricConstraintLike concept.
+///
+/// Geometric constraints only depend on the robot's pose and can report how far
+/// a pose is from violating them, so they can be left out of a problem until a
+/// solution comes near them.
+template <typename T>
+concept GeometricConstraintLike =
+    ConstraintLike<T> && requires(const T self, const Pose2d& pose) {
+      { self.margin(pose) } -> std::same_as<double>;
+    };
+
 /// List of constraint types (must satisfy ConstraintLike concept).
 using Constraint = std::variant<
     // clang-format off
@@ -54,6 +97,7 @@ using Constraint = std::variant<
     PointLineRegionConstraint,
     PointPointMaxConstraint,
     PointPointMinConstraint,
+    PolygonKeepOutConstraint,
     PoseEqualityConstraint,
     TranslationEqualityConstraint
     // clang-format on
@@ -71,4 +115,85 @@ struct HoldsConstraintTypes<std::variant<Ts...>> {
 
 static_assert(HoldsConstraintTypes<Constraint>::value);
 
+/// Returns the number of decision variables one application of a constraint
+/// adds to the problem.
+///
+/// @param constraint The constraint.
+/// @return The number of decision variables.
+inline size_t constraint_decision_variable_count(const Constraint& constraint) {
+  return std::visit(
+      []<typename T>(const T&) -> size_t {
+        if constexpr (requires { T::decision_variable_count; }) {
+          return T::decision_variable_count;
+        } else {
+          return 0;
+        }
+      },
+      constraint);
+}
+
+/// Returns how far a pose is from violating a constraint.
+///
+/// @param constraint The constraint.
+/// @param pose The robot's pose.
+/// @return The margin (m), which is negative if the constraint is violated, or
+///     nothing if the constraint isn't geometric.
+inline std::optional<double> constraint_margin(const Constraint& constraint,
+                                               const Pose2d& pose) {
+  return std::visit(
+      [&]<typename T>(const T& arg) -> std::optional<double> {
+        if constexpr (GeometricConstraintLike<T>) {
+          return arg.margin(pose);
+        } else {
+          return std::nullopt;
+        }
+      },
+      constraint);
+}
+
+/// Returns how far a sample's state is from satisfying a constraint.
+///
+/// Geometric constraints report how far the pose is past their boundary, and
+/// the others the residual of the constraint they apply.
+///
+/// @param constraint The constraint.
+/// @param pose The robot's pose.
+/// @param linear_velocity The robot's linear velocity.
+/// @param angular_velocity The robot's angular velocity.
+/// @param linear_acceleration The robot's linear acceleration.
+/// @param angular_acceleration The robot's angular acceleration.
+/// @return The violation in the constraint's units, which is zero if the
+///     constraint is satisfied.
+inline double constraint_violation(const Constraint& constraint,
+                                   const Pose2d& pose,
+                                   const Translation2d& linear_velocity,
+                                   double angular_velocity,
+                                   const Translation2d& linear_acceleration,
+                                   double angular_acceleration) {
+  return std::visit(
+      [&]<typename T>(const T& arg) -> double {
+        if constexpr (GeometricConstraintLike<T>) {
+          return std::max(-arg.margin(pose), 0.0);
+        } else {
+          return arg.violation(pose, linear_velocity, angular_velocity,
+                               linear_acceleration, angular_acceleration);
+        }
+      },
+      constraint);
+}
+
+/// A geometric constraint left out of a problem until a solution comes near
+/// it.
+struct LazyConstraint {
+  /// The constraint.
+  Constraint constraint;
+
+  /// The sample the constraint applies to.
+  size_t index;
+
+  /// How close a solution must come to violating the constraint before it's
+  /// applied (m).
+  double activation_margin;
+};
+
 }  // namespace trajopt
@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
 #include <sleipnir/autodiff/variable.hpp>
 
 #include "trajopt/geometry/translation2.hpp"
@@ -29,4 +32,17 @@ decltype(auto) line_point_squared_distance(const Translation2<T>& line_start,
   return (i - point).squared_norm();
 }
 
+// Returns the distance between a line segment and a point
+inline double line_point_distance(const Translation2d& line_start,
+                                  const Translation2d& line_end,
+                                  const Translation2d& point) {
+  auto l = line_end - line_start;
+  auto v = point - line_start;
+
+  double t = l.squared_norm() > 0.0
+                 ? std::clamp(v.dot(l) / l.squared_norm(), 0.0, 1.0)
+                 : 0.0;
+  return (line_start + l * t).distance(point);
+}
+
 }  // namespace trajopt::detail
@@ -2,12 +2,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <optional>
 
 #include "trajopt/constraint/point_line_region_constraint.hpp"
 #include "trajopt/geometry/rotation2.hpp"
 #include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/content_hash.hpp"
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
@@ -81,6 +83,39 @@ class TRAJOPT_DLLEXPORT LaneConstraint {
     }
   }
 
+  /// Returns how far the given state is from satisfying this constraint.
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  /// @return The violation (m), which is zero if the constraint is
+  ///     satisfied.
+  double violation(
+      const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    double distance = std::max(-m_top_line.margin(pose), 0.0);
+    if (m_bottom_line.has_value()) {
+      distance = std::max(distance, -m_bottom_line.value().margin(pose));
+    }
+    return distance;
+  }
+
+  /// Adds this constraint's values to a content hash.
+  ///
+  /// @param hasher The content hasher.
+  void hash(ContentHasher& hasher) const {
+    hasher.add(m_top_line);
+    hasher.add(m_bottom_line);
+  }
+
+  /// Returns true if both constraints are equal.
+  bool operator==(const LaneConstraint&) const = default;
+
  private:
   PointLineRegionConstraint m_top_line;
   std::optional<PointLineRegionConstraint> m_bottom_line;
@@ -11,6 +11,7 @@
 #include "trajopt/constraint/detail/line_point_squared_distance.hpp"
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/content_hash.hpp"
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
@@ -61,6 +62,32 @@ class TRAJOPT_DLLEXPORT LinePointConstraint {
     problem.subject_to(squared_distance >= m_min_distance * m_min_distance);
   }
 
+  /// Returns how far the given pose is from violating this constraint.
+  ///
+  /// @param pose The robot's pose.
+  /// @return The margin (m), which is negative if the constraint is violated.
+  double margin(const Pose2d& pose) const {
+    auto line_start =
+        pose.translation() + m_robot_line_start.rotate_by(pose.rotation());
+    auto line_end =
+        pose.translation() + m_robot_line_end.rotate_by(pose.rotation());
+    return detail::line_point_distance(line_start, line_end, m_field_point) -
+           m_min_distance;
+  }
+
+  /// Adds this constraint's values to a content hash.
+  ///
+  /// @param hasher The content hasher.
+  void hash(ContentHasher& hasher) const {
+    hasher.add(m_robot_line_start);
+    hasher.add(m_robot_line_end);
+    hasher.add(m_field_point);
+    hasher.add(m_min_distance);
+  }
+
+  /// Returns true if both constraints are equal.
+  bool operator==(const LinePointConstraint&) const = default;
+
  private:
   Translation2d m_robot_line_start;
   Translation2d m_robot_line_end;
@@ -2,11 +2,14 @@
 
 #pragma once
 
+#include <cmath>
+
 #include <sleipnir/autodiff/variable.hpp>
 #include <sleipnir/optimization/problem.hpp>
 
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/content_hash.hpp"
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
@@ -43,6 +46,34 @@ class TRAJOPT_DLLEXPORT LinearVelocityDirectionConstraint {
     problem.subject_to(dot * dot == linear_velocity.squared_norm());
   }
 
+  /// Returns how far the given state is from satisfying this constraint.
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  /// @return The violation (m/s), which is zero if the constraint is
+  ///     satisfied.
+  double violation(
+      [[maybe_unused]] const Pose2d& pose,
+      const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    // The velocity's component perpendicular to the direction
+    return std::abs(
+        Translation2d{m_angle.cos(), m_angle.sin()}.cross(linear_velocity));
+  }
+
+  /// Adds this constraint's values to a content hash.
+  ///
+  /// @param hasher The content hasher.
+  void hash(ContentHasher& hasher) const { hasher.add(m_angle); }
+
+  /// Returns true if both constraints are equal.
+  bool operator==(const LinearVelocityDirectionConstraint&) const = default;
+
  private:
   trajopt::Rotation2d m_angle;
 };
@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <utility>
 
 #include <sleipnir/autodiff/variable.hpp>
@@ -10,6 +12,7 @@
 
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/content_hash.hpp"
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
@@ -69,6 +72,44 @@ class TRAJOPT_DLLEXPORT PointAtConstraint {
     }
   }
 
+  /// Returns how far the given state is from satisfying this constraint.
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  /// @return The violation (m), which is zero if the constraint is
+  ///     satisfied.
+  double violation(
+      const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    double dx = m_field_point.x() - pose.x();
+    double dy = m_field_point.y() - pose.y();
+    double dot = pose.rotation().cos() * dx + pose.rotation().sin() * dy;
+    double min_dot = std::cos(m_heading_tolerance) * std::hypot(dx, dy);
+    if (!m_flip) {
+      return std::max(min_dot - dot, 0.0);
+    } else {
+      return std::max(dot + min_dot, 0.0);
+    }
+  }
+
+  /// Adds this constraint's values to a content hash.
+  ///
+  /// @param hasher The content hasher.
+  void hash(ContentHasher& hasher) const {
+    hasher.add(m_field_point);
+    hasher.add(m_heading_tolerance);
+    hasher.add(m_flip);
+  }
+
+  /// Returns true if both constraints are equal.
+  bool operator==(const PointAtConstraint&) const = default;
+
  private:
   Translation2d m_field_point;
   double m_heading_tolerance;
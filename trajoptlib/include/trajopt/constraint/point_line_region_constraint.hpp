@@ -4,6 +4,7 @@
 
 #include <stdint.h>
 
+#include <cmath>
 #include <utility>
 
 #include <sleipnir/autodiff/variable.hpp>
@@ -11,6 +12,7 @@
 
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/content_hash.hpp"
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
@@ -102,6 +104,42 @@ class TRAJOPT_DLLEXPORT PointLineRegionConstraint {
     }
   }
 
+  /// Returns how far the given pose is from violating this constraint.
+  ///
+  /// @param pose The robot's pose.
+  /// @return The margin (m), which is negative if the constraint is violated.
+  double margin(const Pose2d& pose) const {
+    auto point = pose.translation() + m_robot_point.rotate_by(pose.rotation());
+    auto line = m_field_line_end - m_field_line_start;
+    auto start_to_point = point - m_field_line_start;
+
+    // Signed distance from the line, positive above it
+    double distance = line.cross(start_to_point) / line.norm();
+
+    switch (m_side) {
+      case Side::ABOVE:
+        return distance;
+      case Side::BELOW:
+        return -distance;
+      case Side::ON:
+        return -std::abs(distance);
+    }
+    return -std::abs(distance);
+  }
+
+  /// Adds this constraint's values to a content hash.
+  ///
+  /// @param hasher The content hasher.
+  void hash(ContentHasher& hasher) const {
+    hasher.add(m_robot_point);
+    hasher.add(m_field_line_start);
+    hasher.add(m_field_line_end);
+    hasher.add(m_side);
+  }
+
+  /// Returns true if both constraints are equal.
+  bool operator==(const PointLineRegionConstraint&) const = default;
+
  private:
   Translation2d m_robot_point;
   Translation2d m_field_line_start;
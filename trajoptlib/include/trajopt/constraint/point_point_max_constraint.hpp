@@ -10,6 +10,7 @@
 
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/content_hash.hpp"
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
@@ -56,6 +57,28 @@ class TRAJOPT_DLLEXPORT PointPointMaxConstraint {
     problem.subject_to(dx * dx + dy * dy <= m_max_distance * m_max_distance);
   }
 
+  /// Returns how far the given pose is from violating this constraint.
+  ///
+  /// @param pose The robot's pose.
+  /// @return The margin (m), which is negative if the constraint is violated.
+  double margin(const Pose2d& pose) const {
+    auto bumper_corner =
+        pose.translation() + m_robot_point.rotate_by(pose.rotation());
+    return m_max_distance - bumper_corner.distance(m_field_point);
+  }
+
+  /// Adds this constraint's values to a content hash.
+  ///
+  /// @param hasher The content hasher.
+  void hash(ContentHasher& hasher) const {
+    hasher.add(m_robot_point);
+    hasher.add(m_field_point);
+    hasher.add(m_max_distance);
+  }
+
+  /// Returns true if both constraints are equal.
+  bool operator==(const PointPointMaxConstraint&) const = default;
+
  private:
   Translation2d m_robot_point;
   Translation2d m_field_point;
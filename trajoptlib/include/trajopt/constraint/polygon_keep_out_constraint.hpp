@@ -0,0 +1,217 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <sleipnir/autodiff/variable.hpp>
+#include <sleipnir/optimization/problem.hpp>
+
+#include "trajopt/constraint/detail/line_point_squared_distance.hpp"
+#include "trajopt/geometry/pose2.hpp"
+#include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/content_hash.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// Polygon keep-out constraint.
+///
+/// Specifies that a convex polygon on the robot's frame (e.g., its bumpers)
+/// must stay a minimum distance away from a convex polygon on the field.
+///
+/// Each sample gets its own separating axis, a direction along which every
+/// robot vertex lies at least the minimum distance beyond every field vertex.
+/// The axis is a decision variable, so one obstacle costs one constraint per
+/// vertex of either polygon instead of one per pair of robot and field
+/// features. A non-convex polygon is kept apart by its convex hull.
+///
+/// The axis is seeded from the pose's value when the constraint is applied.
+/// Warm starts and parameter updates don't reseed it.
+class TRAJOPT_DLLEXPORT PolygonKeepOutConstraint {
+ public:
+  /// The number of decision variables each application adds: the separating
+  /// axis's two components and its offset.
+  static constexpr size_t decision_variable_count = 3;
+
+  /// Constructs a PolygonKeepOutConstraint.
+  ///
+  /// @param robot_polygon Robot polygon vertices, wound either clockwise or
+  ///     counterclockwise. A single point keeps out the robot's point instead.
+  /// @param field_polygon Field polygon vertices, wound either clockwise or
+  ///     counterclockwise. A single point keeps out a circle instead.
+  /// @param min_distance Minimum distance between the polygons. Must be
+  ///     nonnegative.
+  explicit PolygonKeepOutConstraint(std::vector<Translation2d> robot_polygon,
+                                    std::vector<Translation2d> field_polygon,
+                                    double min_distance)
+      : m_robot_polygon{std::move(robot_polygon)},
+        m_field_polygon{std::move(field_polygon)},
+        m_min_distance{min_distance} {
+    assert(!m_robot_polygon.empty());
+    assert(!m_field_polygon.empty());
+    assert(min_distance >= 0.0);
+  }
+
+  /// Applies this constraint to the given problem.
+  ///
+  /// @param problem The optimization problem.
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  void apply(
+      slp::Problem<double>& problem, const Pose2v<double>& pose,
+      [[maybe_unused]] const Translation2v<double>& linear_velocity,
+      [[maybe_unused]] const slp::Variable<double>& angular_velocity,
+      [[maybe_unused]] const Translation2v<double>& linear_acceleration,
+      [[maybe_unused]] const slp::Variable<double>& angular_acceleration) {
+    // The separating line is {p : n·p = offset}. The axis is held to unit
+    // length, so a zero axis can't satisfy every vertex row trivially and the
+    // gap along it is the actual distance between the polygons' projections.
+    auto n_x = problem.decision_variable();
+    auto n_y = problem.decision_variable();
+    auto offset = problem.decision_variable();
+
+    // Start with the axis pointing from the field polygon toward the robot
+    Translation2d center{pose.x().value(), pose.y().value()};
+    Translation2d axis = center - centroid(m_field_polygon);
+    axis = axis.norm() > 0.0 ? axis / axis.norm() : Translation2d{1.0, 0.0};
+    double max_projection = -std::numeric_limits<double>::infinity();
+    for (const auto& point : m_field_polygon) {
+      max_projection = std::max(max_projection, axis.dot(point));
+    }
+    n_x.set_value(axis.x());
+    n_y.set_value(axis.y());
+    offset.set_value(max_projection);
+
+    Translation2v<double> n{n_x, n_y};
+    problem.subject_to(n.squared_norm() == 1.0);
+    for (const auto& robot_point : m_robot_polygon) {
+      auto point = pose.translation() + robot_point.rotate_by(pose.rotation());
+      problem.subject_to(n.dot(point) - offset >= m_min_distance);
+    }
+    for (const auto& field_point : m_field_polygon) {
+      problem.subject_to(n.dot(field_point) - offset <= 0.0);
+    }
+  }
+
+  /// Returns how far the given pose is from violating this constraint.
+  ///
+  /// @param pose The robot's pose.
+  /// @return The margin (m), which is negative if the constraint is violated.
+  double margin(const Pose2d& pose) const {
+    std::vector<Translation2d> robot_polygon;
+    robot_polygon.reserve(m_robot_polygon.size());
+    for (const auto& robot_point : m_robot_polygon) {
+      robot_polygon.push_back(pose.translation() +
+                              robot_point.rotate_by(pose.rotation()));
+    }
+
+    // Overlapping polygons are separated by how far they'd have to move apart
+    // along the edge normal they overlap least on
+    double separation = -std::numeric_limits<double>::infinity();
+    bool has_axes = false;
+    const std::vector<Translation2d>* polygons[] = {&robot_polygon,
+                                                    &m_field_polygon};
+    for (const auto* polygon : polygons) {
+      for (size_t i = 0; i < edge_count(*polygon); ++i) {
+        auto edge = next(*polygon, i) - polygon->at(i);
+        if (edge.norm() == 0.0) {
+          continue;
+        }
+        Translation2d normal{-edge.y() / edge.norm(), edge.x() / edge.norm()};
+
+        auto [robot_min, robot_max] = projection(robot_polygon, normal);
+        auto [field_min, field_max] = projection(m_field_polygon, normal);
+        separation = std::max(
+            {separation, robot_min - field_max, field_min - robot_max});
+        has_axes = true;
+      }
+    }
+    if (has_axes && separation < 0.0) {
+      return separation - m_min_distance;
+    }
+
+    // Separated polygons are closest between a vertex of one and an edge or
+    // vertex of the other
+    auto closest = [](const std::vector<Translation2d>& from,
+                      const std::vector<Translation2d>& to) {
+      double distance = std::numeric_limits<double>::infinity();
+      for (const auto& point : from) {
+        for (const auto& vertex : to) {
+          distance = std::min(distance, point.distance(vertex));
+        }
+        for (size_t i = 0; i < edge_count(to); ++i) {
+          distance = std::min(distance, detail::line_point_distance(
+                                            to.at(i), next(to, i), point));
+        }
+      }
+      return distance;
+    };
+    double distance = std::min(closest(robot_polygon, m_field_polygon),
+                               closest(m_field_polygon, robot_polygon));
+    return distance - m_min_distance;
+  }
+
+  /// Adds this constraint's values to a content hash.
+  ///
+  /// @param hasher The content hasher.
+  void hash(ContentHasher& hasher) const {
+    hasher.add(m_robot_polygon);
+    hasher.add(m_field_polygon);
+    hasher.add(m_min_distance);
+  }
+
+  /// Returns true if both constraints are equal.
+  bool operator==(const PolygonKeepOutConstraint&) const = default;
+
+ private:
+  std::vector<Translation2d> m_robot_polygon;
+  std::vector<Translation2d> m_field_polygon;
+  double m_min_distance;
+
+  /// Returns the number of edges of a polygon. Two points make one edge, and a
+  /// single point none.
+  static size_t edge_count(const std::vector<Translation2d>& polygon) {
+    return polygon.size() < 3 ? polygon.size() - 1 : polygon.size();
+  }
+
+  /// Returns the vertex after the given one.
+  static const Translation2d& next(const std::vector<Translation2d>& polygon,
+                                   size_t i) {
+    return polygon.at((i + 1) % polygon.size());
+  }
+
+  /// Returns the mean of a polygon's vertices.
+  static Translation2d centroid(const std::vector<Translation2d>& polygon) {
+    Translation2d sum;
+    for (const auto& point : polygon) {
+      sum = sum + point;
+    }
+    return sum / static_cast<double>(polygon.size());
+  }
+
+  /// Returns the smallest and largest projections of a polygon's vertices
+  /// onto an axis.
+  static std::pair<double, double> projection(
+      const std::vector<Translation2d>& polygon, const Translation2d& axis) {
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    for (const auto& point : polygon) {
+      min = std::min(min, axis.dot(point));
+      max = std::max(max, axis.dot(point));
+    }
+    return {min, max};
+  }
+};
+
+}  // namespace trajopt
@@ -2,11 +2,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <vector>
+
 #include <sleipnir/autodiff/variable.hpp>
 #include <sleipnir/optimization/problem.hpp>
 
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/content_hash.hpp"
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
@@ -39,6 +45,76 @@ class TRAJOPT_DLLEXPORT PoseEqualityConstraint {
     problem.subject_to(pose == m_pose);
   }
 
+  /// Returns the values of this constraint that can change without rebuilding
+  /// the problem.
+  ///
+  /// @return The x position, y position, heading cosine, and heading sine.
+  std::vector<double> parameter_values() const {
+    return {m_pose.x(), m_pose.y(), m_pose.rotation().cos(),
+            m_pose.rotation().sin()};
+  }
+
+  /// Applies this constraint to the given problem with its parameter values
+  /// replaced by the given parameters.
+  ///
+  /// @param problem The optimization problem.
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  /// @param parameters The parameters, in the order parameter_values() returns
+  ///     their values.
+  void apply_parametric(
+      slp::Problem<double>& problem, const Pose2v<double>& pose,
+      [[maybe_unused]] const Translation2v<double>& linear_velocity,
+      [[maybe_unused]] const slp::Variable<double>& angular_velocity,
+      [[maybe_unused]] const Translation2v<double>& linear_acceleration,
+      [[maybe_unused]] const slp::Variable<double>& angular_acceleration,
+      std::span<const slp::Variable<double>> parameters) {
+    problem.subject_to(pose.translation() ==
+                       Translation2v<double>{parameters[0], parameters[1]});
+
+    // Constrain heading equality on the manifold like Rotation2's operator==,
+    // but only require the robot's heading to be a unit vector since the
+    // parameters aren't decision variables
+    const auto& heading = pose.rotation();
+    problem.subject_to(heading.cos() * parameters[3] -
+                           heading.sin() * parameters[2] ==
+                       0.0);
+    problem.subject_to(heading.cos() * heading.cos() +
+                           heading.sin() * heading.sin() ==
+                       1.0);
+  }
+
+  /// Returns how far the given state is from satisfying this constraint.
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  /// @return The violation (m or rad), which is zero if the constraint is
+  ///     satisfied.
+  double violation(
+      const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    return std::max(
+        pose.translation().distance(m_pose.translation()),
+        std::abs((pose.rotation() - m_pose.rotation()).radians()));
+  }
+
+  /// Adds this constraint's values to a content hash.
+  ///
+  /// @param hasher The content hasher.
+  void hash(ContentHasher& hasher) const { hasher.add(m_pose); }
+
+  /// Returns true if both constraints are equal.
+  bool operator==(const PoseEqualityConstraint&) const = default;
+
  private:
   trajopt::Pose2d m_pose;
 };
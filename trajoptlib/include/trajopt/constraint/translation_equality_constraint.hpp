@@ -2,11 +2,15 @@
 
 #pragma once
 
+#include <span>
+#include <vector>
+
 #include <sleipnir/autodiff/variable.hpp>
 #include <sleipnir/optimization/problem.hpp>
 
 #include "trajopt/geometry/pose2.hpp"
 #include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/content_hash.hpp"
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
@@ -37,6 +41,62 @@ class TRAJOPT_DLLEXPORT TranslationEqualityConstraint {
     problem.subject_to(pose.translation() == m_translation);
   }
 
+  /// Returns the values of this constraint that can change without rebuilding
+  /// the problem.
+  ///
+  /// @return The x and y positions.
+  std::vector<double> parameter_values() const {
+    return {m_translation.x(), m_translation.y()};
+  }
+
+  /// Applies this constraint to the given problem with its parameter values
+  /// replaced by the given parameters.
+  ///
+  /// @param problem The optimization problem.
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  /// @param parameters The parameters, in the order parameter_values() returns
+  ///     their values.
+  void apply_parametric(
+      slp::Problem<double>& problem, const Pose2v<double>& pose,
+      [[maybe_unused]] const Translation2v<double>& linear_velocity,
+      [[maybe_unused]] const slp::Variable<double>& angular_velocity,
+      [[maybe_unused]] const Translation2v<double>& linear_acceleration,
+      [[maybe_unused]] const slp::Variable<double>& angular_acceleration,
+      std::span<const slp::Variable<double>> parameters) {
+    problem.subject_to(pose.translation() ==
+                       Translation2v<double>{parameters[0], parameters[1]});
+  }
+
+  /// Returns how far the given state is from satisfying this constraint.
+  ///
+  /// @param pose The robot's pose.
+  /// @param linear_velocity The robot's linear velocity.
+  /// @param angular_velocity The robot's angular velocity.
+  /// @param linear_acceleration The robot's linear acceleration.
+  /// @param angular_acceleration The robot's angular acceleration.
+  /// @return The violation (m), which is zero if the constraint is
+  ///     satisfied.
+  double violation(
+      const Pose2d& pose,
+      [[maybe_unused]] const Translation2d& linear_velocity,
+      [[maybe_unused]] double angular_velocity,
+      [[maybe_unused]] const Translation2d& linear_acceleration,
+      [[maybe_unused]] double angular_acceleration) const {
+    return pose.translation().distance(m_translation);
+  }
+
+  /// Adds this constraint's values to a content hash.
+  ///
+  /// @param hasher The content hasher.
+  void hash(ContentHasher& hasher) const { hasher.add(m_translation); }
+
+  /// Returns true if both constraints are equal.
+  bool operator==(const TranslationEqualityConstraint&) const = default;
+
  private:
   trajopt::Translation2d m_translation;
 };
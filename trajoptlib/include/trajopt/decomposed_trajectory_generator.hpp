@@ -0,0 +1,227 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sleipnir/optimization/solver/exit_status.hpp>
+
+#include "trajopt/differential_trajectory_generator.hpp"
+#include "trajopt/swerve_trajectory_generator.hpp"
+#include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/generation_stats.hpp"
+#include "trajopt/util/solution_cache.hpp"
+#include "trajopt/util/stitch_solutions.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+#include "trajopt/util/work_stealing_pool.hpp"
+
+namespace trajopt {
+
+/// Generates a trajectory by solving the legs between its full stops
+/// concurrently.
+///
+/// A waypoint with a fixed pose where the linear and angular velocity are
+/// constrained to zero (see PathBuilder::full_stop_waypoints()) decouples the
+/// path before it from the path after it. The path is split at each of them,
+/// each leg is solved as its own problem on a work-stealing thread pool, and
+/// the legs' solutions are stitched back together. A path with several stops
+/// then takes about as long as its slowest leg.
+///
+/// The legs' problems share nothing but the stop's pose and zero velocity, so
+/// with transcriptions that evaluate the acceleration at both ends of a
+/// control interval, the acceleration at a stop is only consistent with the
+/// leg after it. Path callbacks receive each leg's iterates separately, and
+/// may be called from several threads at once.
+///
+/// @tparam Builder The path builder type.
+/// @tparam Generator The trajectory generator type.
+/// @tparam Solution The solution type.
+template <typename Builder, typename Generator, typename Solution>
+class TRAJOPT_DLLEXPORT DecomposedTrajectoryGenerator {
+ public:
+  /// Constructs a DecomposedTrajectoryGenerator.
+  ///
+  /// @param path_builder The path builder.
+  /// @param handle An identifier for state callbacks.
+  explicit DecomposedTrajectoryGenerator(Builder path_builder,
+                                         int64_t handle = 0)
+      : m_path_builder{std::move(path_builder)}, m_handle{handle} {}
+
+  /// Returns the number of legs the path is split into.
+  ///
+  /// @return The number of legs.
+  size_t leg_count() const {
+    return m_path_builder.full_stop_waypoints().size() + 1;
+  }
+
+  /// Generates an optimal trajectory.
+  ///
+  /// This function may take a long time to complete. If a leg throws, the
+  /// exception is rethrown once the legs already running have finished.
+  ///
+  /// @param concurrency The maximum number of legs solved at once. If zero,
+  ///     one leg per hardware thread is solved at once.
+  /// @param diagnostics Enables diagnostic prints.
+  /// @param stats If not null, receives the timing and size statistics of the
+  ///     generation. Times, iterations, and sizes are summed over all legs.
+  /// @return Returns a trajectory on success, or the exit status of the first
+  ///     leg that failed. Legs not yet started when a leg fails are skipped.
+  std::expected<Solution, slp::ExitStatus> generate(
+      size_t concurrency = 0, bool diagnostics = false,
+      GenerationStats* stats = nullptr) const {
+    const auto stops = m_path_builder.full_stop_waypoints();
+    if (stops.empty()) {
+      return generate_leg(m_path_builder, diagnostics, stats);
+    }
+
+    std::vector<size_t> bounds;
+    bounds.reserve(stops.size() + 2);
+    bounds.push_back(0);
+    bounds.insert(bounds.end(), stops.begin(), stops.end());
+    bounds.push_back(m_path_builder.get_control_interval_counts().size());
+
+    const size_t leg_cnt = bounds.size() - 1;
+    std::vector<std::optional<Solution>> solutions(leg_cnt);
+    std::vector<slp::ExitStatus> statuses(
+        leg_cnt, slp::ExitStatus::CALLBACK_REQUESTED_STOP);
+    std::vector<GenerationStats> leg_stats(leg_cnt);
+    std::vector<std::exception_ptr> exceptions(leg_cnt);
+
+    // Once a leg fails the path has no solution, so queued legs are skipped
+    std::atomic<bool> failed = false;
+
+    if (concurrency == 0) {
+      concurrency =
+          std::max(size_t{1}, size_t{std::thread::hardware_concurrency()});
+    }
+    {
+      // Threads beyond one per leg would sit idle
+      WorkStealingPool pool{std::min(concurrency, leg_cnt)};
+      for (size_t leg = 0; leg < leg_cnt; ++leg) {
+        pool.submit([&, leg] {
+          if (failed || m_cancellation_token.is_cancelled()) {
+            failed = true;
+            return;
+          }
+
+          try {
+            auto solution = generate_leg(
+                m_path_builder.sub_path(bounds[leg], bounds[leg + 1]),
+                diagnostics, &leg_stats[leg]);
+            if (solution.has_value()) {
+              solutions[leg] = std::move(solution.value());
+            } else {
+              statuses[leg] = solution.error();
+              failed = true;
+            }
+          } catch (...) {
+            // Tasks must not throw, so the exception is rethrown on the
+            // calling thread
+            exceptions[leg] = std::current_exception();
+            failed = true;
+          }
+        });
+      }
+      pool.wait();
+    }
+
+    if (stats != nullptr) {
+      *stats = GenerationStats{};
+      for (const auto& leg : leg_stats) {
+        *stats += leg;
+      }
+    }
+
+    for (const auto& exception : exceptions) {
+      if (exception != nullptr) {
+        std::rethrow_exception(exception);
+      }
+    }
+
+    if (failed) {
+      // Legs skipped after another leg failed report a stop, so report the
+      // failure that caused it
+      auto failure = std::ranges::find_if(statuses, [](auto status) {
+        return status != slp::ExitStatus::CALLBACK_REQUESTED_STOP;
+      });
+      return std::unexpected{failure != statuses.end()
+                                 ? *failure
+                                 : slp::ExitStatus::CALLBACK_REQUESTED_STOP};
+    }
+
+    std::vector<Solution> legs;
+    legs.reserve(leg_cnt);
+    for (auto& solution : solutions) {
+      legs.push_back(std::move(solution.value()));
+    }
+    return stitch_solutions(legs);
+  }
+
+  /// Sets a cache that legs are looked up in before they're solved, and that
+  /// solved legs are stored in. Legs are keyed by their own content hash, so
+  /// editing one leg of a path only solves that leg again.
+  ///
+  /// @param cache The cache, or null to solve every leg.
+  void set_solution_cache(std::shared_ptr<SolutionCache<Solution>> cache) {
+    m_cache = std::move(cache);
+  }
+
+  /// Returns the token used to cancel this generator's solves.
+  ///
+  /// @return The cancellation token.
+  CancellationToken get_cancellation_token() const {
+    return m_cancellation_token;
+  }
+
+  /// Replaces the token used to cancel this generator's solves.
+  ///
+  /// @param token The new cancellation token.
+  void set_cancellation_token(CancellationToken token) {
+    m_cancellation_token = std::move(token);
+  }
+
+ private:
+  Builder m_path_builder;
+  int64_t m_handle;
+  CancellationToken m_cancellation_token;
+  std::shared_ptr<SolutionCache<Solution>> m_cache;
+
+  /// Generates one leg, or loads it from the cache.
+  std::expected<Solution, slp::ExitStatus> generate_leg(
+      const Builder& leg_builder, bool diagnostics,
+      GenerationStats* stats) const {
+    auto generate = [&] {
+      Generator generator{leg_builder, m_handle};
+      generator.set_cancellation_token(m_cancellation_token);
+      return generator.generate(diagnostics, stats);
+    };
+    if (m_cache == nullptr) {
+      return generate();
+    }
+    return m_cache->get_or_generate(leg_builder, generate);
+  }
+};
+
+/// Generates swerve trajectories leg by leg between full stops.
+using SwerveDecomposedTrajectoryGenerator =
+    DecomposedTrajectoryGenerator<SwervePathBuilder, SwerveTrajectoryGenerator,
+                                  SwerveSolution>;
+
+/// Generates differential trajectories leg by leg between full stops.
+using DifferentialDecomposedTrajectoryGenerator =
+    DecomposedTrajectoryGenerator<DifferentialPathBuilder,
+                                  DifferentialTrajectoryGenerator,
+                                  DifferentialSolution>;
+
+}  // namespace trajopt
@@ -4,7 +4,10 @@
 
 #include <stdint.h>
 
+#include <chrono>
 #include <expected>
+#include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -13,7 +16,14 @@
 #include <sleipnir/optimization/solver/exit_status.hpp>
 
 #include "trajopt/path/path_builder.hpp"
+#include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/chassis_limits.hpp"
+#include "trajopt/util/content_hash.hpp"
+#include "trajopt/util/generation_budget.hpp"
+#include "trajopt/util/generation_stats.hpp"
+#include "trajopt/util/progress_channel.hpp"
 #include "trajopt/util/symbol_exports.hpp"
+#include "trajopt/util/transcription.hpp"
 
 namespace trajopt {
 
@@ -39,6 +49,24 @@ struct TRAJOPT_DLLEXPORT DifferentialDrivetrain {
 
   /// Distance between the two driverails (m).
   double trackwidth;
+
+  /// Returns the chassis motion limits implied by the wheels.
+  ///
+  /// @return The chassis limits.
+  ChassisLimits chassis_limits() const;
+
+  /// Adds the drivetrain's values to a content hash.
+  ///
+  /// @param hasher The content hasher.
+  void hash(ContentHasher& hasher) const {
+    hasher.add(mass);
+    hasher.add(moi);
+    hasher.add(wheel_radius);
+    hasher.add(wheel_max_angular_velocity);
+    hasher.add(wheel_max_torque);
+    hasher.add(wheel_cof);
+    hasher.add(trackwidth);
+  }
 };
 
 /// The holonomic trajectory optimization solution.
@@ -213,10 +241,81 @@ class TRAJOPT_DLLEXPORT DifferentialTrajectoryGenerator {
   /// This function may take a long time to complete.
   ///
   /// @param diagnostics Enables diagnostic prints.
+  /// @param stats If not null, receives the timing and size statistics of
+  ///     the problem's construction and this solve.
   /// @return Returns a differential trajectory on success, or the solver's exit
   ///     status on failure.
   std::expected<DifferentialSolution, slp::ExitStatus> generate(
-      bool diagnostics = false);
+      bool diagnostics = false, GenerationStats* stats = nullptr);
+
+  /// Generates an optimal trajectory within a time and iteration budget.
+  ///
+  /// If the budget runs out, the solve is cancelled, or the solver fails, the
+  /// best iterate it reached is returned instead of nothing, so callers with
+  /// bounded latency always get a trajectory to work with.
+  ///
+  /// @param budget The time and iteration budget.
+  /// @param diagnostics Enables diagnostic prints.
+  /// @param stats If not null, receives the timing and size statistics of
+  ///     the problem's construction and this solve.
+  /// @return The solution or best iterate, the solver's exit status, and how
+  ///     far the returned trajectory is from feasible.
+  BudgetedGeneration<DifferentialSolution> generate(
+      const GenerationBudget& budget, bool diagnostics = false,
+      GenerationStats* stats = nullptr);
+
+  /// Seeds the solver with a previous solution instead of the path's initial
+  /// guess.
+  ///
+  /// Every state, input, and time step of the solution is used, so a solution
+  /// of a slightly edited path re-converges in a few iterations. If the
+  /// solution was generated with different control interval counts, it's
+  /// resampled onto this generator's layout first.
+  ///
+  /// @param solution The previous solution.
+  /// @param control_interval_counts The control interval counts the previous
+  ///     solution was generated with.
+  /// @return True if the solver was seeded, or false if the solution's fields
+  ///     don't have one entry per sample of control_interval_counts and it
+  ///     was ignored.
+  bool warm_start(const DifferentialSolution& solution,
+                  const std::vector<size_t>& control_interval_counts);
+
+  /// Opens a channel that streams the solver's intermediate solutions.
+  ///
+  /// The solver publishes to the channel at most ProgressOptions::rate times
+  /// per second and never waits for the consumer, which polls the channel from
+  /// its own thread. Opening a channel replaces any previously opened one.
+  ///
+  /// @param options The channel's options.
+  /// @return The channel.
+  std::shared_ptr<ProgressChannel<DifferentialSolution>> open_progress_channel(
+      ProgressOptions options = {}) {
+    progress_channel =
+        std::make_shared<ProgressChannel<DifferentialSolution>>(options);
+    return progress_channel;
+  }
+
+  /// Returns the token used to cancel this generator's solve.
+  ///
+  /// The returned token shares state with the generator, so calling
+  /// CancellationToken::cancel() on it from another thread stops this
+  /// generator's solve without affecting any other generator.
+  ///
+  /// @return The cancellation token.
+  CancellationToken get_cancellation_token() const {
+    return cancellation_token;
+  }
+
+  /// Replaces the token used to cancel this generator's solve.
+  ///
+  /// This lets several generators, or a generator and its caller, share one
+  /// token.
+  ///
+  /// @param token The new cancellation token.
+  void set_cancellation_token(CancellationToken token) {
+    cancellation_token = std::move(token);
+  }
 
  private:
   /// Differential path
@@ -231,6 +330,11 @@ class TRAJOPT_DLLEXPORT DifferentialTrajectoryGenerator {
   std::vector<slp::Variable<double>> al;
   std::vector<slp::Variable<double>> ar;
 
+  /// Cosine and sine of each sample's heading, shared by the dynamics and the
+  /// constraints applied at the sample
+  std::vector<slp::Variable<double>> cosθ;
+  std::vector<slp::Variable<double>> sinθ;
+
   /// Input Variables
   std::vector<slp::Variable<double>> Fl;
   std::vector<slp::Variable<double>> Fr;
@@ -241,11 +345,71 @@ class TRAJOPT_DLLEXPORT DifferentialTrajectoryGenerator {
   /// Discretization Constants
   std::vector<size_t> Ns;
 
+  /// How the dynamics are enforced between samples
+  Transcription transcription;
+
+  /// Geometric constraints left out of the problem
+  std::vector<LazyConstraint> inactive_constraints;
+
   slp::Problem<double> problem;
 
+  /// Cancellation token checked on every solver iteration
+  CancellationToken cancellation_token;
+
+  /// Channel intermediate solutions are published to, if one is open
+  std::shared_ptr<ProgressChannel<DifferentialSolution>> progress_channel;
+
+  /// When an intermediate solution was last published to the progress channel
+  std::chrono::steady_clock::time_point last_progress_time;
+
+  /// When the path's callbacks were last called
+  std::chrono::steady_clock::time_point last_callback_time;
+
+  /// Statistics of the problem's construction and the latest solve
+  GenerationStats generation_stats;
+
+  /// Budget of the running generate() call
+  GenerationBudget budget;
+
+  /// When the running generate() call started solving
+  std::chrono::steady_clock::time_point solve_start_time;
+
+  /// True if the running generate() call's budget ran out
+  bool budget_exhausted = false;
+
+  /// Best iterate of the running generate() call, if it returns one
+  std::optional<BestIterate<DifferentialSolution>> best_iterate;
+
+  /// Storage the solver's iterates are copied into for best_iterate
+  DifferentialSolution iterate;
+
+  /// Left-out geometric constraints that have since been applied
+  std::vector<LazyConstraint> activated_constraints;
+
   void apply_initial_guess(const DifferentialSolution& solution);
 
+  /// Solves the problem, then re-solves it until no left-out geometric
+  /// constraint needs to be applied.
+  ///
+  /// @param diagnostics Enables diagnostic prints.
+  /// @param stats If not null, receives the generation statistics.
+  /// @return The last solve's exit status.
+  slp::ExitStatus solve(bool diagnostics, GenerationStats* stats);
+
+  /// Applies the left-out geometric constraints the current solution violates
+  /// or comes within the activation margin of.
+  ///
+  /// @return The number of constraints applied.
+  size_t activate_constraints();
+
+  /// Returns how far a solution is from satisfying the problem's constraints,
+  /// including the left-out ones. See solution_violation().
+  double violation(const DifferentialSolution& solution) const;
+
   DifferentialSolution construct_differential_solution();
+
+  void fill_differential_solution(DifferentialSolution& solution,
+                                  ProgressPayload payload);
 };
 
 }  // namespace trajopt
@@ -113,4 +113,9 @@ auto operator==(const Pose2<LHS>& lhs, const Pose2<RHS>& rhs) {
        lhs.rotation() == rhs.rotation()}};
 }
 
+inline bool operator==(const Pose2d& lhs, const Pose2d& rhs) {
+  return lhs.translation() == rhs.translation() &&
+         lhs.rotation() == rhs.rotation();
+}
+
 }  // namespace trajopt
@@ -0,0 +1,274 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <expected>
+#include <numeric>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <sleipnir/optimization/solver/exit_status.hpp>
+
+#include "trajopt/differential_trajectory_generator.hpp"
+#include "trajopt/swerve_trajectory_generator.hpp"
+#include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/dynamics_defect.hpp"
+#include "trajopt/util/generation_stats.hpp"
+#include "trajopt/util/resample_solution.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// Options for multi-resolution generation.
+struct TRAJOPT_DLLEXPORT MultiResolutionOptions {
+  /// The number of resolution levels, including the final one at the path's
+  /// control interval counts. One level disables refinement.
+  size_t levels = 3;
+
+  /// The ratio between the control interval counts of consecutive levels.
+  /// Must be greater than 1.
+  double refinement_ratio = 2.0;
+
+  /// The minimum number of control intervals per segment on coarse levels.
+  size_t min_control_intervals = 4;
+};
+
+/// Returns the control interval counts of a multi-resolution generation's next
+/// level.
+///
+/// Each segment's count starts at its share of the next level's resolution and
+/// is scaled by how its dynamics defect compares to the average, so poorly
+/// resolved segments approach their final count sooner.
+///
+/// @param defects Each segment's dynamics defect on the current level.
+/// @param counts The current level's control interval counts.
+/// @param target_counts The path's control interval counts.
+/// @param options The refinement options. The refinement ratio must be greater
+///     than 1.
+/// @param levels_after_next The number of levels after the next one.
+/// @return The next level's control interval counts.
+inline std::vector<size_t> refine_control_interval_counts(
+    const std::vector<double>& defects, const std::vector<size_t>& counts,
+    const std::vector<size_t>& target_counts,
+    const MultiResolutionOptions& options, size_t levels_after_next) {
+  const double ratio = options.refinement_ratio;
+
+  double mean_defect =
+      defects.empty() ? 0.0
+                      : std::accumulate(defects.begin(), defects.end(), 0.0) /
+                            defects.size();
+
+  double scale = std::pow(ratio, -static_cast<double>(levels_after_next));
+
+  std::vector<size_t> next_counts;
+  next_counts.reserve(counts.size());
+  for (size_t sgmt_index = 0; sgmt_index < counts.size(); ++sgmt_index) {
+    size_t target_count = target_counts[sgmt_index];
+
+    double weight =
+        mean_defect > 0.0 ? defects[sgmt_index] / mean_defect : 1.0;
+    weight = std::clamp(weight, 1.0 / ratio, ratio);
+
+    size_t count =
+        static_cast<size_t>(std::ceil(target_count * scale * weight));
+    size_t min_count =
+        std::max(std::min(options.min_control_intervals, target_count),
+                 counts[sgmt_index]);
+    next_counts.push_back(std::clamp(count, min_count, target_count));
+  }
+  return next_counts;
+}
+
+/// Generates a trajectory coarse-to-fine.
+///
+/// The path is first solved with a fraction of its control intervals. Each
+/// solution is interpolated onto a finer grid and warm starts the next level,
+/// and the last level is solved at the path's own control interval counts.
+/// Since most iterations happen on small problems, long paths converge in a
+/// fraction of the time.
+///
+/// Between levels, segments whose interpolated solution has the largest
+/// dynamics defect are refined more than the others, so intervals are spent
+/// where the motion needs them.
+///
+/// @tparam Builder The path builder type.
+/// @tparam Generator The trajectory generator type.
+/// @tparam Solution The solution type.
+template <typename Builder, typename Generator, typename Solution>
+class TRAJOPT_DLLEXPORT MultiResolutionTrajectoryGenerator {
+ public:
+  /// Constructs a MultiResolutionTrajectoryGenerator.
+  ///
+  /// @param path_builder The path builder.
+  /// @param options The refinement options.
+  /// @param handle An identifier for state callbacks.
+  explicit MultiResolutionTrajectoryGenerator(
+      Builder path_builder, MultiResolutionOptions options = {},
+      int64_t handle = 0)
+      : m_path_builder{std::move(path_builder)},
+        m_options{options},
+        m_handle{handle} {
+    assert(m_options.refinement_ratio > 1.0);
+  }
+
+  /// Generates an optimal trajectory.
+  ///
+  /// This function may take a long time to complete.
+  ///
+  /// @param diagnostics Enables diagnostic prints.
+  /// @param stats If not null, receives the timing and size statistics of the
+  ///     generation. Times, iterations, and sizes are summed over all
+  ///     levels.
+  /// @return Returns a trajectory on success, or the solver's exit status on
+  ///     failure.
+  std::expected<Solution, slp::ExitStatus> generate(
+      bool diagnostics = false, GenerationStats* stats = nullptr) {
+    const auto target_counts = m_path_builder.get_control_interval_counts();
+    // A ratio that doesn't coarsen leaves only the final level to solve
+    size_t levels = m_options.refinement_ratio > 1.0
+                        ? std::max<size_t>(m_options.levels, 1)
+                        : 1;
+
+    GenerationStats total_stats;
+    std::optional<Solution> seed;
+    std::vector<size_t> seed_counts;
+    std::vector<size_t> counts = coarsest_counts(target_counts, levels);
+
+    for (size_t level = 0; level < levels; ++level) {
+      bool final_level = level == levels - 1 || counts == target_counts;
+      if (final_level) {
+        counts = target_counts;
+      }
+
+      Builder builder = m_path_builder;
+      auto level_counts = counts;
+      builder.set_control_interval_counts(std::move(level_counts));
+      Generator generator{std::move(builder), m_handle};
+      generator.set_cancellation_token(m_cancellation_token);
+      if (seed.has_value()) {
+        generator.warm_start(seed.value(), seed_counts);
+      }
+
+      GenerationStats level_stats;
+      auto solution = generator.generate(diagnostics, &level_stats);
+      total_stats += level_stats;
+
+      if (final_level || !solution.has_value()) {
+        // A coarse level's failure is only final if it was cancelled. Other
+        // failures fall back to solving the final level without a seed.
+        if (!final_level &&
+            solution.error() != slp::ExitStatus::CALLBACK_REQUESTED_STOP) {
+          seed.reset();
+          counts = target_counts;
+          continue;
+        }
+
+        if (stats != nullptr) {
+          *stats = std::move(total_stats);
+        }
+        return solution;
+      }
+
+      seed = std::move(solution.value());
+      seed_counts = counts;
+      counts = refined_counts(seed.value(), counts, target_counts,
+                              levels - 2 - level);
+    }
+
+    // Unreachable, since the final level always returns
+    return std::unexpected{slp::ExitStatus::CALLBACK_REQUESTED_STOP};
+  }
+
+  /// Returns the token used to cancel this generator's solves.
+  ///
+  /// @return The cancellation token.
+  CancellationToken get_cancellation_token() const {
+    return m_cancellation_token;
+  }
+
+  /// Replaces the token used to cancel this generator's solves.
+  ///
+  /// @param token The new cancellation token.
+  void set_cancellation_token(CancellationToken token) {
+    m_cancellation_token = std::move(token);
+  }
+
+ private:
+  Builder m_path_builder;
+  MultiResolutionOptions m_options;
+  int64_t m_handle;
+  CancellationToken m_cancellation_token;
+
+  /// Returns the smallest count a coarse level may give a segment.
+  size_t min_count(size_t target_count) const {
+    return std::min(m_options.min_control_intervals, target_count);
+  }
+
+  /// Returns the control interval counts of the coarsest level.
+  std::vector<size_t> coarsest_counts(const std::vector<size_t>& target_counts,
+                                      size_t levels) const {
+    double scale = std::pow(m_options.refinement_ratio,
+                            -static_cast<double>(levels - 1));
+
+    std::vector<size_t> counts;
+    counts.reserve(target_counts.size());
+    for (size_t target_count : target_counts) {
+      counts.push_back(std::clamp(
+          static_cast<size_t>(std::ceil(target_count * scale)),
+          min_count(target_count), target_count));
+    }
+    return counts;
+  }
+
+  /// Returns the control interval counts of the next level. See
+  /// refine_control_interval_counts().
+  ///
+  /// @param solution The current level's solution.
+  /// @param counts The current level's control interval counts.
+  /// @param target_counts The path's control interval counts.
+  /// @param levels_after_next The number of levels after the next one.
+  std::vector<size_t> refined_counts(const Solution& solution,
+                                     const std::vector<size_t>& counts,
+                                     const std::vector<size_t>& target_counts,
+                                     size_t levels_after_next) const {
+    const double ratio = m_options.refinement_ratio;
+
+    // Interpolation error of the current solution shows up as dynamics defects
+    // on a finer grid
+    std::vector<size_t> probe_counts;
+    probe_counts.reserve(counts.size());
+    for (size_t count : counts) {
+      probe_counts.push_back(std::max<size_t>(
+          static_cast<size_t>(std::ceil(count * ratio)), count + 1));
+    }
+    auto defects = segment_dynamics_defects(
+        m_path_builder.get_drivetrain(),
+        resample_solution(solution, counts, probe_counts), probe_counts,
+        m_path_builder.get_transcription().value_or(
+            default_transcription<Solution>()));
+
+    return refine_control_interval_counts(defects, counts, target_counts,
+                                          m_options, levels_after_next);
+  }
+};
+
+/// Generates swerve trajectories coarse-to-fine.
+using SwerveMultiResolutionTrajectoryGenerator =
+    MultiResolutionTrajectoryGenerator<SwervePathBuilder,
+                                       SwerveTrajectoryGenerator,
+                                       SwerveSolution>;
+
+/// Generates differential trajectories coarse-to-fine.
+using DifferentialMultiResolutionTrajectoryGenerator =
+    MultiResolutionTrajectoryGenerator<DifferentialPathBuilder,
+                                       DifferentialTrajectoryGenerator,
+                                       DifferentialSolution>;
+
+}  // namespace trajopt
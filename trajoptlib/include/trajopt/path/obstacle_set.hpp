@@ -0,0 +1,156 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/content_hash.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// Represents a physical keep-out region that the robot must avoid by a certain
+/// distance. Arbitrary polygons can be expressed with this class, and keep-out
+/// circles can also be created by only using one point with a safety distance.
+///
+/// Keep-out points must be wound either clockwise or counterclockwise.
+struct TRAJOPT_DLLEXPORT KeepOutRegion {
+  /// Minimum distance from the keep-out region the robot must maintain.
+  double safety_distance;
+
+  /// The list of points that make up this keep-out region.
+  std::vector<Translation2d> points;
+
+  /// Adds the region's values to a content hash.
+  ///
+  /// @param hasher The content hasher.
+  void hash(ContentHasher& hasher) const {
+    hasher.add(safety_distance);
+    hasher.add(points);
+  }
+};
+
+/// A set of keep-out regions indexed by a uniform grid, so the regions near
+/// part of the field can be found without testing every region.
+class TRAJOPT_DLLEXPORT ObstacleSet {
+ public:
+  /// Constructs an empty ObstacleSet.
+  ///
+  /// @param cell_size The side length of each grid cell (m). Cells around the
+  ///     size of a typical obstacle work best.
+  explicit ObstacleSet(double cell_size = 1.0) : m_cell_size{cell_size} {}
+
+  /// Adds a keep-out region to the set.
+  ///
+  /// @param obstacle The keep-out region.
+  /// @return True if the region was added, or false if it has no points and
+  ///     was ignored.
+  bool add(KeepOutRegion obstacle) {
+    if (obstacle.points.empty()) {
+      return false;
+    }
+
+    Bounds bounds{obstacle.points.front(), obstacle.points.front()};
+    for (const auto& point : obstacle.points) {
+      bounds.min = {std::min(bounds.min.x(), point.x()),
+                    std::min(bounds.min.y(), point.y())};
+      bounds.max = {std::max(bounds.max.x(), point.x()),
+                    std::max(bounds.max.y(), point.y())};
+    }
+    Translation2d inflation{obstacle.safety_distance,
+                            obstacle.safety_distance};
+    bounds.min = bounds.min - inflation;
+    bounds.max = bounds.max + inflation;
+
+    size_t index = m_obstacles.size();
+    for_each_cell(bounds, [&](std::pair<int64_t, int64_t> cell) {
+      m_cells[cell].push_back(index);
+    });
+
+    m_obstacles.push_back(std::move(obstacle));
+    m_bounds.push_back(bounds);
+    return true;
+  }
+
+  /// Returns the keep-out regions in the order they were added.
+  const std::vector<KeepOutRegion>& obstacles() const { return m_obstacles; }
+
+  /// Returns the number of keep-out regions.
+  size_t size() const { return m_obstacles.size(); }
+
+  /// Returns true if the set has no keep-out regions.
+  bool empty() const { return m_obstacles.empty(); }
+
+  /// Finds the keep-out regions whose bounding box, inflated by their safety
+  /// distance, overlaps a box.
+  ///
+  /// @param min The box's lower-left corner.
+  /// @param max The box's upper-right corner.
+  /// @return The indices of the overlapping regions in ascending order.
+  std::vector<size_t> query(const Translation2d& min,
+                            const Translation2d& max) const {
+    Bounds box{min, max};
+
+    std::vector<size_t> indices;
+    for_each_cell(box, [&](std::pair<int64_t, int64_t> cell) {
+      auto it = m_cells.find(cell);
+      if (it == m_cells.end()) {
+        return;
+      }
+      for (size_t index : it->second) {
+        if (m_bounds[index].overlaps(box)) {
+          indices.push_back(index);
+        }
+      }
+    });
+
+    // Regions spanning several cells are found once per cell
+    std::ranges::sort(indices);
+    auto duplicates = std::ranges::unique(indices);
+    indices.erase(duplicates.begin(), duplicates.end());
+    return indices;
+  }
+
+ private:
+  /// An axis-aligned bounding box.
+  struct Bounds {
+    Translation2d min;
+    Translation2d max;
+
+    bool overlaps(const Bounds& other) const {
+      return min.x() <= other.max.x() && other.min.x() <= max.x() &&
+             min.y() <= other.max.y() && other.min.y() <= max.y();
+    }
+  };
+
+  double m_cell_size;
+  std::vector<KeepOutRegion> m_obstacles;
+  std::vector<Bounds> m_bounds;
+
+  /// Indices of the regions overlapping each occupied cell
+  std::map<std::pair<int64_t, int64_t>, std::vector<size_t>> m_cells;
+
+  /// Calls a function with each grid cell a box overlaps.
+  template <typename F>
+  void for_each_cell(const Bounds& bounds, F&& f) const {
+    auto cell = [&](double coordinate) {
+      return static_cast<int64_t>(std::floor(coordinate / m_cell_size));
+    };
+
+    for (int64_t i = cell(bounds.min.x()); i <= cell(bounds.max.x()); ++i) {
+      for (int64_t j = cell(bounds.min.y()); j <= cell(bounds.max.y()); ++j) {
+        f(std::pair{i, j});
+      }
+    }
+  }
+};
+
+}  // namespace trajopt
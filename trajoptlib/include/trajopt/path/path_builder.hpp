@@ -4,31 +4,35 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <functional>
+#include <optional>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "trajopt/constraint/constraint.hpp"
 #include "trajopt/geometry/translation2.hpp"
+#include "trajopt/path/obstacle_set.hpp"
 #include "trajopt/path/path.hpp"
+#include "trajopt/util/content_hash.hpp"
 #include "trajopt/util/generate_linear_initial_guess.hpp"
 #include "trajopt/util/generate_spline_initial_guess.hpp"
 #include "trajopt/util/symbol_exports.hpp"
+#include "trajopt/util/trajopt_util.hpp"
+#include "trajopt/util/transcription.hpp"
 
 namespace trajopt {
 
-/// Represents a physical keep-out region that the robot must avoid by a certain
-/// distance. Arbitrary polygons can be expressed with this class, and keep-out
-/// circles can also be created by only using one point with a safety distance.
-///
-/// Keep-out points must be wound either clockwise or counterclockwise.
-struct TRAJOPT_DLLEXPORT KeepOutRegion {
-  /// Minimum distance from the keep-out region the robot must maintain.
-  double safety_distance;
+/// The keep-out constraints of a path's obstacle set on one segment.
+struct TRAJOPT_DLLEXPORT SegmentObstacleConstraints {
+  /// Constraints of the obstacles the segment's initial guess passes near.
+  std::vector<Constraint> near;
 
-  /// The list of points that make up this keep-out region.
-  std::vector<Translation2d> points;
+  /// Constraints of the other obstacles.
+  std::vector<Constraint> far;
 };
 
 /// Path builder.
@@ -45,6 +49,11 @@ class TRAJOPT_DLLEXPORT PathBuilder {
     path.drivetrain = std::move(drivetrain);
   }
 
+  /// Get the Drivetrain object
+  ///
+  /// @return the drivetrain
+  const Drivetrain& get_drivetrain() const { return path.drivetrain; }
+
   /// Add a rectangular bumper to a list used when applying
   /// keep-out constraints.
   ///
@@ -81,6 +90,92 @@ class TRAJOPT_DLLEXPORT PathBuilder {
     return control_interval_counts;
   }
 
+  /// Set how the drivetrain dynamics are enforced between samples. Unless set,
+  /// each generator uses its default transcription.
+  ///
+  /// @param transcription the transcription
+  void set_transcription(Transcription transcription) {
+    this->transcription = transcription;
+  }
+
+  /// Get the transcription set for this path, if any
+  ///
+  /// @return the transcription, or nothing if the generator's default is used
+  std::optional<Transcription> get_transcription() const {
+    return transcription;
+  }
+
+  /// Make the problem's waypoint poses, nonzero velocity and acceleration
+  /// limits, and drivetrain constants parameters instead of constants, so
+  /// SwerveTrajectoryGenerator::update() can change them without rebuilding
+  /// the problem.
+  ///
+  /// Off by default, since constants fold into the expressions that use them
+  /// while parameters stay nodes of every expression they appear in.
+  ///
+  /// @param parametric whether the problem is built with parameters
+  void set_parametric(bool parametric) { this->parametric = parametric; }
+
+  /// Get whether the problem is built with parameters
+  ///
+  /// @return true if the problem's values are parameters
+  bool get_parametric() const { return parametric; }
+
+  /// Leave geometric constraints (e.g., keep-out and keep-in regions) out of
+  /// the problem at samples where the initial guess is far from them.
+  ///
+  /// After each solve, the left-out constraints the solution violates or comes
+  /// within the activation margin of are added, and the problem is solved again
+  /// from that solution until none are. Paths with many obstacles the robot
+  /// never comes near solve with far fewer constraints.
+  ///
+  /// @param activation_margin how close a sample must come to violating a
+  ///     geometric constraint before it's applied (m)
+  void set_lazy_geometric_constraints(double activation_margin) {
+    lazy_constraint_margin = activation_margin;
+  }
+
+  /// Get the activation margin of lazily applied geometric constraints
+  ///
+  /// @return the activation margin, or nothing if every constraint is applied
+  ///     up front
+  std::optional<double> get_lazy_geometric_constraints() const {
+    return lazy_constraint_margin;
+  }
+
+  /// Add a keep-out region to the path's obstacle set. The robot's bumpers
+  /// must stay at least the region's safety distance away from it.
+  ///
+  /// Unlike keep-out constraints added with sgmt_constraint(), an obstacle is
+  /// only applied to segments whose initial guess passes within the obstacle
+  /// margin of it. It's left out of the other segments until a solution comes
+  /// within the margin, so the number of constraints grows with the clutter
+  /// along the path rather than with the whole field.
+  ///
+  /// @param obstacle the keep-out region
+  /// @return true if the region was added, or false if it has no points and
+  ///     was ignored
+  bool add_obstacle(KeepOutRegion obstacle) {
+    return obstacles.add(std::move(obstacle));
+  }
+
+  /// Get the path's obstacle set
+  ///
+  /// @return the obstacle set
+  const ObstacleSet& get_obstacles() const { return obstacles; }
+
+  /// Set how close the robot's bumpers may come to an obstacle before it's
+  /// applied to a segment.
+  ///
+  /// @param margin the obstacle margin (m)
+  void set_obstacle_margin(double margin) { obstacle_margin = margin; }
+
+  /// Get how close the robot's bumpers may come to an obstacle before it's
+  /// applied to a segment.
+  ///
+  /// @return the obstacle margin (m)
+  double get_obstacle_margin() const { return obstacle_margin; }
+
   /// Provide a guess of the instantaneous pose of the robot at a waypoint.
   ///
   /// @param wpt_index the waypoint to apply the guess to
@@ -90,6 +185,18 @@ class TRAJOPT_DLLEXPORT PathBuilder {
     initial_guess_points.at(wpt_index).back() = pose_guess;
   }
 
+  /// Get the guess of the robot's pose at each waypoint
+  ///
+  /// @return the waypoint pose guesses, one per waypoint
+  std::vector<Pose2d> get_wpt_initial_guess_points() const {
+    std::vector<Pose2d> poses;
+    poses.reserve(initial_guess_points.size());
+    for (const auto& points : initial_guess_points) {
+      poses.push_back(points.back());
+    }
+    return poses;
+  }
+
   /// Add a sequence of initial guess points between two waypoints. The points
   /// are inserted between the waypoints at fromIndex and fromIndex + 1. Linear
   /// interpolation between the waypoint initial guess points and these segment
@@ -177,6 +284,266 @@ class TRAJOPT_DLLEXPORT PathBuilder {
     path.callbacks.push_back(callback);
   }
 
+  /// Estimate how many control intervals each segment needs.
+  ///
+  /// Each segment's duration is estimated with trapezoidal velocity profiles
+  /// over the distance and heading change between its initial guess points,
+  /// using the drivetrain's limits lowered by the velocity and acceleration
+  /// constraints applied to the segment. The duration is then divided into
+  /// steps of target_dt, or shorter steps if the robot could otherwise move
+  /// farther than its narrowest wheel spacing between samples.
+  ///
+  /// @param target_dt The desired time between samples (s).
+  /// @return The estimated control interval count of each segment.
+  std::vector<size_t> estimate_control_interval_counts(
+      double target_dt = 0.1) const {
+    const auto limits = path.drivetrain.chassis_limits();
+    const double dt =
+        std::min(limits.min_wheel_spacing / limits.max_velocity, target_dt);
+
+    // Unlike calculate_trapezoidal_time(), a zero distance or velocity takes
+    // no time
+    auto trapezoidal_time = [](double distance, double velocity,
+                               double acceleration) {
+      if (distance == 0.0 || velocity == 0.0) {
+        return 0.0;
+      }
+      return calculate_trapezoidal_time(distance, velocity, acceleration);
+    };
+
+    std::vector<size_t> counts;
+    for (size_t sgmt_index = 0; sgmt_index + 1 < initial_guess_points.size();
+         ++sgmt_index) {
+      // The segment runs through the guess points inserted before the next
+      // waypoint's own guess point
+      const Pose2d& start = initial_guess_points.at(sgmt_index).back();
+      const auto& sgmt_points = initial_guess_points.at(sgmt_index + 1);
+
+      double distance = 0.0;
+      Translation2d previous = start.translation();
+      for (const auto& point : sgmt_points) {
+        distance += previous.distance(point.translation());
+        previous = point.translation();
+      }
+      const Pose2d& end = sgmt_points.back();
+      double dθ = std::abs(
+          angle_modulus(end.rotation().radians() - start.rotation().radians()));
+
+      double max_v = limits.max_velocity;
+      double max_a = limits.max_acceleration;
+      double max_ω = limits.max_angular_velocity;
+      for (const auto& constraint :
+           path.waypoints.at(sgmt_index + 1).segment_constraints) {
+        if (auto velocity = std::get_if<LinearVelocityMaxMagnitudeConstraint>(
+                &constraint)) {
+          max_v = std::min(max_v, velocity->max_magnitude());
+        } else if (auto acceleration =
+                       std::get_if<LinearAccelerationMaxMagnitudeConstraint>(
+                           &constraint)) {
+          max_a = std::min(max_a, acceleration->max_magnitude());
+        } else if (auto angular_velocity =
+                       std::get_if<AngularVelocityMaxMagnitudeConstraint>(
+                           &constraint)) {
+          max_ω = std::min(max_ω, angular_velocity->max_magnitude());
+        }
+      }
+
+      // A robot that can't turn along the segment doesn't, and one that turns
+      // slowly drives no faster than it turns
+      if (max_ω == 0.0) {
+        dθ = 0.0;
+      }
+      const double angular_time =
+          trapezoidal_time(dθ, max_ω, limits.max_angular_acceleration);
+      if (angular_time > 0.0) {
+        max_v = std::min(max_v, distance / angular_time);
+      }
+      const double linear_time = trapezoidal_time(distance, max_v, max_a);
+
+      counts.push_back(std::max<size_t>(
+          static_cast<size_t>(std::ceil((linear_time + angular_time) / dt)),
+          1));
+    }
+
+    return counts;
+  }
+
+  /// Split the keep-out constraints of the obstacle set by which segments'
+  /// initial guess passes near them.
+  ///
+  /// Each segment's corridor is the area swept by the robot's bumpers along
+  /// the initial guess, inflated by the obstacle margin. Obstacles overlapping
+  /// the corridor are found with the obstacle set's grid.
+  ///
+  /// @param initial_guess the initial guess the generator starts from
+  /// @return the keep-out constraints of each segment
+  std::vector<SegmentObstacleConstraints> obstacle_constraints(
+      const Solution& initial_guess) const {
+    // How far the bumpers reach from the robot's center in any heading
+    double reach = 0.0;
+    for (const auto& bumper : bumpers) {
+      for (const auto& point : bumper.points) {
+        reach = std::max(reach, point.norm());
+      }
+    }
+    const Translation2d inflation{reach + obstacle_margin,
+                                  reach + obstacle_margin};
+
+    std::vector<SegmentObstacleConstraints> constraints;
+    for (size_t sgmt_index = 0; sgmt_index < control_interval_counts.size();
+         ++sgmt_index) {
+      size_t start_index = get_index(control_interval_counts, sgmt_index);
+      size_t end_index = get_index(control_interval_counts, sgmt_index + 1);
+
+      // The corridor is covered by a box around each step of the initial guess
+      std::vector<bool> near(obstacles.size(), false);
+      for (size_t index = start_index;
+           index < std::max(end_index, start_index + 1); ++index) {
+        size_t next_index = std::min(index + 1, end_index);
+        Translation2d start{initial_guess.x.at(index),
+                            initial_guess.y.at(index)};
+        Translation2d end{initial_guess.x.at(next_index),
+                          initial_guess.y.at(next_index)};
+
+        Translation2d min{std::min(start.x(), end.x()),
+                          std::min(start.y(), end.y())};
+        Translation2d max{std::max(start.x(), end.x()),
+                          std::max(start.y(), end.y())};
+        for (size_t obstacle_index :
+             obstacles.query(min - inflation, max + inflation)) {
+          near.at(obstacle_index) = true;
+        }
+      }
+
+      auto& segment = constraints.emplace_back();
+      for (size_t obstacle_index = 0; obstacle_index < obstacles.size();
+           ++obstacle_index) {
+        auto& target = near.at(obstacle_index) ? segment.near : segment.far;
+        auto keep_out =
+            keep_out_constraints(obstacles.obstacles().at(obstacle_index));
+        target.insert(target.end(), keep_out.begin(), keep_out.end());
+      }
+    }
+
+    return constraints;
+  }
+
+  /// Apply the keep-out constraints of the obstacles near each segment's
+  /// initial guess to a path like segment constraints, so they constrain the
+  /// segment's samples and the waypoint it ends at.
+  ///
+  /// @param path the path to constrain, usually the generator's copy of this
+  ///     builder's path
+  /// @param initial_guess the initial guess the generator starts from
+  /// @return the keep-out constraints of each segment, see
+  ///     obstacle_constraints()
+  std::vector<SegmentObstacleConstraints> apply_obstacle_constraints(
+      Path<Drivetrain, Solution>& path, const Solution& initial_guess) const {
+    auto constraints = obstacle_constraints(initial_guess);
+    for (size_t sgmt_index = 0; sgmt_index < constraints.size();
+         ++sgmt_index) {
+      auto& end_waypoint = path.waypoints.at(sgmt_index + 1);
+      for (const auto& constraint : constraints.at(sgmt_index).near) {
+        end_waypoint.segment_constraints.push_back(constraint);
+        end_waypoint.waypoint_constraints.push_back(constraint);
+      }
+    }
+    return constraints;
+  }
+
+  /// Get the interior waypoints where the robot comes to a full stop at a fixed
+  /// pose.
+  ///
+  /// A waypoint is a full stop if it has a pose waypoint constraint and both
+  /// its linear and angular velocity are constrained to zero. Nothing about
+  /// the robot's state there depends on the rest of the path, so the path can
+  /// be split there into paths that are solved independently.
+  ///
+  /// @return the indices of the full-stop waypoints in ascending order
+  std::vector<size_t> full_stop_waypoints() const {
+    std::vector<size_t> indices;
+    for (size_t index = 1; index + 1 < path.waypoints.size(); ++index) {
+      bool fixed_pose = false;
+      bool stopped = false;
+      bool not_turning = false;
+      for (const auto& constraint :
+           path.waypoints.at(index).waypoint_constraints) {
+        if (std::holds_alternative<PoseEqualityConstraint>(constraint)) {
+          fixed_pose = true;
+        } else if (auto velocity =
+                       std::get_if<LinearVelocityMaxMagnitudeConstraint>(
+                           &constraint)) {
+          stopped = stopped || velocity->max_magnitude() == 0.0;
+        } else if (auto angular_velocity =
+                       std::get_if<AngularVelocityMaxMagnitudeConstraint>(
+                           &constraint)) {
+          not_turning = not_turning || angular_velocity->max_magnitude() == 0.0;
+        }
+      }
+      if (fixed_pose && stopped && not_turning) {
+        indices.push_back(index);
+      }
+    }
+    return indices;
+  }
+
+  /// Get the part of the path between two waypoints as its own path.
+  ///
+  /// The part keeps the waypoints, segments, initial guess points, and control
+  /// interval counts between the two waypoints, and the rest of the path's
+  /// settings (e.g., drivetrain, bumpers, obstacles, callbacks).
+  ///
+  /// @param from_index index of the part's first waypoint
+  /// @param to_index index of the part's last waypoint
+  /// @return the part's path builder
+  PathBuilder sub_path(size_t from_index, size_t to_index) const {
+    assert(from_index < to_index && to_index < path.waypoints.size());
+
+    PathBuilder builder = *this;
+    builder.path.waypoints.assign(path.waypoints.begin() + from_index,
+                                  path.waypoints.begin() + to_index + 1);
+    builder.initial_guess_points.assign(
+        initial_guess_points.begin() + from_index,
+        initial_guess_points.begin() + to_index + 1);
+    builder.control_interval_counts.assign(
+        control_interval_counts.begin() + from_index,
+        control_interval_counts.begin() + to_index);
+
+    // The first waypoint no longer ends a segment
+    builder.path.waypoints.front().segment_constraints.clear();
+    builder.initial_guess_points.front() = {
+        initial_guess_points.at(from_index).back()};
+
+    return builder;
+  }
+
+  /// Calculate a deterministic hash of everything that determines the path's
+  /// solution: the drivetrain, bumpers, obstacles, waypoint and segment
+  /// constraints, initial guess points, control interval counts, and solver
+  /// options. Callbacks aren't included.
+  ///
+  /// The hash is the same across processes and platforms, so it can key
+  /// solutions stored on disk.
+  ///
+  /// @return the content hash
+  uint64_t content_hash() const {
+    ContentHasher hasher;
+    path.drivetrain.hash(hasher);
+    hasher.add(path.waypoints.size());
+    for (const auto& waypoint : path.waypoints) {
+      hasher.add(waypoint.waypoint_constraints);
+      hasher.add(waypoint.segment_constraints);
+    }
+    hasher.add(bumpers);
+    hasher.add(obstacles.obstacles());
+    hasher.add(obstacle_margin);
+    hasher.add(initial_guess_points);
+    hasher.add(control_interval_counts);
+    hasher.add(transcription);
+    hasher.add(lazy_constraint_margin);
+    return hasher.value();
+  }
+
   /// Get the DifferentialPath being constructed
   ///
   /// @return the path
@@ -207,12 +574,84 @@ class TRAJOPT_DLLEXPORT PathBuilder {
   /// The list of bumpers.
   std::vector<KeepOutRegion> bumpers;
 
+  /// The obstacles applied to segments whose initial guess passes near them.
+  ObstacleSet obstacles;
+
+  /// How close the bumpers may come to an obstacle before it's applied (m).
+  double obstacle_margin = 0.5;
+
   /// The initial guess points.
   std::vector<std::vector<Pose2d>> initial_guess_points;
 
   /// The control interval counts.
   std::vector<size_t> control_interval_counts;
 
+  /// The transcription, or nothing to use the generator's default.
+  std::optional<Transcription> transcription;
+
+  /// The activation margin of lazily applied geometric constraints, or nothing
+  /// to apply every constraint up front.
+  std::optional<double> lazy_constraint_margin;
+
+  /// Whether the problem's values are parameters.
+  bool parametric = false;
+
+  /// Returns the constraints that keep the robot's bumpers out of a keep-out
+  /// region. Polygons are kept apart by a separating axis. For circles and
+  /// lines, each bumper corner is kept away from the region's edges, and each
+  /// bumper edge from the region's corners. Without bumpers, the robot's
+  /// center is kept out instead.
+  ///
+  /// @param obstacle The keep-out region.
+  std::vector<Constraint> keep_out_constraints(
+      const KeepOutRegion& obstacle) const {
+    // Two points make one edge, and a single point none
+    auto edge_count = [](const std::vector<Translation2d>& points) {
+      return points.size() < 3 ? points.size() - 1 : points.size();
+    };
+    auto next = [](const std::vector<Translation2d>& points, size_t i) {
+      return points.at((i + 1) % points.size());
+    };
+
+    std::vector<std::vector<Translation2d>> robot_shapes;
+    for (const auto& bumper : bumpers) {
+      robot_shapes.push_back(bumper.points);
+    }
+    if (robot_shapes.empty()) {
+      robot_shapes.push_back({{0.0, 0.0}});
+    }
+
+    const auto& points = obstacle.points;
+    const double distance = obstacle.safety_distance;
+
+    std::vector<Constraint> constraints;
+    for (const auto& shape : robot_shapes) {
+      if (points.size() >= 3) {
+        constraints.emplace_back(
+            PolygonKeepOutConstraint{shape, points, distance});
+        continue;
+      }
+
+      for (const auto& corner : shape) {
+        if (points.size() == 1) {
+          constraints.emplace_back(
+              PointPointMinConstraint{corner, points.front(), distance});
+        }
+        for (size_t i = 0; i < edge_count(points); ++i) {
+          constraints.emplace_back(PointLineConstraint{
+              corner, points.at(i), next(points, i), distance});
+        }
+      }
+      for (size_t i = 0; i < edge_count(shape); ++i) {
+        for (const auto& point : points) {
+          constraints.emplace_back(LinePointConstraint{
+              shape.at(i), next(shape, i), point, distance});
+        }
+      }
+    }
+    return constraints;
+  }
+
   /// Add new waypoints up to and including the given index.
   ///
   /// @param final_index The final index.
@@ -0,0 +1,111 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <expected>
+#include <utility>
+#include <vector>
+
+#include <sleipnir/autodiff/variable.hpp>
+#include <sleipnir/optimization/problem.hpp>
+#include <sleipnir/optimization/solver/exit_status.hpp>
+
+#include "trajopt/swerve_trajectory_generator.hpp"
+#include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/generation_stats.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// Generates swerve trajectories with a rigid-body model of the robot.
+///
+/// The problem has the same states, time steps, and path constraints as
+/// SwerveTrajectoryGenerator's, but no module forces. Instead, the chassis's
+/// net force and torque are bounded together by what the modules can provide
+/// in total, and each module's speed is bounded as usual. Without the module
+/// forces and their per-module limits, the problem is a fraction of the size
+/// and converges to the path's overall shape and timing in far fewer
+/// iterations.
+///
+/// The solution's module forces are distributed from its accelerations with
+/// distribute_module_forces(), so it can warm start a
+/// SwerveTrajectoryGenerator. It may ask more of a single module than that
+/// module can provide, which the full problem then corrects.
+///
+/// The dynamics are always transcribed with constant acceleration, and
+/// obstacles only constrain the problem where the initial guess comes near
+/// them.
+class TRAJOPT_DLLEXPORT PointMassTrajectoryGenerator {
+ public:
+  /// Construct a new rigid-body swerve trajectory optimization problem.
+  ///
+  /// @param path_builder The path builder.
+  /// @param handle An identifier for state callbacks.
+  explicit PointMassTrajectoryGenerator(SwervePathBuilder path_builder,
+                                        int64_t handle = 0);
+
+  /// Generates an optimal trajectory of the rigid-body model.
+  ///
+  /// @param diagnostics Enables diagnostic prints.
+  /// @param stats If not null, receives the timing and size statistics of
+  ///     the problem's construction and this solve.
+  /// @return Returns a holonomic trajectory with distributed module forces on
+  ///     success, or the solver's exit status on failure.
+  std::expected<SwerveSolution, slp::ExitStatus> generate(
+      bool diagnostics = false, GenerationStats* stats = nullptr);
+
+  /// Returns the token used to cancel this generator's solve.
+  ///
+  /// @return The cancellation token.
+  CancellationToken get_cancellation_token() const {
+    return cancellation_token;
+  }
+
+  /// Replaces the token used to cancel this generator's solve.
+  ///
+  /// @param token The new cancellation token.
+  void set_cancellation_token(CancellationToken token) {
+    cancellation_token = std::move(token);
+  }
+
+ private:
+  /// Swerve path
+  SwervePath path;
+
+  /// State Variables
+  std::vector<slp::Variable<double>> x;
+  std::vector<slp::Variable<double>> y;
+  std::vector<slp::Variable<double>> cosθ;
+  std::vector<slp::Variable<double>> sinθ;
+  std::vector<slp::Variable<double>> vx;
+  std::vector<slp::Variable<double>> vy;
+  std::vector<slp::Variable<double>> ω;
+  std::vector<slp::Variable<double>> ax;
+  std::vector<slp::Variable<double>> ay;
+  std::vector<slp::Variable<double>> α;
+
+  /// Time Variables
+  std::vector<slp::Variable<double>> dts;
+
+  /// Discretization Constants
+  std::vector<size_t> Ns;
+
+  slp::Problem<double> problem;
+
+  /// Cancellation token checked on every solver iteration
+  CancellationToken cancellation_token;
+
+  /// When the path's callbacks were last called
+  std::chrono::steady_clock::time_point last_callback_time;
+
+  /// Statistics of the problem's construction and the latest solve
+  GenerationStats generation_stats;
+
+  SwerveSolution construct_swerve_solution();
+};
+
+}  // namespace trajopt
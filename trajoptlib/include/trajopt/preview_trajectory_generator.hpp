@@ -0,0 +1,392 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "trajopt/differential_trajectory_generator.hpp"
+#include "trajopt/path/path_builder.hpp"
+#include "trajopt/swerve_trajectory_generator.hpp"
+#include "trajopt/util/distribute_module_forces.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+#include "trajopt/util/trajopt_util.hpp"
+
+namespace trajopt {
+
+/// Options for preview generation.
+struct TRAJOPT_DLLEXPORT PreviewOptions {
+  /// The number of geometric samples the velocity profile is computed on per
+  /// control interval of the result.
+  size_t oversampling = 4;
+};
+
+/// Generates a fast approximation of a trajectory for previews.
+///
+/// Instead of solving the path's optimization problem, the path's spline
+/// initial guess is kept as a fixed geometric path and retimed with a
+/// time-optimal path parameterization: the speed along the path at each
+/// sample is capped by the wheels' maximum speed, by the centripetal
+/// acceleration the wheels' force can provide, and by the path's linear
+/// velocity constraints, and a forward and a backward pass then limit the
+/// acceleration between samples to what the wheels' force has left after
+/// the centripetal acceleration. The robot starts and ends at rest.
+///
+/// The result has the path's control interval layout, with a constant time
+/// step per segment like the full generators, so it can be displayed in their
+/// place while they solve or passed to their warm_start(). It respects the
+/// wheel limits but not the path's geometric constraints.
+///
+/// @tparam Drivetrain The drivetrain type (e.g., swerve, differential).
+/// @tparam Solution The solution type (e.g., swerve, differential).
+template <typename Drivetrain, typename Solution>
+class TRAJOPT_DLLEXPORT PreviewTrajectoryGenerator {
+ public:
+  /// Constructs a PreviewTrajectoryGenerator.
+  ///
+  /// @param path_builder The path builder.
+  /// @param options The preview options.
+  explicit PreviewTrajectoryGenerator(
+      PathBuilder<Drivetrain, Solution> path_builder,
+      PreviewOptions options = {})
+      : m_path_builder{std::move(path_builder)}, m_options{options} {}
+
+  /// Generates a preview trajectory.
+  ///
+  /// @return The preview trajectory.
+  Solution generate() {
+    constexpr bool is_differential =
+        std::same_as<Solution, DifferentialSolution>;
+
+    const auto& drivetrain = m_path_builder.get_drivetrain();
+    const auto& path = m_path_builder.get_path();
+    const auto counts = m_path_builder.get_control_interval_counts();
+    const size_t oversampling = std::max<size_t>(m_options.oversampling, 1);
+
+    // Sample the geometric path finely
+    std::vector<size_t> fine_counts;
+    fine_counts.reserve(counts.size());
+    for (size_t count : counts) {
+      fine_counts.push_back(count * oversampling);
+    }
+    auto fine_builder = m_path_builder;
+    auto layout = fine_counts;
+    fine_builder.set_control_interval_counts(std::move(layout));
+    const auto fine = fine_builder.calculate_spline_initial_guess();
+    const size_t fine_tot = fine.x.size();
+
+    // Headings are unwrapped so consecutive samples turn the short way
+    std::vector<double> θ(fine_tot);
+    for (size_t i = 0; i < fine_tot; ++i) {
+      double heading;
+      if constexpr (is_differential) {
+        heading = fine.heading.at(i);
+      } else {
+        heading = std::atan2(fine.thetasin.at(i), fine.thetacos.at(i));
+      }
+      θ[i] = i == 0 ? heading : θ[i - 1] + angle_modulus(heading - θ[i - 1]);
+    }
+
+    // Wheel limits. Chassis acceleration is shared evenly between the wheels.
+    const size_t num_wheels = wheel_count(drivetrain);
+    const double v_wheel =
+        drivetrain.wheel_radius * drivetrain.wheel_max_angular_velocity;
+    const double F_max =
+        std::min(drivetrain.wheel_max_torque / drivetrain.wheel_radius,
+                 drivetrain.wheel_cof * drivetrain.mass * 9.8 / num_wheels);
+    const double a_max = F_max * num_wheels / drivetrain.mass;
+
+    // The path is parameterized by p, whose increments combine the distance
+    // driven and the distance the outermost wheel turns through
+    const double radius = wheel_radius_about_center(drivetrain);
+    std::vector<double> Δp(fine_tot, 0.0);
+    std::vector<Tangent> u(fine_tot);
+    std::vector<double> w(fine_tot, 0.0);
+    for (size_t i = 0; i + 1 < fine_tot; ++i) {
+      double dx = fine.x.at(i + 1) - fine.x.at(i);
+      double dy = fine.y.at(i + 1) - fine.y.at(i);
+      double dθ = θ[i + 1] - θ[i];
+      Δp[i] = std::hypot(dx, dy, radius * dθ);
+      if (Δp[i] > 0.0) {
+        u[i] = Tangent{dx / Δp[i], dy / Δp[i], dθ / Δp[i]};
+      }
+      w[i] = wheel_speed_ratio(drivetrain, u[i], θ[i]);
+    }
+
+    // Calls f with the index of each interval next to a sample
+    auto for_each_adjacent = [&](size_t i, auto&& f) {
+      if (i > 0) {
+        f(i - 1);
+      }
+      if (i + 1 < fine_tot) {
+        f(i);
+      }
+    };
+
+    // Speed caps at each sample from the adjacent intervals
+    std::vector<double> v_max(fine_tot,
+                              std::numeric_limits<double>::infinity());
+    std::vector<double> κ(fine_tot, 0.0);
+    for (size_t i = 0; i < fine_tot; ++i) {
+      for_each_adjacent(i, [&](size_t j) {
+        if (w[j] > 0.0) {
+          v_max[i] = std::min(v_max[i], v_wheel / w[j]);
+        }
+      });
+      if (i > 0 && i + 1 < fine_tot && Δp[i - 1] + Δp[i] > 0.0) {
+        κ[i] = std::hypot(u[i].x - u[i - 1].x, u[i].y - u[i - 1].y) /
+               ((Δp[i - 1] + Δp[i]) / 2);
+        if (κ[i] > 0.0) {
+          v_max[i] = std::min(v_max[i], std::sqrt(a_max / κ[i]));
+        }
+      }
+    }
+    v_max.front() = 0.0;
+    v_max.back() = 0.0;
+
+    // Linear velocity constraints cap the speed at their samples
+    auto cap = [&](size_t i, const Constraint& constraint) {
+      auto velocity =
+          std::get_if<LinearVelocityMaxMagnitudeConstraint>(&constraint);
+      if (velocity == nullptr) {
+        return;
+      }
+      for_each_adjacent(i, [&](size_t j) {
+        double ds_dp = std::hypot(u[j].x, u[j].y);
+        if (ds_dp > 0.0) {
+          v_max[i] = std::min(v_max[i], velocity->max_magnitude() / ds_dp);
+        }
+      });
+    };
+    for (size_t wpt_index = 0; wpt_index < path.waypoints.size();
+         ++wpt_index) {
+      const auto& waypoint = path.waypoints.at(wpt_index);
+      size_t wpt_sample = get_index(fine_counts, wpt_index);
+      for (const auto& constraint : waypoint.waypoint_constraints) {
+        cap(wpt_sample, constraint);
+      }
+      if (wpt_index == 0) {
+        continue;
+      }
+      for (size_t i = get_index(fine_counts, wpt_index - 1); i <= wpt_sample;
+           ++i) {
+        for (const auto& constraint : waypoint.segment_constraints) {
+          cap(i, constraint);
+        }
+      }
+    }
+
+    // Acceleration along p the wheels have left at a speed, after providing
+    // the centripetal acceleration
+    auto p_accel = [&](size_t interval, size_t sample, double v) {
+      double lateral = v * v * κ[sample];
+      double tangential =
+          std::sqrt(std::max(a_max * a_max - lateral * lateral, 0.0));
+      return w[interval] > 0.0 ? tangential / w[interval] : tangential;
+    };
+
+    // Forward and backward passes
+    std::vector<double> v = v_max;
+    v.front() = 0.0;
+    for (size_t i = 0; i + 1 < fine_tot; ++i) {
+      v[i + 1] = std::min(
+          v[i + 1], std::sqrt(v[i] * v[i] + 2 * p_accel(i, i, v[i]) * Δp[i]));
+    }
+    for (size_t i = fine_tot - 1; i > 0; --i) {
+      v[i - 1] = std::min(v[i - 1], std::sqrt(v[i] * v[i] +
+                                              2 * p_accel(i - 1, i, v[i]) *
+                                                  Δp[i - 1]));
+    }
+
+    // Time at each sample, with a constant acceleration along p between
+    // samples
+    std::vector<double> t(fine_tot, 0.0);
+    std::vector<double> p_ddot(fine_tot, 0.0);
+    for (size_t i = 0; i + 1 < fine_tot; ++i) {
+      double Δt = 0.0;
+      if (v[i] + v[i + 1] > 0.0) {
+        Δt = 2 * Δp[i] / (v[i] + v[i + 1]);
+        p_ddot[i] = (v[i + 1] * v[i + 1] - v[i] * v[i]) / (2 * Δp[i]);
+      } else if (Δp[i] > 0.0) {
+        // Speeding up and slowing down within the interval
+        Δt = 2 * std::sqrt(Δp[i] / p_accel(i, i, 0.0));
+      }
+      t[i + 1] = t[i] + Δt;
+    }
+
+    // Sample each segment at a constant time step
+    const size_t samp_tot = get_index(counts, counts.size()) + 1;
+    Solution solution;
+    solution.dt.assign(samp_tot, 0.0);
+    std::vector<double> xs(samp_tot, fine.x.front());
+    std::vector<double> ys(samp_tot, fine.y.front());
+    std::vector<double> θs(samp_tot, θ.front());
+    std::vector<Tangent> velocities(samp_tot);
+    std::vector<Tangent> accelerations(samp_tot);
+
+    for (size_t sgmt_index = 0; sgmt_index < counts.size(); ++sgmt_index) {
+      const size_t N_sgmt = counts.at(sgmt_index);
+      if (N_sgmt == 0) {
+        continue;
+      }
+      const size_t sgmt_start = get_index(counts, sgmt_index);
+      const size_t fine_start = get_index(fine_counts, sgmt_index);
+      const size_t fine_end = get_index(fine_counts, sgmt_index + 1);
+      const double dt = (t[fine_end] - t[fine_start]) / N_sgmt;
+
+      size_t i = fine_start;
+      for (size_t k = 0; k <= N_sgmt; ++k) {
+        const double τ = t[fine_start] + dt * k;
+        while (i + 1 < fine_end && t[i + 1] < τ) {
+          ++i;
+        }
+
+        // Distance along the interval after the time elapsed in it
+        const double σ = std::clamp(τ - t[i], 0.0, t[i + 1] - t[i]);
+        double fraction = 0.0;
+        double p_dot = v[i];
+        if (v[i] + v[i + 1] > 0.0) {
+          fraction = (v[i] * σ + 0.5 * p_ddot[i] * σ * σ) / Δp[i];
+          p_dot += p_ddot[i] * σ;
+        } else if (t[i + 1] > t[i]) {
+          fraction = σ / (t[i + 1] - t[i]);
+        }
+        fraction = std::clamp(fraction, 0.0, 1.0);
+
+        const size_t index = sgmt_start + k;
+        solution.dt[index] = dt;
+        xs[index] = std::lerp(fine.x.at(i), fine.x.at(i + 1), fraction);
+        ys[index] = std::lerp(fine.y.at(i), fine.y.at(i + 1), fraction);
+        θs[index] = std::lerp(θ[i], θ[i + 1], fraction);
+        velocities[index] = u[i] * p_dot;
+        accelerations[index] = u[i] * p_ddot[i];
+      }
+    }
+
+    solution.x = std::move(xs);
+    solution.y = std::move(ys);
+    fill_states(solution, drivetrain, θs, velocities, accelerations);
+    return solution;
+  }
+
+ private:
+  /// A direction of motion along the path, per unit of the path parameter.
+  struct Tangent {
+    double x = 0.0;
+    double y = 0.0;
+    double θ = 0.0;
+
+    Tangent operator*(double scalar) const {
+      return Tangent{x * scalar, y * scalar, θ * scalar};
+    }
+  };
+
+  PathBuilder<Drivetrain, Solution> m_path_builder;
+  PreviewOptions m_options;
+
+  /// Returns the number of wheels sharing the chassis's force.
+  static size_t wheel_count(const Drivetrain& drivetrain) {
+    if constexpr (std::same_as<Solution, DifferentialSolution>) {
+      return 2;
+    } else {
+      return drivetrain.modules.size();
+    }
+  }
+
+  /// Returns the distance of the farthest wheel from the robot's center.
+  static double wheel_radius_about_center(const Drivetrain& drivetrain) {
+    if constexpr (std::same_as<Solution, DifferentialSolution>) {
+      return drivetrain.trackwidth / 2;
+    } else {
+      double radius = 0.0;
+      for (const auto& module : drivetrain.modules) {
+        radius = std::max(radius, module.norm());
+      }
+      return radius;
+    }
+  }
+
+  /// Returns the fastest wheel's speed per unit speed along the path.
+  static double wheel_speed_ratio(const Drivetrain& drivetrain,
+                                  const Tangent& u, double θ) {
+    if constexpr (std::same_as<Solution, DifferentialSolution>) {
+      double forward = u.x * std::cos(θ) + u.y * std::sin(θ);
+      double r_b = drivetrain.trackwidth / 2;
+      return std::max(std::abs(forward - r_b * u.θ),
+                      std::abs(forward + r_b * u.θ));
+    } else {
+      double ratio = 0.0;
+      for (const auto& module : drivetrain.modules) {
+        auto r = module.rotate_by(Rotation2d{θ});
+        ratio =
+            std::max(ratio, std::hypot(u.x - u.θ * r.y(), u.y + u.θ * r.x()));
+      }
+      return ratio;
+    }
+  }
+
+  /// Fills a solution's headings, velocities, accelerations, and forces.
+  static void fill_states(Solution& solution, const Drivetrain& drivetrain,
+                          const std::vector<double>& θs,
+                          const std::vector<Tangent>& velocities,
+                          const std::vector<Tangent>& accelerations) {
+    const size_t samp_tot = θs.size();
+
+    if constexpr (std::same_as<Solution, DifferentialSolution>) {
+      const double m = drivetrain.mass;
+      const double J = drivetrain.moi;
+      const double r_b = drivetrain.trackwidth / 2;
+      solution.heading = θs;
+      for (size_t index = 0; index < samp_tot; ++index) {
+        const auto& vel = velocities[index];
+        const auto& acc = accelerations[index];
+        double cosθ = std::cos(θs[index]);
+        double sinθ = std::sin(θs[index]);
+        double v = vel.x * cosθ + vel.y * sinθ;
+        double a = acc.x * cosθ + acc.y * sinθ;
+
+        solution.vl.push_back(v - r_b * vel.θ);
+        solution.vr.push_back(v + r_b * vel.θ);
+        solution.angular_velocity.push_back(vel.θ);
+        solution.al.push_back(a - r_b * acc.θ);
+        solution.ar.push_back(a + r_b * acc.θ);
+        solution.angular_acceleration.push_back(acc.θ);
+
+        // ma = Fₗ + Fᵣ and Jα = r_b(Fᵣ − Fₗ)
+        solution.Fl.push_back((m * a - J * acc.θ / r_b) / 2);
+        solution.Fr.push_back((m * a + J * acc.θ / r_b) / 2);
+      }
+    } else {
+      for (size_t index = 0; index < samp_tot; ++index) {
+        const auto& vel = velocities[index];
+        const auto& acc = accelerations[index];
+        solution.thetacos.push_back(std::cos(θs[index]));
+        solution.thetasin.push_back(std::sin(θs[index]));
+        solution.vx.push_back(vel.x);
+        solution.vy.push_back(vel.y);
+        solution.omega.push_back(vel.θ);
+        solution.ax.push_back(acc.x);
+        solution.ay.push_back(acc.y);
+        solution.alpha.push_back(acc.θ);
+      }
+      distribute_module_forces(solution, drivetrain);
+    }
+  }
+};
+
+/// Generates swerve preview trajectories.
+using SwervePreviewTrajectoryGenerator =
+    PreviewTrajectoryGenerator<SwerveDrivetrain, SwerveSolution>;
+
+/// Generates differential preview trajectories.
+using DifferentialPreviewTrajectoryGenerator =
+    PreviewTrajectoryGenerator<DifferentialDrivetrain, DifferentialSolution>;
+
+}  // namespace trajopt
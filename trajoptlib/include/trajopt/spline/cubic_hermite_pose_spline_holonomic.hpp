@@ -2,7 +2,12 @@
 
 #pragma once
 
+#include <stddef.h>
+
 #include <array>
+#include <cmath>
+#include <optional>
+#include <span>
 #include <utility>
 
 #include "trajopt/geometry/pose2.hpp"
@@ -21,6 +26,9 @@ class TRAJOPT_DLLEXPORT CubicHermitePoseSplineHolonomic : CubicHermiteSpline {
   /// Pose2d with curvature.
   using PoseWithCurvature = std::pair<Pose2d, double>;
 
+  /// Poses and curvatures at many points, stored as columns.
+  using PosesWithCurvature = CubicHermiteSpline::PosesWithCurvature;
+
   /// Constructs a cubic pose spline.
   ///
   /// @param x_initial_control_vector The control vector for the initial point
@@ -85,6 +93,31 @@ class TRAJOPT_DLLEXPORT CubicHermitePoseSplineHolonomic : CubicHermiteSpline {
     }
   }
 
+  /// Gets the poses and curvatures at many points t on the spline.
+  ///
+  /// @param t The points t.
+  /// @param is_differential Whether the drivetrain is a differential drive.
+  /// @return The poses and curvatures at those points, or nothing if the
+  ///     spline's velocity vanishes at any of them.
+  std::optional<PosesWithCurvature> get_points(std::span<const double> t,
+                                               bool is_differential) const {
+    auto points = CubicHermiteSpline::get_points(t);
+    if (!points.has_value() || is_differential) {
+      return points;
+    }
+
+    // A holonomic drivetrain's heading follows its own spline instead of the
+    // course
+    for (size_t k = 0; k < t.size(); ++k) {
+      const double angle = theta.get_position(t[k]);
+      const double cos = std::cos(angle);
+      const double sin = std::sin(angle);
+      points->cos[k] = r0.cos() * cos - r0.sin() * sin;
+      points->sin[k] = r0.cos() * sin + r0.sin() * cos;
+    }
+    return points;
+  }
+
  private:
   Rotation2d r0;
   CubicHermiteSpline1d theta;
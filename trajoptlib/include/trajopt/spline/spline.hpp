@@ -2,9 +2,15 @@
 
 #pragma once
 
+#include <stddef.h>
+
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <optional>
+#include <span>
 #include <utility>
+#include <vector>
 
 #include <Eigen/Core>
 
@@ -37,6 +43,24 @@ class Spline {
     std::array<double, (Degree + 1) / 2> y;
   };
 
+  /// Poses and curvatures at many points on a spline, stored as columns.
+  struct PosesWithCurvature {
+    /// The x coordinates.
+    std::vector<double> x;
+
+    /// The y coordinates.
+    std::vector<double> y;
+
+    /// The headings' cosines.
+    std::vector<double> cos;
+
+    /// The headings' sines.
+    std::vector<double> sin;
+
+    /// The curvatures.
+    std::vector<double> curvature;
+  };
+
   /// Gets the pose and curvature at some point t on the spline.
   ///
   /// @param t The point t
@@ -85,6 +109,61 @@ class Spline {
         curvature};
   }
 
+  /// Gets the poses and curvatures at many points t on the spline.
+  ///
+  /// Each polynomial is evaluated with Horner's scheme one coefficient at a
+  /// time across every point, so the inner loops carry no dependency between
+  /// points and vectorize. The result matches get_point() at each point.
+  ///
+  /// @param t The points t.
+  /// @return The poses and curvatures at those points, or nothing if the
+  ///     spline's velocity vanishes at any of them.
+  std::optional<PosesWithCurvature> get_points(
+      std::span<const double> t) const {
+    const auto& c = coefficients();
+
+    // Evaluates a row of the coefficients as a polynomial of the given degree
+    auto horner = [&](int row, int degree, std::vector<double>& values) {
+      values.assign(t.size(), c(row, 0));
+      for (int i = 1; i <= degree; ++i) {
+        const double coefficient = c(row, i);
+        for (size_t k = 0; k < t.size(); ++k) {
+          values[k] = values[k] * t[k] + coefficient;
+        }
+      }
+    };
+
+    // Rows 2 and 3 hold t times the first derivative's coefficients, and rows
+    // 4 and 5 hold t² times the second derivative's, so dropping their
+    // trailing zero coefficients gives the derivatives themselves
+    PosesWithCurvature points;
+    std::vector<double> ddx;
+    std::vector<double> ddy;
+    horner(0, Degree, points.x);
+    horner(1, Degree, points.y);
+    horner(2, Degree - 1, points.cos);
+    horner(3, Degree - 1, points.sin);
+    horner(4, Degree - 2, ddx);
+    horner(5, Degree - 2, ddy);
+
+    points.curvature.resize(t.size());
+    for (size_t k = 0; k < t.size(); ++k) {
+      const double dx = points.cos[k];
+      const double dy = points.sin[k];
+      const double speed = std::sqrt(dx * dx + dy * dy);
+      if (speed < 1e-6) {
+        return std::nullopt;
+      }
+
+      points.cos[k] = dx / speed;
+      points.sin[k] = dy / speed;
+      points.curvature[k] =
+          (dx * ddy[k] - ddx[k] * dy) / (speed * speed * speed);
+    }
+
+    return points;
+  }
+
   /// Returns the coefficients of the spline.
   ///
   /// @return The coefficients of the spline.
@@ -2,7 +2,15 @@
 
 #pragma once
 
+#include <stddef.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <expected>
+#include <memory>
+#include <optional>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -12,7 +20,14 @@
 
 #include "trajopt/geometry/translation2.hpp"
 #include "trajopt/path/path_builder.hpp"
+#include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/chassis_limits.hpp"
+#include "trajopt/util/content_hash.hpp"
+#include "trajopt/util/generation_budget.hpp"
+#include "trajopt/util/generation_stats.hpp"
+#include "trajopt/util/progress_channel.hpp"
 #include "trajopt/util/symbol_exports.hpp"
+#include "trajopt/util/transcription.hpp"
 
 namespace trajopt {
 
@@ -40,6 +55,24 @@ struct TRAJOPT_DLLEXPORT SwerveDrivetrain {
   /// system to the center of the module (m). There's usually one in each
   /// corner.
   std::vector<Translation2d> modules;
+
+  /// Returns the chassis motion limits implied by the wheels.
+  ///
+  /// @return The chassis limits.
+  ChassisLimits chassis_limits() const;
+
+  /// Adds the drivetrain's values to a content hash.
+  ///
+  /// @param hasher The content hasher.
+  void hash(ContentHasher& hasher) const {
+    hasher.add(mass);
+    hasher.add(moi);
+    hasher.add(wheel_radius);
+    hasher.add(wheel_max_angular_velocity);
+    hasher.add(wheel_max_torque);
+    hasher.add(wheel_cof);
+    hasher.add(modules);
+  }
 };
 
 /// The swerve drive trajectory optimization solution.
@@ -177,6 +210,8 @@ class TRAJOPT_DLLEXPORT SwerveTrajectory {
   ///
   /// @param solution The swerve solution.
   explicit SwerveTrajectory(const SwerveSolution& solution) {
+    samples.reserve(solution.x.size());
+
     double ts = 0.0;
     for (size_t sample = 0; sample < solution.x.size(); ++sample) {
       samples.emplace_back(
@@ -190,6 +225,224 @@ class TRAJOPT_DLLEXPORT SwerveTrajectory {
   }
 };
 
+/// Swerve trajectory stored as columns in one contiguous buffer.
+///
+/// Each per-sample field is a column of the buffer, followed by each module's
+/// x forces and then each module's y forces, so the force matrix is
+/// module-major. Building one from a solution or copying it takes a single
+/// allocation however many samples it has, unlike SwerveTrajectory, whose
+/// samples each own two force vectors.
+class TRAJOPT_DLLEXPORT FlatSwerveTrajectory {
+ public:
+  /// A per-sample field.
+  enum class Field : size_t {
+    /// The timestamp.
+    TIMESTAMP,
+    /// The x coordinate.
+    X,
+    /// The y coordinate.
+    Y,
+    /// The heading.
+    HEADING,
+    /// The velocity's x component.
+    VELOCITY_X,
+    /// The velocity's y component.
+    VELOCITY_Y,
+    /// The angular velocity.
+    ANGULAR_VELOCITY,
+    /// The acceleration's x component.
+    ACCELERATION_X,
+    /// The acceleration's y component.
+    ACCELERATION_Y,
+    /// The angular acceleration.
+    ANGULAR_ACCELERATION,
+  };
+
+  /// The number of per-sample fields.
+  static constexpr size_t field_count = 10;
+
+  FlatSwerveTrajectory() = default;
+
+  /// Construct a zeroed FlatSwerveTrajectory.
+  ///
+  /// @param sample_count The number of samples.
+  /// @param module_count The number of modules.
+  FlatSwerveTrajectory(size_t sample_count, size_t module_count)
+      : m_sample_count{sample_count},
+        m_module_count{module_count},
+        m_buffer((field_count + 2 * module_count) * sample_count, 0.0) {}
+
+  /// Construct a FlatSwerveTrajectory from a swerve solution.
+  ///
+  /// @param solution The swerve solution.
+  explicit FlatSwerveTrajectory(const SwerveSolution& solution)
+      : FlatSwerveTrajectory{
+            solution.x.size(),
+            solution.module_fx.empty() ? 0 : solution.module_fx[0].size()} {
+    auto timestamp = column(Field::TIMESTAMP);
+    auto heading = column(Field::HEADING);
+    double ts = 0.0;
+    for (size_t sample = 0; sample < m_sample_count; ++sample) {
+      timestamp[sample] = ts;
+      heading[sample] =
+          std::atan2(solution.thetasin[sample], solution.thetacos[sample]);
+      ts += solution.dt[sample];
+    }
+
+    std::ranges::copy(solution.x, column(Field::X).begin());
+    std::ranges::copy(solution.y, column(Field::Y).begin());
+    std::ranges::copy(solution.vx, column(Field::VELOCITY_X).begin());
+    std::ranges::copy(solution.vy, column(Field::VELOCITY_Y).begin());
+    std::ranges::copy(solution.omega, column(Field::ANGULAR_VELOCITY).begin());
+    std::ranges::copy(solution.ax, column(Field::ACCELERATION_X).begin());
+    std::ranges::copy(solution.ay, column(Field::ACCELERATION_Y).begin());
+    std::ranges::copy(solution.alpha,
+                      column(Field::ANGULAR_ACCELERATION).begin());
+
+    for (size_t module = 0; module < m_module_count; ++module) {
+      auto fx = module_forces_x(module);
+      auto fy = module_forces_y(module);
+      for (size_t sample = 0; sample < m_sample_count; ++sample) {
+        fx[sample] = solution.module_fx[sample][module];
+        fy[sample] = solution.module_fy[sample][module];
+      }
+    }
+  }
+
+  /// Construct a FlatSwerveTrajectory from a swerve trajectory.
+  ///
+  /// @param trajectory The swerve trajectory. Every sample must have the same
+  ///     number of module forces.
+  explicit FlatSwerveTrajectory(const SwerveTrajectory& trajectory)
+      : FlatSwerveTrajectory{
+            trajectory.samples.size(),
+            trajectory.samples.empty()
+                ? 0
+                : trajectory.samples[0].module_forces_x.size()} {
+    for (size_t index = 0; index < m_sample_count; ++index) {
+      const auto& sample = trajectory.samples[index];
+      column(Field::TIMESTAMP)[index] = sample.timestamp;
+      column(Field::X)[index] = sample.x;
+      column(Field::Y)[index] = sample.y;
+      column(Field::HEADING)[index] = sample.heading;
+      column(Field::VELOCITY_X)[index] = sample.velocity_x;
+      column(Field::VELOCITY_Y)[index] = sample.velocity_y;
+      column(Field::ANGULAR_VELOCITY)[index] = sample.angular_velocity;
+      column(Field::ACCELERATION_X)[index] = sample.acceleration_x;
+      column(Field::ACCELERATION_Y)[index] = sample.acceleration_y;
+      column(Field::ANGULAR_ACCELERATION)[index] = sample.angular_acceleration;
+      for (size_t module = 0; module < m_module_count; ++module) {
+        module_forces_x(module)[index] = sample.module_forces_x[module];
+        module_forces_y(module)[index] = sample.module_forces_y[module];
+      }
+    }
+  }
+
+  /// Returns the number of samples.
+  size_t size() const { return m_sample_count; }
+
+  /// Returns the number of modules.
+  size_t module_count() const { return m_module_count; }
+
+  /// Returns a per-sample field's values.
+  ///
+  /// @param field The field.
+  std::span<double> column(Field field) {
+    return slice(static_cast<size_t>(field));
+  }
+
+  /// Returns a per-sample field's values.
+  ///
+  /// @param field The field.
+  std::span<const double> column(Field field) const {
+    return slice(static_cast<size_t>(field));
+  }
+
+  /// Returns a module's x forces at each sample.
+  ///
+  /// @param module The module index.
+  std::span<double> module_forces_x(size_t module) {
+    return slice(field_count + module);
+  }
+
+  /// Returns a module's x forces at each sample.
+  ///
+  /// @param module The module index.
+  std::span<const double> module_forces_x(size_t module) const {
+    return slice(field_count + module);
+  }
+
+  /// Returns a module's y forces at each sample.
+  ///
+  /// @param module The module index.
+  std::span<double> module_forces_y(size_t module) {
+    return slice(field_count + m_module_count + module);
+  }
+
+  /// Returns a module's y forces at each sample.
+  ///
+  /// @param module The module index.
+  std::span<const double> module_forces_y(size_t module) const {
+    return slice(field_count + m_module_count + module);
+  }
+
+  /// Returns the whole buffer: the fields in declaration order, then each
+  /// module's x forces, then each module's y forces, each a column of size()
+  /// values.
+  std::span<const double> data() const { return m_buffer; }
+
+  /// Returns a sample in the layout of SwerveTrajectory.
+  ///
+  /// @param index The sample index.
+  SwerveTrajectorySample sample(size_t index) const {
+    std::vector<double> fx(m_module_count);
+    std::vector<double> fy(m_module_count);
+    for (size_t module = 0; module < m_module_count; ++module) {
+      fx[module] = module_forces_x(module)[index];
+      fy[module] = module_forces_y(module)[index];
+    }
+
+    return SwerveTrajectorySample{
+        column(Field::TIMESTAMP)[index],
+        column(Field::X)[index],
+        column(Field::Y)[index],
+        column(Field::HEADING)[index],
+        column(Field::VELOCITY_X)[index],
+        column(Field::VELOCITY_Y)[index],
+        column(Field::ANGULAR_VELOCITY)[index],
+        column(Field::ACCELERATION_X)[index],
+        column(Field::ACCELERATION_Y)[index],
+        column(Field::ANGULAR_ACCELERATION)[index],
+        std::move(fx),
+        std::move(fy)};
+  }
+
+  /// Returns this trajectory in the layout of SwerveTrajectory.
+  SwerveTrajectory to_trajectory() const {
+    std::vector<SwerveTrajectorySample> samples;
+    samples.reserve(m_sample_count);
+    for (size_t index = 0; index < m_sample_count; ++index) {
+      samples.push_back(sample(index));
+    }
+    return SwerveTrajectory{std::move(samples)};
+  }
+
+ private:
+  size_t m_sample_count = 0;
+  size_t m_module_count = 0;
+  std::vector<double> m_buffer;
+
+  /// Returns the buffer's column at the given index.
+  std::span<double> slice(size_t index) {
+    return std::span{m_buffer}.subspan(index * m_sample_count, m_sample_count);
+  }
+
+  /// Returns the buffer's column at the given index.
+  std::span<const double> slice(size_t index) const {
+    return std::span{m_buffer}.subspan(index * m_sample_count, m_sample_count);
+  }
+};
+
 /// A swerve path.
 using SwervePath = Path<SwerveDrivetrain, SwerveSolution>;
 
@@ -214,10 +467,101 @@ class TRAJOPT_DLLEXPORT SwerveTrajectoryGenerator {
   /// This function may take a long time to complete.
   ///
   /// @param diagnostics Enables diagnostic prints.
+  /// @param stats If not null, receives the timing and size statistics of
+  ///     the problem's construction and this solve.
   /// @return Returns a holonomic trajectory on success, or the solver's exit
   ///     status on failure.
   std::expected<SwerveSolution, slp::ExitStatus> generate(
-      bool diagnostics = false);
+      bool diagnostics = false, GenerationStats* stats = nullptr);
+
+  /// Generates an optimal trajectory within a time and iteration budget.
+  ///
+  /// If the budget runs out, the solve is cancelled, or the solver fails, the
+  /// best iterate it reached is returned instead of nothing, so callers with
+  /// bounded latency always get a trajectory to work with.
+  ///
+  /// @param budget The time and iteration budget.
+  /// @param diagnostics Enables diagnostic prints.
+  /// @param stats If not null, receives the timing and size statistics of
+  ///     the problem's construction and this solve.
+  /// @return The solution or best iterate, the solver's exit status, and how
+  ///     far the returned trajectory is from feasible.
+  BudgetedGeneration<SwerveSolution> generate(const GenerationBudget& budget,
+                                              bool diagnostics = false,
+                                              GenerationStats* stats = nullptr);
+
+  /// Updates the problem in place to solve a different path.
+  ///
+  /// If the generator's path was made parametric with
+  /// SwervePathBuilder::set_parametric(), waypoint poses, nonzero velocity and
+  /// acceleration limits, and drivetrain constants are parameters of the
+  /// problem, so a path that differs from the current one only in those values
+  /// is solved without rebuilding the problem. The last solution is kept as the
+  /// initial guess.
+  ///
+  /// Paths with obstacles or lazily applied geometric constraints always need a
+  /// new generator, as does a problem whose last solve left constraints out or
+  /// that isn't parametric.
+  ///
+  /// This function must not be called while generate() is running.
+  ///
+  /// @param path_builder The new path.
+  /// @return True if the problem was updated, or false if the path's structure
+  ///     differs and a new generator must be constructed instead.
+  bool update(SwervePathBuilder path_builder);
+
+  /// Seeds the solver with a previous solution instead of the path's initial
+  /// guess.
+  ///
+  /// Every state, input, and time step of the solution is used, so a solution
+  /// of a slightly edited path re-converges in a few iterations. If the
+  /// solution was generated with different control interval counts, it's
+  /// resampled onto this generator's layout first.
+  ///
+  /// @param solution The previous solution.
+  /// @param control_interval_counts The control interval counts the previous
+  ///     solution was generated with.
+  /// @return True if the solver was seeded, or false if the solution's fields
+  ///     don't have one entry per sample of control_interval_counts and it
+  ///     was ignored.
+  bool warm_start(const SwerveSolution& solution,
+                  const std::vector<size_t>& control_interval_counts);
+
+  /// Opens a channel that streams the solver's intermediate solutions.
+  ///
+  /// The solver publishes to the channel at most ProgressOptions::rate times
+  /// per second and never waits for the consumer, which polls the channel from
+  /// its own thread. Opening a channel replaces any previously opened one.
+  ///
+  /// @param options The channel's options.
+  /// @return The channel.
+  std::shared_ptr<ProgressChannel<SwerveSolution>> open_progress_channel(
+      ProgressOptions options = {}) {
+    progress_channel =
+        std::make_shared<ProgressChannel<SwerveSolution>>(options);
+    return progress_channel;
+  }
+
+  /// Returns the token used to cancel this generator's solve.
+  ///
+  /// The returned token shares state with the generator, so calling
+  /// CancellationToken::cancel() on it from another thread stops this
+  /// generator's solve without affecting any other generator.
+  ///
+  /// @return The cancellation token.
+  CancellationToken get_cancellation_token() const {
+    return cancellation_token;
+  }
+
+  /// Replaces the token used to cancel this generator's solve.
+  ///
+  /// This lets several generators, or a generator and its caller, share one
+  /// token.
+  ///
+  /// @param token The new cancellation token.
+  void set_cancellation_token(CancellationToken token) {
+    cancellation_token = std::move(token);
+  }
 
  private:
   /// Swerve path
@@ -245,11 +589,74 @@ class TRAJOPT_DLLEXPORT SwerveTrajectoryGenerator {
   /// Discretization Constants
   std::vector<size_t> Ns;
 
+  /// How the dynamics are enforced between samples
+  Transcription transcription;
+
+  /// Geometric constraints left out of the problem
+  std::vector<LazyConstraint> inactive_constraints;
+
+  /// Parameters, in the order swerve_parameter_values() returns their values.
+  /// Empty unless the path is parametric.
+  std::vector<slp::Variable<double>> parameters;
+
   slp::Problem<double> problem;
 
+  /// Cancellation token checked on every solver iteration
+  CancellationToken cancellation_token;
+
+  /// Channel intermediate solutions are published to, if one is open
+  std::shared_ptr<ProgressChannel<SwerveSolution>> progress_channel;
+
+  /// When an intermediate solution was last published to the progress channel
+  std::chrono::steady_clock::time_point last_progress_time;
+
+  /// When the path's callbacks were last called
+  std::chrono::steady_clock::time_point last_callback_time;
+
+  /// Statistics of the problem's construction and the latest solve
+  GenerationStats generation_stats;
+
+  /// Budget of the running generate() call
+  GenerationBudget budget;
+
+  /// When the running generate() call started solving
+  std::chrono::steady_clock::time_point solve_start_time;
+
+  /// True if the running generate() call's budget ran out
+  bool budget_exhausted = false;
+
+  /// Best iterate of the running generate() call, if it returns one
+  std::optional<BestIterate<SwerveSolution>> best_iterate;
+
+  /// Storage the solver's iterates are copied into for best_iterate
+  SwerveSolution iterate;
+
+  /// Left-out geometric constraints that have since been applied
+  std::vector<LazyConstraint> activated_constraints;
+
   void apply_initial_guess(const SwerveSolution& solution);
 
+  /// Solves the problem, then re-solves it until no left-out geometric
+  /// constraint needs to be applied.
+  ///
+  /// @param diagnostics Enables diagnostic prints.
+  /// @param stats If not null, receives the generation statistics.
+  /// @return The last solve's exit status.
+  slp::ExitStatus solve(bool diagnostics, GenerationStats* stats);
+
+  /// Applies the left-out geometric constraints the current solution violates
+  /// or comes within the activation margin of.
+  ///
+  /// @return The number of constraints applied.
+  size_t activate_constraints();
+
+  /// Returns how far a solution is from satisfying the problem's constraints,
+  /// including the left-out ones. See solution_violation().
+  double violation(const SwerveSolution& solution) const;
+
   SwerveSolution construct_swerve_solution();
+
+  void fill_swerve_solution(SwerveSolution& solution, ProgressPayload payload);
 };
 
 }  // namespace trajopt
@@ -0,0 +1,105 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stdint.h>
+
+#include <expected>
+#include <utility>
+
+#include <sleipnir/optimization/solver/exit_status.hpp>
+
+#include "trajopt/point_mass_trajectory_generator.hpp"
+#include "trajopt/swerve_trajectory_generator.hpp"
+#include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/generation_stats.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// Generates a swerve trajectory in two stages.
+///
+/// The path is first solved with PointMassTrajectoryGenerator, whose problem
+/// has no module forces, so the early iterations that settle the path's shape
+/// and timing are cheap. Its solution, with module forces distributed from
+/// its accelerations, then warm starts a SwerveTrajectoryGenerator, which only
+/// has to correct the module forces and the limits the rigid-body model
+/// approximates.
+///
+/// If the first stage fails for any reason but cancellation, the second stage
+/// is solved from the path's own initial guess instead.
+class TRAJOPT_DLLEXPORT TwoStageTrajectoryGenerator {
+ public:
+  /// Constructs a TwoStageTrajectoryGenerator.
+  ///
+  /// @param path_builder The path builder.
+  /// @param handle An identifier for state callbacks.
+  explicit TwoStageTrajectoryGenerator(SwervePathBuilder path_builder,
+                                       int64_t handle = 0)
+      : m_path_builder{std::move(path_builder)}, m_handle{handle} {}
+
+  /// Generates an optimal trajectory.
+  ///
+  /// This function may take a long time to complete.
+  ///
+  /// @param diagnostics Enables diagnostic prints.
+  /// @param stats If not null, receives the timing and size statistics of the
+  ///     generation. Times, iterations, and sizes are summed over both
+  ///     stages.
+  /// @return Returns a holonomic trajectory on success, or the solver's exit
+  ///     status on failure.
+  std::expected<SwerveSolution, slp::ExitStatus> generate(
+      bool diagnostics = false, GenerationStats* stats = nullptr) {
+    GenerationStats total_stats;
+
+    PointMassTrajectoryGenerator first_stage{m_path_builder, m_handle};
+    first_stage.set_cancellation_token(m_cancellation_token);
+    GenerationStats first_stage_stats;
+    auto seed = first_stage.generate(diagnostics, &first_stage_stats);
+    total_stats += first_stage_stats;
+
+    if (!seed.has_value() &&
+        seed.error() == slp::ExitStatus::CALLBACK_REQUESTED_STOP) {
+      if (stats != nullptr) {
+        *stats = std::move(total_stats);
+      }
+      return seed;
+    }
+
+    SwerveTrajectoryGenerator second_stage{m_path_builder, m_handle};
+    second_stage.set_cancellation_token(m_cancellation_token);
+    if (seed.has_value()) {
+      second_stage.warm_start(seed.value(),
+                              m_path_builder.get_control_interval_counts());
+    }
+    GenerationStats second_stage_stats;
+    auto solution = second_stage.generate(diagnostics, &second_stage_stats);
+    total_stats += second_stage_stats;
+
+    if (stats != nullptr) {
+      *stats = std::move(total_stats);
+    }
+    return solution;
+  }
+
+  /// Returns the token used to cancel this generator's solves.
+  ///
+  /// @return The cancellation token.
+  CancellationToken get_cancellation_token() const {
+    return m_cancellation_token;
+  }
+
+  /// Replaces the token used to cancel this generator's solves.
+  ///
+  /// @param token The new cancellation token.
+  void set_cancellation_token(CancellationToken token) {
+    m_cancellation_token = std::move(token);
+  }
+
+ private:
+  SwervePathBuilder m_path_builder;
+  int64_t m_handle;
+  CancellationToken m_cancellation_token;
+};
+
+}  // namespace trajopt
@@ -3,11 +3,35 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 
 #include "trajopt/util/symbol_exports.hpp"
 
 namespace trajopt {
 
-TRAJOPT_DLLEXPORT std::atomic<int>& get_cancellation_flag();
+/// A handle used to request that a running solve stop early.
+///
+/// Copies of a token share the same underlying flag, so a copy can be handed to
+/// another thread and used to cancel the solve that owns the original.
+/// Cancelling one token has no effect on solves that own different tokens.
+class TRAJOPT_DLLEXPORT CancellationToken {
+ public:
+  /// Constructs a token that hasn't been cancelled.
+  CancellationToken();
+
+  /// Requests cancellation of every solve using this token.
+  void cancel() const;
+
+  /// Clears a previous cancellation request.
+  void reset() const;
+
+  /// Returns true if cancellation has been requested.
+  ///
+  /// @return True if cancellation has been requested.
+  bool is_cancelled() const;
+
+ private:
+  std::shared_ptr<std::atomic<bool>> m_flag;
+};
 
 }  // namespace trajopt
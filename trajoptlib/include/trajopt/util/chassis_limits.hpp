@@ -0,0 +1,30 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// The limits of a drivetrain's chassis motion, used to estimate how long a
+/// path takes before it's solved.
+struct TRAJOPT_DLLEXPORT ChassisLimits {
+  /// Maximum linear velocity (m/s).
+  double max_velocity;
+
+  /// Maximum linear acceleration (m/s²).
+  double max_acceleration;
+
+  /// Maximum angular velocity (rad/s).
+  double max_angular_velocity;
+
+  /// Maximum angular acceleration (rad/s²).
+  double max_angular_acceleration;
+
+  /// Smallest distance between adjacent wheels (m). Samples spaced at most this
+  /// far apart at maximum velocity keep the robot from tunneling through
+  /// obstacles between them.
+  double min_wheel_spacing;
+};
+
+}  // namespace trajopt
@@ -0,0 +1,77 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "trajopt/constraint/constraint.hpp"
+#include "trajopt/path/path.hpp"
+
+namespace trajopt {
+
+/// Removes constraints that a generator would apply to the same sample more
+/// than once.
+///
+/// A segment's constraints apply to every sample from the waypoint that starts
+/// the segment up to, but not including, the waypoint that ends it. Since
+/// PathBuilder::sgmt_constraint() also adds the constraint to each of those
+/// waypoints, waypoints inside a constrained range would otherwise carry two
+/// copies of it. The first copy of each constraint at a sample is kept, so
+/// parameters are still created in the same relative order.
+///
+/// @tparam Drivetrain The drivetrain type (e.g., swerve, differential).
+/// @tparam Solution The solution type (e.g., swerve, differential).
+/// @param path The path to compact.
+/// @param control_interval_counts The path's control interval counts.
+/// @return The number of constraint applications removed, where each
+///     application constrains one sample.
+template <typename Drivetrain, typename Solution>
+size_t compact_constraints(
+    Path<Drivetrain, Solution>& path,
+    const std::vector<size_t>& control_interval_counts) {
+  // Removes each constraint equal to one before it, or to one in kept
+  auto remove_duplicates = [](std::vector<Constraint>& constraints,
+                              const std::vector<Constraint>& kept) {
+    std::vector<Constraint> unique;
+    unique.reserve(constraints.size());
+    for (auto& constraint : constraints) {
+      if (std::ranges::find(unique, constraint) == unique.end() &&
+          std::ranges::find(kept, constraint) == kept.end()) {
+        unique.push_back(std::move(constraint));
+      }
+    }
+
+    size_t removed = constraints.size() - unique.size();
+    constraints = std::move(unique);
+    return removed;
+  };
+
+  size_t removed = 0;
+  const std::vector<Constraint> none;
+
+  // The first waypoint's segment constraints aren't applied
+  for (size_t wpt_index = 1; wpt_index < path.waypoints.size(); ++wpt_index) {
+    removed += control_interval_counts.at(wpt_index - 1) *
+               remove_duplicates(
+                   path.waypoints.at(wpt_index).segment_constraints, none);
+  }
+
+  for (size_t wpt_index = 0; wpt_index < path.waypoints.size(); ++wpt_index) {
+    // A waypoint's sample starts the next segment unless that segment has no
+    // control intervals
+    bool starts_segment = wpt_index + 1 < path.waypoints.size() &&
+                          control_interval_counts.at(wpt_index) > 0;
+    removed += remove_duplicates(
+        path.waypoints.at(wpt_index).waypoint_constraints,
+        starts_segment ? path.waypoints.at(wpt_index + 1).segment_constraints
+                       : none);
+  }
+
+  return removed;
+}
+
+}  // namespace trajopt
@@ -0,0 +1,126 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stdint.h>
+
+#include <bit>
+#include <concepts>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "trajopt/geometry/pose2.hpp"
+#include "trajopt/geometry/rotation2.hpp"
+#include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// Builds a deterministic 64-bit hash of a sequence of values.
+///
+/// Values are fed to 64-bit FNV-1a a byte at a time in little-endian order,
+/// so the hash is the same on every platform and in every process. Doubles
+/// are hashed by their bit pattern, and containers by their size followed by
+/// their elements, so different layouts of the same values hash differently.
+class TRAJOPT_DLLEXPORT ContentHasher {
+ public:
+  /// Adds an integer, bool, or enum.
+  ///
+  /// @param value The value.
+  template <typename T>
+    requires std::integral<T> || std::is_enum_v<T>
+  void add(T value) {
+    uint64_t bits;
+    if constexpr (std::is_enum_v<T>) {
+      bits = static_cast<uint64_t>(std::to_underlying(value));
+    } else {
+      bits = static_cast<uint64_t>(value);
+    }
+    for (int byte = 0; byte < 8; ++byte) {
+      m_hash ^= (bits >> (8 * byte)) & 0xff;
+      m_hash *= 0x100000001b3;
+    }
+  }
+
+  /// Adds a double.
+  ///
+  /// @param value The value.
+  void add(double value) { add(std::bit_cast<uint64_t>(value)); }
+
+  /// Adds a translation.
+  ///
+  /// @param translation The translation.
+  void add(const Translation2d& translation) {
+    add(translation.x());
+    add(translation.y());
+  }
+
+  /// Adds a rotation.
+  ///
+  /// @param rotation The rotation.
+  void add(const Rotation2d& rotation) {
+    add(rotation.cos());
+    add(rotation.sin());
+  }
+
+  /// Adds a pose.
+  ///
+  /// @param pose The pose.
+  void add(const Pose2d& pose) {
+    add(pose.translation());
+    add(pose.rotation());
+  }
+
+  /// Adds an object that hashes its own contents.
+  ///
+  /// @param value The object.
+  template <typename T>
+    requires requires(const T& t, ContentHasher& hasher) { t.hash(hasher); }
+  void add(const T& value) {
+    value.hash(*this);
+  }
+
+  /// Adds an optional value.
+  ///
+  /// @param value The optional value.
+  template <typename T>
+  void add(const std::optional<T>& value) {
+    add(value.has_value());
+    if (value.has_value()) {
+      add(value.value());
+    }
+  }
+
+  /// Adds a variant's alternative and value.
+  ///
+  /// @param value The variant.
+  template <typename... Ts>
+  void add(const std::variant<Ts...>& value) {
+    add(value.index());
+    std::visit([this](const auto& alternative) { add(alternative); }, value);
+  }
+
+  /// Adds a vector's elements.
+  ///
+  /// @param values The vector.
+  template <typename T>
+  void add(const std::vector<T>& values) {
+    add(values.size());
+    for (const auto& value : values) {
+      add(value);
+    }
+  }
+
+  /// Returns the hash of the values added so far.
+  ///
+  /// @return The hash.
+  uint64_t value() const { return m_hash; }
+
+ private:
+  uint64_t m_hash = 0xcbf29ce484222325;
+};
+
+}  // namespace trajopt
@@ -0,0 +1,53 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "trajopt/geometry/rotation2.hpp"
+
+namespace trajopt {
+
+/// Fills a swerve solution's module forces from its accelerations.
+///
+/// The net force m·a is split evenly between the modules, and the torque J·α
+/// comes from the smallest module forces that produce it, which are
+/// perpendicular to each module's position. The forces are the minimum-norm
+/// ones that satisfy the solution's dynamics.
+///
+/// @tparam Drivetrain The swerve drivetrain type.
+/// @tparam Solution The swerve solution type.
+/// @param solution The solution. Its module forces are replaced.
+/// @param drivetrain The drivetrain.
+template <typename Drivetrain, typename Solution>
+void distribute_module_forces(Solution& solution,
+                              const Drivetrain& drivetrain) {
+  const size_t samp_tot = solution.x.size();
+  const size_t module_cnt = drivetrain.modules.size();
+  const double m = drivetrain.mass;
+  const double J = drivetrain.moi;
+
+  double r_sq_sum = 0.0;
+  for (const auto& module : drivetrain.modules) {
+    r_sq_sum += module.squared_norm();
+  }
+
+  solution.module_fx.assign(samp_tot, std::vector<double>(module_cnt));
+  solution.module_fy.assign(samp_tot, std::vector<double>(module_cnt));
+  for (size_t index = 0; index < samp_tot; ++index) {
+    Rotation2d θ{solution.thetacos.at(index), solution.thetasin.at(index)};
+    double torque_scale =
+        r_sq_sum > 0.0 ? J * solution.alpha.at(index) / r_sq_sum : 0.0;
+    for (size_t module_index = 0; module_index < module_cnt; ++module_index) {
+      auto r = drivetrain.modules.at(module_index).rotate_by(θ);
+      solution.module_fx[index][module_index] =
+          m * solution.ax.at(index) / module_cnt - torque_scale * r.y();
+      solution.module_fy[index][module_index] =
+          m * solution.ay.at(index) / module_cnt + torque_scale * r.x();
+    }
+  }
+}
+
+}  // namespace trajopt
@@ -0,0 +1,74 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+
+#include "trajopt/geometry/rotation2.hpp"
+#include "trajopt/geometry/translation2.hpp"
+
+namespace trajopt {
+
+/// The accelerations a swerve drivetrain's module forces produce.
+struct SwerveAccelerations {
+  /// The linear acceleration in the field frame (m/s²).
+  Translation2d linear;
+
+  /// The angular acceleration (rad/s²).
+  double angular;
+};
+
+/// Returns the accelerations a swerve drivetrain's module forces produce at a
+/// heading, with the same dynamics as SwerveTrajectoryGenerator's problem:
+///
+///   a = ΣF / m
+///   α = Σ(r × F) / J
+///
+/// where r is each module's position turned to the heading.
+///
+/// @tparam Drivetrain The swerve drivetrain type.
+/// @tparam Force The type of the module force function.
+/// @param drivetrain The drivetrain.
+/// @param heading The heading the module positions are turned to.
+/// @param force Returns the force on a module (N) from its index.
+/// @return The accelerations.
+template <typename Drivetrain, typename Force>
+SwerveAccelerations swerve_accelerations(const Drivetrain& drivetrain,
+                                         const Rotation2d& heading,
+                                         Force&& force) {
+  Translation2d F_net;
+  double τ_net = 0.0;
+  for (size_t module_index = 0; module_index < drivetrain.modules.size();
+       ++module_index) {
+    Translation2d F = force(module_index);
+    F_net = F_net + F;
+    τ_net += drivetrain.modules[module_index].rotate_by(heading).cross(F);
+  }
+  return SwerveAccelerations{F_net / drivetrain.mass, τ_net / drivetrain.moi};
+}
+
+/// Returns the wheel accelerations (m/s²) a differential drivetrain's wheel
+/// forces produce, with the same dynamics as DifferentialTrajectoryGenerator's
+/// problem:
+///
+///   dvₗ/dt = (1/m + r_b²/J) Fₗ + (1/m - r_b²/J) Fᵣ
+///   dvᵣ/dt = (1/m - r_b²/J) Fₗ + (1/m + r_b²/J) Fᵣ
+///
+/// @tparam Drivetrain The differential drivetrain type.
+/// @param drivetrain The drivetrain.
+/// @param Fl The left wheel's force (N).
+/// @param Fr The right wheel's force (N).
+/// @return The left and right wheel accelerations.
+template <typename Drivetrain>
+std::array<double, 2> differential_wheel_accelerations(
+    const Drivetrain& drivetrain, double Fl, double Fr) {
+  const double m = drivetrain.mass;
+  const double J = drivetrain.moi;
+  const double r_b = drivetrain.trackwidth / 2;
+  return {(1.0 / m + r_b * r_b / J) * Fl + (1.0 / m - r_b * r_b / J) * Fr,
+          (1.0 / m - r_b * r_b / J) * Fl + (1.0 / m + r_b * r_b / J) * Fr};
+}
+
+}  // namespace trajopt
@@ -0,0 +1,316 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <numbers>
+#include <vector>
+
+#include "trajopt/geometry/rotation2.hpp"
+#include "trajopt/geometry/translation2.hpp"
+#include "trajopt/util/drivetrain_dynamics.hpp"
+#include "trajopt/util/trajopt_util.hpp"
+#include "trajopt/util/transcription.hpp"
+
+namespace trajopt {
+
+struct DifferentialSolution;
+
+namespace detail {
+
+/// Returns the wrapped difference between two headings (rad).
+inline double heading_difference(double θ_1, double θ_2) {
+  return std::remainder(θ_1 - θ_2, 2.0 * std::numbers::pi);
+}
+
+/// Returns the swerve solution's interval defect under the given
+/// transcription. See dynamics_defects().
+template <typename Drivetrain, typename Solution>
+double swerve_defect(const Drivetrain& drivetrain, const Solution& solution,
+                     Transcription transcription, size_t k,
+                     double module_radius) {
+  const double dt = solution.dt[k];
+  const double dt_sq = dt * dt;
+
+  const double θ_k = std::atan2(solution.thetasin[k], solution.thetacos[k]);
+  const double θ_k_1 =
+      std::atan2(solution.thetasin[k + 1], solution.thetacos[k + 1]);
+  const double ω_k = solution.omega[k];
+  const double ω_k_1 = solution.omega[k + 1];
+  const double α_k = solution.alpha[k];
+  const double α_k_1 = solution.alpha[k + 1];
+
+  // The forces are only needed by the transcriptions that evaluate the
+  // torque between samples
+  auto force = [&](size_t index, size_t module_index) {
+    if (index >= solution.module_fx.size() ||
+        module_index >= solution.module_fx[index].size()) {
+      return Translation2d{};
+    }
+    return Translation2d{solution.module_fx[index][module_index],
+                         solution.module_fy[index][module_index]};
+  };
+  auto F_c = [&](size_t module_index) {
+    return (force(k, module_index) + force(k + 1, module_index)) * 0.5;
+  };
+  auto F_k_1 = [&](size_t module_index) { return force(k + 1, module_index); };
+  auto angular_acceleration = [&](double θ, auto&& F) {
+    return swerve_accelerations(drivetrain, Rotation2d{θ}, F).angular;
+  };
+
+  // The difference between each axis's predicted and actual position and
+  // velocity at the interval's end
+  struct Residual {
+    double Δp;
+    double Δv;
+  };
+
+  auto linear = [&](double p_k, double p_k_1, double v_k, double v_k_1,
+                    double a_k, double a_k_1) {
+    switch (transcription) {
+      case Transcription::HERMITE_SIMPSON:
+        return Residual{p_k + (v_k + v_k_1) * 0.5 * dt +
+                            (a_k - a_k_1) / 12 * dt_sq - p_k_1,
+                        v_k + (a_k + a_k_1) * 0.5 * dt - v_k_1};
+      case Transcription::RUNGE_KUTTA_4:
+        return Residual{
+            p_k + v_k * dt + (2 * a_k + a_k_1) / 6 * dt_sq - p_k_1,
+            v_k + (a_k + a_k_1) * 0.5 * dt - v_k_1};
+      case Transcription::CONSTANT_ACCELERATION:
+      default:
+        return Residual{p_k + v_k * dt + 0.5 * a_k * dt_sq - p_k_1,
+                        v_k + a_k * dt - v_k_1};
+    }
+  };
+
+  auto x = linear(solution.x[k], solution.x[k + 1], solution.vx[k],
+                  solution.vx[k + 1], solution.ax[k], solution.ax[k + 1]);
+  auto y = linear(solution.y[k], solution.y[k + 1], solution.vy[k],
+                  solution.vy[k + 1], solution.ay[k], solution.ay[k + 1]);
+
+  double θ_pred;
+  double ω_pred;
+  switch (transcription) {
+    case Transcription::HERMITE_SIMPSON: {
+      double θ_c =
+          θ_k + (3 * ω_k + ω_k_1) / 8 * dt + (α_k - α_k_1) / 24 * dt_sq;
+      double α_c = angular_acceleration(θ_c, F_c);
+      θ_pred = θ_k + (ω_k + ω_k_1) * 0.5 * dt + (α_k - α_k_1) / 12 * dt_sq;
+      ω_pred = ω_k + (α_k + 4 * α_c + α_k_1) / 6 * dt;
+      break;
+    }
+    case Transcription::RUNGE_KUTTA_4: {
+      double ω_2 = ω_k + α_k * 0.5 * dt;
+      double α_2 = angular_acceleration(θ_k + ω_k * 0.5 * dt, F_c);
+      double ω_3 = ω_k + α_2 * 0.5 * dt;
+      double α_3 = angular_acceleration(θ_k + ω_2 * 0.5 * dt, F_c);
+      double ω_4 = ω_k + α_3 * dt;
+      double α_4 = angular_acceleration(θ_k + ω_3 * dt, F_k_1);
+      θ_pred = θ_k + (ω_k + 2 * ω_2 + 2 * ω_3 + ω_4) / 6 * dt;
+      ω_pred = ω_k + (α_k + 2 * α_2 + 2 * α_3 + α_4) / 6 * dt;
+      break;
+    }
+    case Transcription::CONSTANT_ACCELERATION:
+    default:
+      θ_pred = θ_k + ω_k * dt + 0.5 * α_k * dt_sq;
+      ω_pred = ω_k + α_k * dt;
+      break;
+  }
+
+  double position_defect =
+      std::hypot(x.Δp, y.Δp) +
+      module_radius * std::abs(heading_difference(θ_k_1, θ_pred));
+  double velocity_defect =
+      std::hypot(x.Δv, y.Δv) + module_radius * std::abs(ω_k_1 - ω_pred);
+  return position_defect + velocity_defect * dt;
+}
+
+/// Returns the differential solution's interval defect under the given
+/// transcription. See dynamics_defects().
+template <typename Drivetrain, typename Solution>
+double differential_defect(const Drivetrain& drivetrain,
+                           const Solution& solution,
+                           Transcription transcription, size_t k) {
+  using State = std::array<double, 5>;
+  using Input = std::array<double, 2>;
+
+  const double trackwidth = drivetrain.trackwidth;
+  const double r_b = trackwidth / 2;
+
+  // The same dynamics as DifferentialTrajectoryGenerator's, with the state
+  // (x, y, θ, vₗ, vᵣ) and the input (Fₗ, Fᵣ)
+  auto f = [&](const State& s, const Input& u) {
+    double v = (s[3] + s[4]) / 2.0;
+    auto [al, ar] = differential_wheel_accelerations(drivetrain, u[0], u[1]);
+    return State{v * std::cos(s[2]), v * std::sin(s[2]),
+                 (s[4] - s[3]) / trackwidth, al, ar};
+  };
+  auto axpy = [](const State& s, double a, const State& ds) {
+    State result;
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = s[i] + a * ds[i];
+    }
+    return result;
+  };
+
+  const double dt = solution.dt[k];
+  const State s_k{solution.x[k], solution.y[k], solution.heading[k],
+                  solution.vl[k], solution.vr[k]};
+  const State s_k_1{solution.x[k + 1], solution.y[k + 1],
+                    solution.heading[k + 1], solution.vl[k + 1],
+                    solution.vr[k + 1]};
+  const Input u_k{solution.Fl[k], solution.Fr[k]};
+  const Input u_k_1{solution.Fl[k + 1], solution.Fr[k + 1]};
+  const Input u_c{0.5 * (u_k[0] + u_k_1[0]), 0.5 * (u_k[1] + u_k_1[1])};
+  const State xdot_k = f(s_k, u_k);
+
+  // The difference between the interval's end state and the one the
+  // transcription predicts from its start
+  State Δ;
+  switch (transcription) {
+    case Transcription::HERMITE_SIMPSON: {
+      // The collocation residual is a rate, so it's scaled to a state
+      // difference by the time step. A zero time step has no collocation
+      // point, which leaves only the continuity of the state.
+      if (dt <= 0.0) {
+        Δ = axpy(s_k_1, -1.0, s_k);
+        break;
+      }
+      const State xdot_k_1 = f(s_k_1, u_k_1);
+      State s_c;
+      State xdot_c;
+      for (size_t i = 0; i < s_c.size(); ++i) {
+        s_c[i] = 0.5 * (s_k[i] + s_k_1[i]) + dt / 8 * (xdot_k[i] - xdot_k_1[i]);
+        xdot_c[i] = -3 / (2 * dt) * (s_k[i] - s_k_1[i]) -
+                    0.25 * (xdot_k[i] + xdot_k_1[i]);
+      }
+      Δ = axpy(State{}, dt, axpy(xdot_c, -1.0, f(s_c, u_c)));
+      break;
+    }
+    case Transcription::RUNGE_KUTTA_4: {
+      const State& k1 = xdot_k;
+      const State k2 = f(axpy(s_k, dt / 2, k1), u_c);
+      const State k3 = f(axpy(s_k, dt / 2, k2), u_c);
+      const State k4 = f(axpy(s_k, dt, k3), u_k_1);
+      State s_pred;
+      for (size_t i = 0; i < s_pred.size(); ++i) {
+        s_pred[i] = s_k[i] + dt / 6 * (k1[i] + 2 * k2[i] + 2 * k3[i] + k4[i]);
+      }
+      Δ = axpy(s_k_1, -1.0, s_pred);
+      break;
+    }
+    case Transcription::CONSTANT_ACCELERATION:
+    default: {
+      double v = (s_k[3] + s_k[4]) / 2.0;
+      double ω = xdot_k[2];
+      double a = (xdot_k[3] + xdot_k[4]) / 2.0;
+      double α = (xdot_k[4] - xdot_k[3]) / trackwidth;
+      double cosθ = std::cos(s_k[2]);
+      double sinθ = std::sin(s_k[2]);
+      State xddot_k{a * cosθ - v * ω * sinθ, a * sinθ + v * ω * cosθ, α, 0.0,
+                    0.0};
+      Δ = axpy(axpy(s_k_1, -1.0, axpy(s_k, dt, xdot_k)), -0.5 * dt * dt,
+               xddot_k);
+      break;
+    }
+  }
+
+  double position_defect = std::hypot(Δ[0], Δ[1]) + r_b * std::abs(Δ[2]);
+  double velocity_defect = std::hypot(Δ[3], Δ[4]);
+  return position_defect + velocity_defect * dt;
+}
+
+}  // namespace detail
+
+/// Returns the dynamics defect of each control interval of a solution.
+///
+/// An interval's defect is how far its end state is from the one the given
+/// transcription predicts from its start, with the same dynamics and module
+/// or wheel forces as the generator's problem:
+///
+///   ‖Δp‖ + r|Δθ| + (‖Δv‖ + r|Δω|)Δt
+///
+/// where r is the distance from the robot's center to its farthest module
+/// (half the trackwidth for a differential drivetrain, whose wheel velocities
+/// make up Δv), so heading errors count as the distance a wheel moves. For
+/// Hermite–Simpson, Δ is the collocation residual times the time step.
+///
+/// A solution of the problem it was generated for has defects near zero when
+/// the same transcription is given. A solution resampled onto a finer grid
+/// has large defects where the coarse grid was too coarse to capture the
+/// motion.
+///
+/// @tparam Drivetrain The drivetrain type (e.g., swerve, differential).
+/// @tparam Solution The solution type (e.g., swerve, differential).
+/// @param drivetrain The drivetrain the solution was generated for.
+/// @param solution The solution.
+/// @param transcription The transcription the solution was generated with.
+/// @return The defect of each control interval (m).
+template <typename Drivetrain, typename Solution>
+inline std::vector<double> dynamics_defects(const Drivetrain& drivetrain,
+                                            const Solution& solution,
+                                            Transcription transcription) {
+  double module_radius = 0.0;
+  if constexpr (!std::same_as<Solution, DifferentialSolution>) {
+    for (const auto& module : drivetrain.modules) {
+      module_radius = std::max(module_radius, module.norm());
+    }
+  }
+
+  size_t sample_cnt = solution.x.size();
+  std::vector<double> defects;
+  defects.reserve(sample_cnt > 0 ? sample_cnt - 1 : 0);
+  for (size_t k = 0; k + 1 < sample_cnt; ++k) {
+    if constexpr (std::same_as<Solution, DifferentialSolution>) {
+      defects.push_back(
+          detail::differential_defect(drivetrain, solution, transcription, k));
+    } else {
+      defects.push_back(detail::swerve_defect(drivetrain, solution,
+                                              transcription, k, module_radius));
+    }
+  }
+
+  return defects;
+}
+
+/// Returns the largest dynamics defect of each segment of a solution.
+///
+/// @tparam Drivetrain The drivetrain type (e.g., swerve, differential).
+/// @tparam Solution The solution type (e.g., swerve, differential).
+/// @param drivetrain The drivetrain the solution was generated for.
+/// @param solution The solution.
+/// @param control_interval_counts The control interval counts the solution was
+///     generated with.
+/// @param transcription The transcription the solution was generated with.
+/// @return The largest defect of each segment's control intervals (m).
+template <typename Drivetrain, typename Solution>
+inline std::vector<double> segment_dynamics_defects(
+    const Drivetrain& drivetrain, const Solution& solution,
+    const std::vector<size_t>& control_interval_counts,
+    Transcription transcription) {
+  auto defects = dynamics_defects(drivetrain, solution, transcription);
+
+  std::vector<double> segment_defects;
+  segment_defects.reserve(control_interval_counts.size());
+  for (size_t sgmt_index = 0; sgmt_index < control_interval_counts.size();
+       ++sgmt_index) {
+    size_t start = get_index(control_interval_counts, sgmt_index);
+    size_t end = std::min(get_index(control_interval_counts, sgmt_index + 1),
+                          defects.size());
+
+    double segment_defect = 0.0;
+    for (size_t index = start; index < end; ++index) {
+      segment_defect = std::max(segment_defect, defects[index]);
+    }
+    segment_defects.push_back(segment_defect);
+  }
+
+  return segment_defects;
+}
+
+}  // namespace trajopt
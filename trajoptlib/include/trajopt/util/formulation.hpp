@@ -0,0 +1,19 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stdint.h>
+
+namespace trajopt {
+
+/// The version of the generators' problem formulation.
+///
+/// Bump this whenever a change to the generators' variables, constraints,
+/// cost, or initial guess can change the solution of the same path, so
+/// solutions stored by the old formulation (see SolutionCache) aren't served.
+inline constexpr uint64_t FORMULATION_VERSION = 1;
+
+/// The tolerance the generators solve to. A tolerance of 1e-4 is 0.1 mm.
+inline constexpr double SOLVER_TOLERANCE = 1e-4;
+
+}  // namespace trajopt
@@ -4,6 +4,7 @@
 
 #include <cmath>
 #include <concepts>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -101,48 +102,10 @@ template <typename Solution>
 inline Solution generate_spline_initial_guess(
     const std::vector<std::vector<Pose2d>>& initial_guess_points,
     const std::vector<size_t> control_interval_counts) {
+  constexpr bool is_differential = std::same_as<Solution, DifferentialSolution>;
+
   std::vector<CubicHermitePoseSplineHolonomic> splines =
       splines_from_waypoints<Solution>(initial_guess_points);
-  std::vector<std::vector<PoseWithCurvature>> sgmt_points;
-  for (size_t i = 0; i < initial_guess_points.size(); ++i) {
-    for ([[maybe_unused]]
-         size_t j = 0;
-         j < initial_guess_points.at(i).size(); ++j) {
-      sgmt_points.push_back(std::vector<PoseWithCurvature>());
-    }
-  }
-
-  size_t traj_idx = 0;
-  if constexpr (std::same_as<Solution, DifferentialSolution>) {
-    sgmt_points.at(0).push_back(
-        splines.at(traj_idx).get_point(0, true).value());
-  } else {
-    sgmt_points.at(0).push_back(
-        splines.at(traj_idx).get_point(0, false).value());
-  }
-  for (size_t sgmt_idx = 1; sgmt_idx < initial_guess_points.size();
-       ++sgmt_idx) {
-    auto guess_points_size = initial_guess_points.at(sgmt_idx).size();
-    auto samples_for_sgmt = control_interval_counts.at(sgmt_idx - 1);
-    size_t samples = samples_for_sgmt / guess_points_size;
-    for (size_t guessIdx = 0; guessIdx < guess_points_size; ++guessIdx) {
-      if (guessIdx == (guess_points_size - 1)) {
-        samples += (samples_for_sgmt % guess_points_size);
-      }
-      for (size_t sample_idx = 1; sample_idx < samples + 1; ++sample_idx) {
-        auto t = static_cast<double>(sample_idx) / samples;
-
-        if constexpr (std::same_as<Solution, DifferentialSolution>) {
-          const auto state = splines.at(traj_idx).get_point(t, true).value();
-          sgmt_points.at(traj_idx + 1).push_back(state);
-        } else {
-          const auto state = splines.at(traj_idx).get_point(t, false).value();
-          sgmt_points.at(traj_idx + 1).push_back(state);
-        }
-      }
-      ++traj_idx;
-    }
-  }
 
   size_t wpt_cnt = control_interval_counts.size() + 1;
   size_t samp_tot = get_index(control_interval_counts, wpt_cnt - 1, 0) + 1;
@@ -151,7 +114,7 @@ inline Solution generate_spline_initial_guess(
 
   initial_guess.x.reserve(samp_tot);
   initial_guess.y.reserve(samp_tot);
-  if constexpr (std::same_as<Solution, DifferentialSolution>) {
+  if constexpr (is_differential) {
     initial_guess.heading.reserve(samp_tot);
   } else {
     initial_guess.thetacos.reserve(samp_tot);
@@ -163,18 +126,80 @@ inline Solution generate_spline_initial_guess(
     initial_guess.dt.push_back((wpt_cnt * 5.0) / samp_tot);
   }
 
-  for (auto sgmt : sgmt_points) {
-    for (auto pt : sgmt) {
-      initial_guess.x.push_back(pt.first.x());
-      initial_guess.y.push_back(pt.first.y());
-      if constexpr (std::same_as<Solution, DifferentialSolution>) {
-        initial_guess.heading.push_back(pt.first.rotation().radians());
-      } else {
-        initial_guess.thetacos.push_back(pt.first.rotation().cos());
-        initial_guess.thetasin.push_back(pt.first.rotation().sin());
+  // Appends a spline's points to the initial guess
+  auto append = [&](const auto& points) {
+    initial_guess.x.insert(initial_guess.x.end(), points.x.begin(),
+                           points.x.end());
+    initial_guess.y.insert(initial_guess.y.end(), points.y.begin(),
+                           points.y.end());
+    if constexpr (is_differential) {
+      for (size_t k = 0; k < points.cos.size(); ++k) {
+        initial_guess.heading.push_back(
+            std::atan2(points.sin[k], points.cos[k]));
+      }
+    } else {
+      initial_guess.thetacos.insert(initial_guess.thetacos.end(),
+                                    points.cos.begin(), points.cos.end());
+      initial_guess.thetasin.insert(initial_guess.thetasin.end(),
+                                    points.sin.begin(), points.sin.end());
+    }
+  };
+
+  // The guess points in order, so spline i runs from point i to point i + 1
+  std::vector<Pose2d> flat_points;
+  for (const auto& points : initial_guess_points) {
+    flat_points.insert(flat_points.end(), points.begin(), points.end());
+  }
+
+  // Each spline is evaluated at all of its points at once. A spline whose
+  // course has zero length (e.g., the robot rotates in place) has no course
+  // direction, so its points are interpolated linearly between its ends.
+  auto get_points = [&](size_t spline_idx, std::span<const double> t) {
+    auto points = splines.at(spline_idx).get_points(t, is_differential);
+    if (points.has_value()) {
+      return std::move(points.value());
+    }
+
+    const auto& begin = flat_points.at(spline_idx);
+    const auto& end = flat_points.at(spline_idx + 1);
+    const double θ_0 = begin.rotation().radians();
+    const double Δθ = (end.rotation() - begin.rotation()).radians();
+
+    CubicHermiteSpline::PosesWithCurvature linear_points;
+    for (double s : t) {
+      linear_points.x.push_back(begin.x() + (end.x() - begin.x()) * s);
+      linear_points.y.push_back(begin.y() + (end.y() - begin.y()) * s);
+      linear_points.cos.push_back(std::cos(θ_0 + Δθ * s));
+      linear_points.sin.push_back(std::sin(θ_0 + Δθ * s));
+      linear_points.curvature.push_back(0.0);
+    }
+    return linear_points;
+  };
+
+  const double start = 0.0;
+  append(get_points(0, std::span{&start, 1}));
+
+  std::vector<double> t;
+  size_t traj_idx = 0;
+  for (size_t sgmt_idx = 1; sgmt_idx < initial_guess_points.size();
+       ++sgmt_idx) {
+    auto guess_points_size = initial_guess_points.at(sgmt_idx).size();
+    auto samples_for_sgmt = control_interval_counts.at(sgmt_idx - 1);
+    size_t samples = samples_for_sgmt / guess_points_size;
+    for (size_t guessIdx = 0; guessIdx < guess_points_size; ++guessIdx) {
+      if (guessIdx == (guess_points_size - 1)) {
+        samples += (samples_for_sgmt % guess_points_size);
+      }
+
+      t.clear();
+      for (size_t sample_idx = 1; sample_idx < samples + 1; ++sample_idx) {
+        t.push_back(static_cast<double>(sample_idx) / samples);
       }
+      append(get_points(traj_idx, t));
+      ++traj_idx;
     }
   }
+
   return initial_guess;
 }
 
@@ -0,0 +1,114 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <limits>
+#include <numeric>
+#include <optional>
+
+#include <sleipnir/optimization/solver/exit_status.hpp>
+
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// Limits on how long a trajectory generation may run.
+struct TRAJOPT_DLLEXPORT GenerationBudget {
+  /// The maximum wall time spent solving, including re-solves after lazy
+  /// constraints are applied (s).
+  double max_solve_time = std::numeric_limits<double>::infinity();
+
+  /// The maximum number of solver iterations over all solves.
+  int max_iterations = std::numeric_limits<int>::max();
+};
+
+/// The outcome of a trajectory generation with a budget.
+///
+/// @tparam Solution The solution type (e.g., swerve, differential).
+template <typename Solution>
+struct BudgetedGeneration {
+  /// The solution if the solver converged, or else the best iterate it
+  /// reached. Empty only if the solver stopped before its first iteration.
+  std::optional<Solution> solution;
+
+  /// The solver's exit status. A solve stopped by the budget or a cancellation
+  /// reports CALLBACK_REQUESTED_STOP.
+  slp::ExitStatus status;
+
+  /// True if the budget ran out before the solver converged.
+  bool budget_exhausted = false;
+
+  /// The largest residual of the solution's constraints, which measures how
+  /// far an unconverged iterate is from feasible. See solution_violation().
+  double violation = std::numeric_limits<double>::infinity();
+};
+
+/// Keeps the best of a solver's iterates.
+///
+/// A feasible iterate, one whose violation is within the tolerance, beats any
+/// infeasible one. Feasible iterates are compared by total time, and
+/// infeasible ones by their violation.
+///
+/// Copying an iterate out of the problem and measuring its violation costs as
+/// much as the iteration's callback does otherwise, so callers should check
+/// can_improve() with the iterate's total time first.
+///
+/// @tparam Solution The solution type (e.g., swerve, differential).
+template <typename Solution>
+class BestIterate {
+ public:
+  /// Constructs a BestIterate.
+  ///
+  /// @param tolerance The largest violation of a feasible iterate.
+  explicit BestIterate(double tolerance = 1e-4) : m_tolerance{tolerance} {}
+
+  /// Returns true if an iterate with the given total time could be better
+  /// than the best one so far, which is only false once a feasible iterate
+  /// at least as fast has been kept.
+  ///
+  /// @param total_time The iterate's total time (s).
+  bool can_improve(double total_time) const {
+    return !m_solution.has_value() || m_violation > m_tolerance ||
+           total_time < m_total_time;
+  }
+
+  /// Keeps a copy of the iterate if it's better than the best one so far.
+  ///
+  /// @param iterate The iterate.
+  /// @param violation The iterate's violation. See solution_violation().
+  void offer(const Solution& iterate, double violation) {
+    double total_time =
+        std::accumulate(iterate.dt.begin(), iterate.dt.end(), 0.0);
+    bool feasible = violation <= m_tolerance;
+
+    if (m_solution.has_value()) {
+      bool best_feasible = m_violation <= m_tolerance;
+      bool better;
+      if (feasible != best_feasible) {
+        better = feasible;
+      } else if (feasible) {
+        better = total_time < m_total_time;
+      } else {
+        better = violation < m_violation;
+      }
+      if (!better) {
+        return;
+      }
+    }
+
+    m_solution = iterate;
+    m_violation = violation;
+    m_total_time = total_time;
+  }
+
+  /// Returns the best iterate, or nothing if none were offered.
+  const std::optional<Solution>& solution() const { return m_solution; }
+
+ private:
+  double m_tolerance;
+  std::optional<Solution> m_solution;
+  double m_violation = std::numeric_limits<double>::infinity();
+  double m_total_time = std::numeric_limits<double>::infinity();
+};
+
+}  // namespace trajopt
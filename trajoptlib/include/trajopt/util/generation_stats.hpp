@@ -0,0 +1,97 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "trajopt/constraint/constraint.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// Timing and size statistics of a trajectory generation.
+struct TRAJOPT_DLLEXPORT GenerationStats {
+  /// Wall time spent building the problem, excluding the initial guess (s).
+  double construction_time = 0.0;
+
+  /// Wall time spent calculating and applying the initial guess (s).
+  double initial_guess_time = 0.0;
+
+  /// Wall time spent in the solver, excluding callbacks (s).
+  double solve_time = 0.0;
+
+  /// Wall time spent in solver callbacks, including progress publishing and
+  /// the path's callbacks (s).
+  double callback_time = 0.0;
+
+  /// The number of solver iterations.
+  int iterations = 0;
+
+  /// The number of decision variables by source. Sources are the drivetrain's
+  /// own variables (e.g., "states", "inputs", "time steps") and the type name
+  /// of each path constraint that adds variables of its own (e.g.,
+  /// "PolygonKeepOutConstraint").
+  std::map<std::string, size_t> decision_variable_counts;
+
+  /// The number of constraint applications by source, where each application
+  /// constrains one sample or control interval. Sources are the drivetrain's
+  /// own constraints (e.g., "kinematics", "dynamics") and the type name of
+  /// each path constraint (e.g., "PointPointMinConstraint").
+  std::map<std::string, size_t> constraint_counts;
+
+  /// The number of constraint applications skipped because the same
+  /// constraint was already applied to the same sample, such as a segment
+  /// constraint's copy on the waypoint that starts the segment.
+  size_t removed_duplicate_constraints = 0;
+
+  /// The number of geometric constraint applications left out of the problem
+  /// because no solution came near them. Only paths with lazy geometric
+  /// constraints or obstacles leave any out.
+  size_t inactive_constraints = 0;
+
+  /// The number of autodiff subexpressions built once and shared by every
+  /// expression that uses them, by kind (e.g., "heading trig", "dynamics").
+  /// Without sharing, each use would add its own copy to the expression graph.
+  std::map<std::string, size_t> shared_subexpression_counts;
+
+  /// The process's peak resident memory after the solve (bytes), or zero if
+  /// the platform doesn't report it.
+  size_t peak_memory = 0;
+
+  /// Adds the statistics of another solve, such as one stage or leg of a
+  /// generation made of several problems.
+  ///
+  /// Times, iterations, and sizes are summed, and the peak memory is the
+  /// larger of the two.
+  ///
+  /// @param other The other solve's statistics.
+  /// @return This object.
+  GenerationStats& operator+=(const GenerationStats& other);
+
+  /// Counts applications of a path constraint and the decision variables they
+  /// add.
+  ///
+  /// @param constraint The constraint.
+  /// @param applications The number of samples it was applied to.
+  void count_constraint(const Constraint& constraint,
+                        size_t applications = 1);
+};
+
+/// Returns the type name of the constraint a Constraint variant holds.
+///
+/// @param constraint The constraint.
+/// @return The constraint's type name.
+TRAJOPT_DLLEXPORT std::string_view constraint_name(
+    const Constraint& constraint);
+
+/// Returns the process's peak resident memory.
+///
+/// @return The peak resident memory (bytes), or zero if the platform doesn't
+///     report it.
+TRAJOPT_DLLEXPORT size_t peak_memory_usage();
+
+}  // namespace trajopt
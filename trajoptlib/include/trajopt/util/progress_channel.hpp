@@ -0,0 +1,105 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// Which parts of the solution a progress channel publishes.
+enum class ProgressPayload : uint8_t {
+  /// Time steps and poses only. The solution's other fields are zero.
+  POSES,
+  /// The whole solution.
+  FULL,
+};
+
+/// Options for a progress channel.
+struct TRAJOPT_DLLEXPORT ProgressOptions {
+  /// The maximum number of updates published per second.
+  double rate = 60.0;
+
+  /// Which parts of the solution are published.
+  ProgressPayload payload = ProgressPayload::FULL;
+};
+
+/// Publishes a solver's intermediate solutions to one consumer without ever
+/// blocking the solver.
+///
+/// The channel owns three solutions. The solver writes into one, the consumer
+/// reads from another, and the third holds the latest published solution.
+/// Publishing and receiving swap buffers with a single atomic exchange, and
+/// the buffers' storage is reused between updates. The consumer only ever sees
+/// the latest update; older ones it didn't receive in time are dropped.
+///
+/// @tparam Solution The solution type (e.g., swerve, differential).
+template <typename Solution>
+class TRAJOPT_DLLEXPORT ProgressChannel {
+ public:
+  /// Constructs a ProgressChannel.
+  ///
+  /// @param options The channel's options.
+  explicit ProgressChannel(ProgressOptions options = {}) : m_options{options} {}
+
+  /// Returns the channel's options.
+  const ProgressOptions& options() const { return m_options; }
+
+  /// Returns the buffer the producer writes the next update into.
+  ///
+  /// Only the producer may call this.
+  Solution& write_buffer() { return m_buffers[m_write_index]; }
+
+  /// Publishes the write buffer as the latest update.
+  ///
+  /// Only the producer may call this.
+  void publish() {
+    auto latest = static_cast<uint8_t>(m_write_index | FRESH);
+    m_write_index =
+        m_latest.exchange(latest, std::memory_order_acq_rel) & INDEX_MASK;
+  }
+
+  /// Receives the latest update, if there's one the consumer hasn't received.
+  ///
+  /// Only the consumer may call this.
+  ///
+  /// @return True if read_buffer() now holds a new update.
+  bool receive() {
+    if ((m_latest.load(std::memory_order_relaxed) & FRESH) == 0) {
+      return false;
+    }
+
+    m_read_index =
+        m_latest.exchange(m_read_index, std::memory_order_acq_rel) & INDEX_MASK;
+    return true;
+  }
+
+  /// Returns the most recently received update.
+  ///
+  /// Only the consumer may call this.
+  const Solution& read_buffer() const { return m_buffers[m_read_index]; }
+
+ private:
+  static constexpr uint8_t INDEX_MASK = 0b011;
+  static constexpr uint8_t FRESH = 0b100;
+
+  ProgressOptions m_options;
+
+  std::array<Solution, 3> m_buffers;
+
+  /// Index of the buffer owned by the producer
+  uint8_t m_write_index = 0;
+
+  /// Index of the latest published buffer, plus a flag that's set until the
+  /// consumer receives it
+  std::atomic<uint8_t> m_latest = 1;
+
+  /// Index of the buffer owned by the consumer
+  uint8_t m_read_index = 2;
+};
+
+}  // namespace trajopt
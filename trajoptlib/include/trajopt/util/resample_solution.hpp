@@ -0,0 +1,201 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <numeric>
+#include <vector>
+
+#include "trajopt/util/trajopt_util.hpp"
+
+namespace trajopt {
+
+struct DifferentialSolution;
+
+/// Returns true if every field of a solution has one entry per sample of the
+/// given control interval layout.
+///
+/// A swerve solution's module forces may be left empty. Otherwise, every
+/// sample must have the same number of module forces.
+///
+/// @tparam Solution The solution type (e.g., swerve, differential).
+/// @param solution The solution to check.
+/// @param control_interval_counts The control interval counts the solution
+///     is expected to have been generated with.
+/// @return True if the solution has the layout's sample count.
+template <typename Solution>
+inline bool solution_fits(const Solution& solution,
+                          const std::vector<size_t>& control_interval_counts) {
+  size_t samp_tot =
+      get_index(control_interval_counts, control_interval_counts.size()) + 1;
+  auto fits = [&](const auto&... fields) {
+    return ((fields.size() == samp_tot) && ...);
+  };
+
+  if constexpr (std::same_as<Solution, DifferentialSolution>) {
+    return fits(solution.dt, solution.x, solution.y, solution.heading,
+                solution.vl, solution.vr, solution.angular_velocity,
+                solution.al, solution.ar, solution.angular_acceleration,
+                solution.Fl, solution.Fr);
+  } else {
+    if (!fits(solution.dt, solution.x, solution.y, solution.thetacos,
+              solution.thetasin, solution.vx, solution.vy, solution.omega,
+              solution.ax, solution.ay, solution.alpha)) {
+      return false;
+    }
+    if (solution.module_fx.empty() && solution.module_fy.empty()) {
+      return true;
+    }
+    if (!fits(solution.module_fx, solution.module_fy)) {
+      return false;
+    }
+    size_t module_cnt = solution.module_fx.front().size();
+    auto has_module_cnt = [&](const std::vector<double>& row) {
+      return row.size() == module_cnt;
+    };
+    return std::ranges::all_of(solution.module_fx, has_module_cnt) &&
+           std::ranges::all_of(solution.module_fy, has_module_cnt);
+  }
+}
+
+/// Resamples a solution onto a different control interval layout.
+///
+/// Each segment keeps its duration, and each sample is linearly interpolated
+/// from the two nearest samples of the same segment in the original solution.
+/// If the number of segments changed, the whole trajectory is treated as one
+/// segment. A swerve solution without module forces is resampled without them.
+///
+/// @tparam Solution The solution type (e.g., swerve, differential).
+/// @param solution The solution to resample.
+/// @param from_counts The control interval counts the solution was generated
+///     with.
+/// @param to_counts The control interval counts to resample onto.
+/// @return The resampled solution.
+template <typename Solution>
+inline Solution resample_solution(const Solution& solution,
+                                  std::vector<size_t> from_counts,
+                                  std::vector<size_t> to_counts) {
+  if (from_counts.size() != to_counts.size()) {
+    from_counts = {std::accumulate(from_counts.begin(), from_counts.end(),
+                                   size_t{0})};
+    to_counts = {
+        std::accumulate(to_counts.begin(), to_counts.end(), size_t{0})};
+  }
+
+  size_t sgmt_cnt = to_counts.size();
+  size_t from_samp_tot = get_index(from_counts, sgmt_cnt) + 1;
+  size_t to_samp_tot = get_index(to_counts, sgmt_cnt) + 1;
+
+  // Fractional index into the original solution of each resampled sample, and
+  // each resampled sample's time step
+  std::vector<double> positions;
+  std::vector<double> dts(to_samp_tot, 0.0);
+  positions.reserve(to_samp_tot);
+  for (size_t sgmt_index = 0; sgmt_index < sgmt_cnt; ++sgmt_index) {
+    size_t from_N = from_counts.at(sgmt_index);
+    size_t to_N = to_counts.at(sgmt_index);
+    size_t from_start = get_index(from_counts, sgmt_index);
+    size_t to_start = get_index(to_counts, sgmt_index);
+
+    for (size_t sample_index = 0; sample_index < to_N; ++sample_index) {
+      positions.push_back(from_start + static_cast<double>(sample_index) *
+                                           from_N / to_N);
+    }
+
+    if (to_N > 0) {
+      double sgmt_time = std::accumulate(
+          solution.dt.begin() + from_start,
+          solution.dt.begin() + from_start + from_N, 0.0);
+      for (size_t index = to_start; index < to_start + to_N + 1; ++index) {
+        dts.at(index) = sgmt_time / to_N;
+      }
+    }
+  }
+  positions.push_back(from_samp_tot - 1);
+
+  auto lerp = [](double a, double b, double t) { return a + (b - a) * t; };
+
+  // Calls f(lower index, upper index, interpolation fraction) for each
+  // resampled sample and returns the results
+  auto resample = [&](auto&& f) {
+    std::vector<decltype(f(size_t{0}, size_t{0}, 0.0))> result;
+    result.reserve(to_samp_tot);
+    for (double position : positions) {
+      size_t lower = static_cast<size_t>(std::floor(position));
+      size_t upper = std::min(lower + 1, from_samp_tot - 1);
+      result.push_back(f(lower, upper, position - lower));
+    }
+    return result;
+  };
+
+  auto resample_field = [&](const std::vector<double>& field) {
+    return resample([&](size_t lower, size_t upper, double t) {
+      return lerp(field.at(lower), field.at(upper), t);
+    });
+  };
+
+  auto resample_matrix_field =
+      [&](const std::vector<std::vector<double>>& field) {
+        return resample([&](size_t lower, size_t upper, double t) {
+          std::vector<double> row;
+          for (size_t i = 0; i < field.at(lower).size(); ++i) {
+            row.push_back(
+                lerp(field.at(lower).at(i), field.at(upper).at(i), t));
+          }
+          return row;
+        });
+      };
+
+  Solution resampled;
+  resampled.dt = std::move(dts);
+  resampled.x = resample_field(solution.x);
+  resampled.y = resample_field(solution.y);
+  if constexpr (std::same_as<Solution, DifferentialSolution>) {
+    resampled.heading = resample([&](size_t lower, size_t upper, double t) {
+      const auto& heading = solution.heading;
+      return heading.at(lower) +
+             angle_modulus(heading.at(upper) - heading.at(lower)) * t;
+    });
+    resampled.vl = resample_field(solution.vl);
+    resampled.vr = resample_field(solution.vr);
+    resampled.angular_velocity = resample_field(solution.angular_velocity);
+    resampled.al = resample_field(solution.al);
+    resampled.ar = resample_field(solution.ar);
+    resampled.angular_acceleration =
+        resample_field(solution.angular_acceleration);
+    resampled.Fl = resample_field(solution.Fl);
+    resampled.Fr = resample_field(solution.Fr);
+  } else {
+    // Interpolate the heading's cosine and sine, then put it back on the unit
+    // circle
+    resampled.thetacos = resample_field(solution.thetacos);
+    resampled.thetasin = resample_field(solution.thetasin);
+    for (size_t index = 0; index < to_samp_tot; ++index) {
+      auto& cosθ = resampled.thetacos.at(index);
+      auto& sinθ = resampled.thetasin.at(index);
+      double norm = std::hypot(cosθ, sinθ);
+      if (norm > 0.0) {
+        cosθ /= norm;
+        sinθ /= norm;
+      } else {
+        cosθ = 1.0;
+      }
+    }
+    resampled.vx = resample_field(solution.vx);
+    resampled.vy = resample_field(solution.vy);
+    resampled.omega = resample_field(solution.omega);
+    resampled.ax = resample_field(solution.ax);
+    resampled.ay = resample_field(solution.ay);
+    resampled.alpha = resample_field(solution.alpha);
+    if (!solution.module_fx.empty()) {
+      resampled.module_fx = resample_matrix_field(solution.module_fx);
+      resampled.module_fy = resample_matrix_field(solution.module_fy);
+    }
+  }
+
+  return resampled;
+}
+
+}  // namespace trajopt
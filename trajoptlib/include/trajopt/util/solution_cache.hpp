@@ -0,0 +1,297 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <expected>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sleipnir/optimization/solver/exit_status.hpp>
+
+#include "trajopt/util/formulation.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+struct DifferentialSolution;
+
+/// A cache of solutions on disk, keyed by the content hash of the path they
+/// solve (see PathBuilder::content_hash()).
+///
+/// Each solution is stored in its own file named after its key. Doubles are
+/// stored by their bit pattern, so a loaded solution is bit-identical to the
+/// stored one. Files are written to a temporary name and renamed into place,
+/// so a cache shared by several threads or processes never serves a partly
+/// written solution.
+///
+/// Each file also records the generators' formulation version and solver
+/// tolerance, so solutions stored by generators that would solve the same path
+/// differently are treated as missing and replaced on the next store.
+///
+/// @tparam Solution The solution type (e.g., swerve, differential).
+template <typename Solution>
+class TRAJOPT_DLLEXPORT SolutionCache {
+ public:
+  /// Constructs a SolutionCache.
+  ///
+  /// @param directory The directory the solutions are stored in. It's created
+  ///     on the first store if it doesn't exist.
+  explicit SolutionCache(std::filesystem::path directory)
+      : m_directory{std::move(directory)} {}
+
+  /// Loads a solution and counts a hit or miss.
+  ///
+  /// @param key The content hash of the solution's path.
+  /// @return The solution, or nothing if none is stored or its file can't be
+  ///     read.
+  std::optional<Solution> load(uint64_t key) {
+    auto solution = read(key);
+    if (solution.has_value()) {
+      ++m_hits;
+    } else {
+      ++m_misses;
+    }
+    return solution;
+  }
+
+  /// Stores a solution, replacing any stored under the same key.
+  ///
+  /// @param key The content hash of the solution's path.
+  /// @param solution The solution.
+  /// @return True if the solution was stored.
+  bool store(uint64_t key, const Solution& solution) {
+    std::vector<char> bytes;
+    auto write_u64 = [&](uint64_t value) {
+      for (int byte = 0; byte < 8; ++byte) {
+        bytes.push_back(static_cast<char>((value >> (8 * byte)) & 0xff));
+      }
+    };
+    auto write_values = [&](const std::vector<double>& values) {
+      write_u64(values.size());
+      for (double value : values) {
+        write_u64(std::bit_cast<uint64_t>(value));
+      }
+    };
+
+    write_u64(MAGIC);
+    write_u64(FORMULATION_VERSION);
+    write_u64(std::bit_cast<uint64_t>(SOLVER_TOLERANCE));
+    write_u64(solution_tag());
+    write_u64(key);
+    for_each_field(solution, [&](const auto& field) {
+      if constexpr (std::same_as<std::remove_cvref_t<decltype(field)>,
+                                 std::vector<double>>) {
+        write_values(field);
+      } else {
+        write_u64(field.size());
+        for (const auto& row : field) {
+          write_values(row);
+        }
+      }
+    });
+
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error) {
+      return false;
+    }
+
+    // Each writer gets its own temporary file, and the rename replaces the
+    // stored file atomically
+    auto path = file_path(key);
+    auto temp_path = path;
+    temp_path += std::format(".{:08x}.tmp", std::random_device{}());
+    {
+      std::ofstream file{temp_path, std::ios::binary | std::ios::trunc};
+      file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+      if (!file) {
+        std::filesystem::remove(temp_path, error);
+        return false;
+      }
+    }
+    std::filesystem::rename(temp_path, path, error);
+    if (error) {
+      std::filesystem::remove(temp_path, error);
+      return false;
+    }
+    return true;
+  }
+
+  /// Returns the cached solution of a path, or generates and stores it.
+  ///
+  /// @tparam Builder The path builder type.
+  /// @tparam Generate A callable that returns
+  ///     std::expected<Solution, slp::ExitStatus>.
+  /// @param path_builder The path.
+  /// @param generate Generates the path's solution on a miss. Failures aren't
+  ///     stored.
+  /// @return The path's solution, or the solver's exit status on failure.
+  template <typename Builder, typename Generate>
+  std::expected<Solution, slp::ExitStatus> get_or_generate(
+      const Builder& path_builder, Generate&& generate) {
+    uint64_t key = path_builder.content_hash();
+    if (auto solution = load(key)) {
+      return std::move(solution.value());
+    }
+
+    std::expected<Solution, slp::ExitStatus> solution = generate();
+    if (solution.has_value()) {
+      store(key, solution.value());
+    }
+    return solution;
+  }
+
+  /// Returns the number of loads that found a solution.
+  ///
+  /// @return The number of hits.
+  size_t hits() const { return m_hits; }
+
+  /// Returns the number of loads that didn't find a solution.
+  ///
+  /// @return The number of misses.
+  size_t misses() const { return m_misses; }
+
+  /// Resets the hit and miss counts to zero.
+  void reset_counts() {
+    m_hits = 0;
+    m_misses = 0;
+  }
+
+  /// Returns the directory the solutions are stored in.
+  ///
+  /// @return The directory.
+  const std::filesystem::path& directory() const { return m_directory; }
+
+ private:
+  /// "TCACHE" followed by the format version, in little-endian byte order
+  static constexpr uint64_t MAGIC = 0x0002'4548'4341'4354;
+
+  std::filesystem::path m_directory;
+  std::atomic<size_t> m_hits = 0;
+  std::atomic<size_t> m_misses = 0;
+
+  /// Returns the tag that keeps swerve and differential solutions apart.
+  static constexpr uint64_t solution_tag() {
+    return std::same_as<Solution, DifferentialSolution> ? 1 : 0;
+  }
+
+  /// Returns the file a key's solution is stored in.
+  std::filesystem::path file_path(uint64_t key) const {
+    return m_directory / std::format("{:016x}.trajopt", key);
+  }
+
+  /// Calls f with each of a solution's fields in a fixed order.
+  template <typename S, typename F>
+  static void for_each_field(S& solution, F&& f) {
+    f(solution.dt);
+    f(solution.x);
+    f(solution.y);
+    if constexpr (std::same_as<Solution, DifferentialSolution>) {
+      f(solution.heading);
+      f(solution.vl);
+      f(solution.vr);
+      f(solution.angular_velocity);
+      f(solution.al);
+      f(solution.ar);
+      f(solution.angular_acceleration);
+      f(solution.Fl);
+      f(solution.Fr);
+    } else {
+      f(solution.thetacos);
+      f(solution.thetasin);
+      f(solution.vx);
+      f(solution.vy);
+      f(solution.omega);
+      f(solution.ax);
+      f(solution.ay);
+      f(solution.alpha);
+      f(solution.module_fx);
+      f(solution.module_fy);
+    }
+  }
+
+  /// Reads a key's solution without counting a hit or miss.
+  std::optional<Solution> read(uint64_t key) const {
+    std::ifstream file{file_path(key), std::ios::binary};
+    if (!file) {
+      return std::nullopt;
+    }
+    std::vector<char> bytes(std::istreambuf_iterator<char>{file},
+                            std::istreambuf_iterator<char>{});
+
+    size_t offset = 0;
+    bool valid = true;
+    auto read_u64 = [&] {
+      uint64_t value = 0;
+      if (offset + 8 > bytes.size()) {
+        valid = false;
+        return value;
+      }
+      for (int byte = 0; byte < 8; ++byte) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(
+                     bytes[offset + byte]))
+                 << (8 * byte);
+      }
+      offset += 8;
+      return value;
+    };
+    auto read_values = [&](std::vector<double>& values) {
+      uint64_t size = read_u64();
+      if (!valid || size > (bytes.size() - offset) / 8) {
+        valid = false;
+        return;
+      }
+      values.resize(size);
+      for (double& value : values) {
+        value = std::bit_cast<double>(read_u64());
+      }
+    };
+
+    if (read_u64() != MAGIC || read_u64() != FORMULATION_VERSION ||
+        read_u64() != std::bit_cast<uint64_t>(SOLVER_TOLERANCE) ||
+        read_u64() != solution_tag() || read_u64() != key || !valid) {
+      return std::nullopt;
+    }
+
+    Solution solution;
+    for_each_field(solution, [&](auto& field) {
+      if (!valid) {
+        return;
+      }
+      if constexpr (std::same_as<std::remove_cvref_t<decltype(field)>,
+                                 std::vector<double>>) {
+        read_values(field);
+      } else {
+        uint64_t rows = read_u64();
+        if (!valid || rows > (bytes.size() - offset) / 8) {
+          valid = false;
+          return;
+        }
+        field.resize(rows);
+        for (auto& row : field) {
+          read_values(row);
+        }
+      }
+    });
+    if (!valid || offset != bytes.size()) {
+      return std::nullopt;
+    }
+    return solution;
+  }
+};
+
+}  // namespace trajopt
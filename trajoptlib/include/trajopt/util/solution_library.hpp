@@ -0,0 +1,289 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "trajopt/geometry/pose2.hpp"
+#include "trajopt/geometry/rotation2.hpp"
+#include "trajopt/geometry/translation2.hpp"
+#include "trajopt/path/path_builder.hpp"
+#include "trajopt/util/content_hash.hpp"
+#include "trajopt/util/resample_solution.hpp"
+#include "trajopt/util/symbol_exports.hpp"
+#include "trajopt/util/trajopt_util.hpp"
+
+namespace trajopt {
+
+struct DifferentialSolution;
+
+/// Options for matching paths in a SolutionLibrary.
+struct TRAJOPT_DLLEXPORT SolutionLibraryOptions {
+  /// The largest distance between a path and a stored one for the stored
+  /// solution to seed it (m). See SolutionLibrary::distance().
+  double max_distance = 1.0;
+
+  /// The distance a heading difference of one radian counts as (m).
+  double heading_weight = 0.5;
+};
+
+/// An in-memory library of solutions that seeds new solves with the solution
+/// of the most similar path solved before.
+///
+/// Solutions are indexed by their drivetrain and number of waypoints, and
+/// matched by how far their waypoints are from the new path's. The nearest
+/// match is warped onto the new path: each segment's samples are shifted by
+/// a blend of the moves of its two waypoints, and its duration is scaled by
+/// how much longer the segment got. The warped solution is then resampled
+/// onto the new path's control interval counts and passed to the generator's
+/// warm_start() in place of the path's own initial guess.
+///
+/// Adding and seeding may happen from several threads at once.
+///
+/// @tparam Drivetrain The drivetrain type (e.g., swerve, differential).
+/// @tparam Solution The solution type (e.g., swerve, differential).
+template <typename Drivetrain, typename Solution>
+class TRAJOPT_DLLEXPORT SolutionLibrary {
+ public:
+  /// The path builder type.
+  using Builder = PathBuilder<Drivetrain, Solution>;
+
+  /// Constructs an empty SolutionLibrary.
+  ///
+  /// @param options The matching options.
+  explicit SolutionLibrary(SolutionLibraryOptions options = {})
+      : m_options{options} {}
+
+  /// Adds a path's solution to the library.
+  ///
+  /// @param path_builder The path.
+  /// @param solution The path's solution.
+  void add(const Builder& path_builder, Solution solution) {
+    std::scoped_lock lock{m_mutex};
+    m_entries[index_key(path_builder)].push_back(
+        Entry{path_builder.get_wpt_initial_guess_points(),
+              path_builder.get_control_interval_counts(),
+              std::move(solution)});
+  }
+
+  /// Returns the number of solutions in the library.
+  ///
+  /// @return The number of solutions.
+  size_t size() const {
+    std::scoped_lock lock{m_mutex};
+    size_t count = 0;
+    for (const auto& [key, entries] : m_entries) {
+      count += entries.size();
+    }
+    return count;
+  }
+
+  /// Returns a seed for a path from the nearest stored solution.
+  ///
+  /// @param path_builder The path.
+  /// @return The nearest stored solution warped onto the path and resampled
+  ///     onto its control interval counts, or nothing if no stored path with
+  ///     the same drivetrain and number of waypoints is within the maximum
+  ///     distance.
+  std::optional<Solution> seed(const Builder& path_builder) const {
+    const auto waypoints = path_builder.get_wpt_initial_guess_points();
+
+    std::unique_lock lock{m_mutex};
+    auto bucket = m_entries.find(index_key(path_builder));
+    if (bucket == m_entries.end()) {
+      return std::nullopt;
+    }
+
+    const Entry* nearest = nullptr;
+    double nearest_distance = std::numeric_limits<double>::infinity();
+    for (const auto& entry : bucket->second) {
+      double d = distance(entry.waypoints, waypoints);
+      if (d < nearest_distance) {
+        nearest = &entry;
+        nearest_distance = d;
+      }
+    }
+    if (nearest == nullptr || nearest_distance > m_options.max_distance) {
+      return std::nullopt;
+    }
+    Entry entry = *nearest;
+    lock.unlock();
+
+    auto warped = warp(entry, waypoints,
+                       path_builder.get_drivetrain().chassis_limits());
+    return resample_solution(warped, entry.control_interval_counts,
+                             path_builder.get_control_interval_counts());
+  }
+
+  /// Returns how far apart two paths' waypoints are.
+  ///
+  /// @param from The first path's waypoint poses.
+  /// @param to The second path's waypoint poses. Must be as many as the first
+  ///     path's.
+  /// @return The largest distance between corresponding waypoints, where a
+  ///     heading difference counts as the heading weight per radian (m).
+  double distance(const std::vector<Pose2d>& from,
+                  const std::vector<Pose2d>& to) const {
+    double max_distance = 0.0;
+    for (size_t wpt_index = 0; wpt_index < from.size(); ++wpt_index) {
+      const auto& a = from.at(wpt_index);
+      const auto& b = to.at(wpt_index);
+      double dθ = std::abs(
+          angle_modulus(b.rotation().radians() - a.rotation().radians()));
+      max_distance =
+          std::max(max_distance, a.translation().distance(b.translation()) +
+                                     m_options.heading_weight * dθ);
+    }
+    return max_distance;
+  }
+
+ private:
+  struct Entry {
+    std::vector<Pose2d> waypoints;
+    std::vector<size_t> control_interval_counts;
+    Solution solution;
+  };
+
+  SolutionLibraryOptions m_options;
+  mutable std::mutex m_mutex;
+
+  /// Stored solutions by drivetrain and number of waypoints
+  std::map<uint64_t, std::vector<Entry>> m_entries;
+
+  /// Returns the key of the paths a path can be matched with.
+  static uint64_t index_key(const Builder& path_builder) {
+    ContentHasher hasher;
+    path_builder.get_drivetrain().hash(hasher);
+    hasher.add(path_builder.get_control_interval_counts().size());
+    return hasher.value();
+  }
+
+  /// Warps a stored solution onto new waypoints.
+  static Solution warp(const Entry& entry,
+                       const std::vector<Pose2d>& waypoints,
+                       const ChassisLimits& limits) {
+    const auto& counts = entry.control_interval_counts;
+    Solution solution = entry.solution;
+
+    // A segment's duration is scaled like a trapezoidal profile's over its
+    // straight-line length, and its velocities and accelerations like its
+    // length over its duration
+    auto time = [&](double length) {
+      return length > 0.0 ? calculate_trapezoidal_time(
+                                length, limits.max_velocity,
+                                limits.max_acceleration)
+                          : 0.0;
+    };
+
+    const size_t sgmt_cnt = counts.size();
+    const size_t samp_tot = get_index(counts, sgmt_cnt) + 1;
+    for (size_t index = 0; index < samp_tot; ++index) {
+      // The last sample belongs to the last segment
+      size_t sgmt_index = 0;
+      while (sgmt_index + 1 < sgmt_cnt &&
+             get_index(counts, sgmt_index + 1) <= index) {
+        ++sgmt_index;
+      }
+      const size_t N_sgmt = counts.at(sgmt_index);
+      const double u =
+          N_sgmt > 0 ? static_cast<double>(
+                           index - get_index(counts, sgmt_index)) /
+                           N_sgmt
+                     : 0.0;
+
+      const auto& old_start = entry.waypoints.at(sgmt_index);
+      const auto& old_end = entry.waypoints.at(sgmt_index + 1);
+      const auto& new_start = waypoints.at(sgmt_index);
+      const auto& new_end = waypoints.at(sgmt_index + 1);
+
+      // Shift by a blend of the segment's waypoint moves
+      auto start_move = new_start.translation() - old_start.translation();
+      auto end_move = new_end.translation() - old_end.translation();
+      auto move = start_move * (1.0 - u) + end_move * u;
+      double start_turn = angle_modulus(new_start.rotation().radians() -
+                                        old_start.rotation().radians());
+      double end_turn = angle_modulus(new_end.rotation().radians() -
+                                      old_end.rotation().radians());
+      double turn = start_turn * (1.0 - u) + end_turn * u;
+
+      double old_length = old_start.translation().distance(
+          old_end.translation());
+      double new_length = new_start.translation().distance(
+          new_end.translation());
+      double length_scale =
+          old_length > 0.0 && new_length > 0.0 ? new_length / old_length : 1.0;
+      double time_scale = old_length > 0.0 && new_length > 0.0
+                              ? time(new_length) / time(old_length)
+                              : 1.0;
+      double v_scale = length_scale / time_scale;
+      double a_scale = v_scale / time_scale;
+
+      // Velocities, accelerations, and forces turn with the segment's
+      // direction
+      Rotation2d bend;
+      if (old_length > 0.0 && new_length > 0.0) {
+        bend = (new_end.translation() - new_start.translation()).angle() -
+               (old_end.translation() - old_start.translation()).angle();
+      }
+
+      solution.dt.at(index) *= time_scale;
+      solution.x.at(index) += move.x();
+      solution.y.at(index) += move.y();
+      if constexpr (std::same_as<Solution, DifferentialSolution>) {
+        solution.heading.at(index) += turn;
+        solution.vl.at(index) *= v_scale;
+        solution.vr.at(index) *= v_scale;
+        solution.angular_velocity.at(index) *= v_scale;
+        solution.al.at(index) *= a_scale;
+        solution.ar.at(index) *= a_scale;
+        solution.angular_acceleration.at(index) *= a_scale;
+        solution.Fl.at(index) *= a_scale;
+        solution.Fr.at(index) *= a_scale;
+      } else {
+        double cosθ = solution.thetacos.at(index);
+        double sinθ = solution.thetasin.at(index);
+        solution.thetacos.at(index) =
+            cosθ * std::cos(turn) - sinθ * std::sin(turn);
+        solution.thetasin.at(index) =
+            sinθ * std::cos(turn) + cosθ * std::sin(turn);
+        Translation2d v{solution.vx.at(index), solution.vy.at(index)};
+        v = v.rotate_by(bend) * v_scale;
+        solution.vx.at(index) = v.x();
+        solution.vy.at(index) = v.y();
+        solution.omega.at(index) *= v_scale;
+        Translation2d a{solution.ax.at(index), solution.ay.at(index)};
+        a = a.rotate_by(bend) * a_scale;
+        solution.ax.at(index) = a.x();
+        solution.ay.at(index) = a.y();
+        solution.alpha.at(index) *= a_scale;
+        if (index < solution.module_fx.size()) {
+          auto& module_fx = solution.module_fx.at(index);
+          auto& module_fy = solution.module_fy.at(index);
+          for (size_t module_index = 0; module_index < module_fx.size();
+               ++module_index) {
+            Translation2d F{module_fx.at(module_index),
+                            module_fy.at(module_index)};
+            F = F.rotate_by(bend) * a_scale;
+            module_fx.at(module_index) = F.x();
+            module_fy.at(module_index) = F.y();
+          }
+        }
+      }
+    }
+
+    return solution;
+  }
+};
+
+}  // namespace trajopt
@@ -0,0 +1,292 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <span>
+#include <vector>
+
+#include "trajopt/constraint/constraint.hpp"
+#include "trajopt/geometry/pose2.hpp"
+#include "trajopt/geometry/rotation2.hpp"
+#include "trajopt/geometry/translation2.hpp"
+#include "trajopt/path/path.hpp"
+#include "trajopt/util/drivetrain_dynamics.hpp"
+#include "trajopt/util/dynamics_defect.hpp"
+#include "trajopt/util/trajopt_util.hpp"
+#include "trajopt/util/transcription.hpp"
+
+namespace trajopt {
+
+struct DifferentialSolution;
+
+/// A solution's state at one sample, as the generators pass it to constraints.
+struct SampleState {
+  /// The robot's pose.
+  Pose2d pose;
+
+  /// The robot's linear velocity.
+  Translation2d linear_velocity;
+
+  /// The robot's angular velocity.
+  double angular_velocity;
+
+  /// The robot's linear acceleration.
+  Translation2d linear_acceleration;
+
+  /// The robot's angular acceleration.
+  double angular_acceleration;
+};
+
+/// Returns a solution's state at a sample.
+///
+/// A differential solution's linear velocity and acceleration are along the
+/// robot's heading, in the robot's frame, like DifferentialTrajectoryGenerator
+/// applies them.
+///
+/// @tparam Drivetrain The drivetrain type (e.g., swerve, differential).
+/// @tparam Solution The solution type (e.g., swerve, differential).
+/// @param drivetrain The drivetrain the solution was generated for.
+/// @param solution The solution.
+/// @param index The sample's index.
+/// @return The sample's state.
+template <typename Drivetrain, typename Solution>
+SampleState sample_state(const Drivetrain& drivetrain, const Solution& solution,
+                         size_t index) {
+  if constexpr (std::same_as<Solution, DifferentialSolution>) {
+    const double vl = solution.vl[index];
+    const double vr = solution.vr[index];
+    const double al = solution.al[index];
+    const double ar = solution.ar[index];
+    return SampleState{
+        Pose2d{solution.x[index], solution.y[index], solution.heading[index]},
+        Translation2d{(vl + vr) / 2, 0.0}, (vr - vl) / drivetrain.trackwidth,
+        Translation2d{(al + ar) / 2, 0.0}, (ar - al) / drivetrain.trackwidth};
+  } else {
+    return SampleState{
+        Pose2d{solution.x[index],
+               solution.y[index],
+               {solution.thetacos[index], solution.thetasin[index]}},
+        Translation2d{solution.vx[index], solution.vy[index]},
+        solution.omega[index],
+        Translation2d{solution.ax[index], solution.ay[index]},
+        solution.alpha[index]};
+  }
+}
+
+/// Returns how far a sample's state is from satisfying a constraint.
+///
+/// @param constraint The constraint.
+/// @param state The sample's state.
+/// @return The violation in the constraint's units. See constraint_violation().
+inline double constraint_violation(const Constraint& constraint,
+                                   const SampleState& state) {
+  return constraint_violation(constraint, state.pose, state.linear_velocity,
+                              state.angular_velocity, state.linear_acceleration,
+                              state.angular_acceleration);
+}
+
+/// Returns the largest violation of constraints left out of a problem.
+///
+/// @tparam Drivetrain The drivetrain type (e.g., swerve, differential).
+/// @tparam Solution The solution type (e.g., swerve, differential).
+/// @param drivetrain The drivetrain the solution was generated for.
+/// @param solution The solution.
+/// @param constraints The left-out constraints and their samples.
+/// @return The largest violation, or zero if there are none.
+template <typename Drivetrain, typename Solution>
+double lazy_constraint_violation(const Drivetrain& drivetrain,
+                                 const Solution& solution,
+                                 std::span<const LazyConstraint> constraints) {
+  double violation = 0.0;
+  for (const auto& [constraint, index, activation_margin] : constraints) {
+    violation = std::max(
+        violation, constraint_violation(
+                       constraint, sample_state(drivetrain, solution, index)));
+  }
+  return violation;
+}
+
+/// Returns how far a solution is from satisfying its problem's constraints.
+///
+/// This is the largest of
+///
+/// - the dynamics defect of each control interval under the transcription the
+///   solution was generated with, in wheel radii, see dynamics_defects()
+/// - the violation of each waypoint constraint at its waypoint's sample and
+///   each segment constraint at its segment's samples, in the constraint's
+///   units, see constraint_violation()
+/// - how far each wheel's speed and force exceed the drivetrain's limits, as
+///   fractions of the limits
+/// - the residual of each sample's accelerations from the ones its wheel
+///   forces produce, as a fraction of the largest the wheels can produce, see
+///   swerve_accelerations() and differential_wheel_accelerations()
+///
+/// The dynamics residuals are scaled by the drivetrain so one tolerance fits
+/// them all, where newtons of force would otherwise swamp meters of defect.
+/// The path constraints' units are the m, m/s, and rad their bounds are
+/// given in.
+///
+/// @tparam Drivetrain The drivetrain type (e.g., swerve, differential).
+/// @tparam Solution The solution type (e.g., swerve, differential).
+/// @param path The path the solution was generated for.
+/// @param control_interval_counts The control interval counts the solution was
+///     generated with.
+/// @param solution The solution.
+/// @param transcription The transcription the solution was generated with.
+/// @return The largest violation.
+template <typename Drivetrain, typename Solution>
+double solution_violation(const Path<Drivetrain, Solution>& path,
+                          const std::vector<size_t>& control_interval_counts,
+                          const Solution& solution,
+                          Transcription transcription) {
+  const auto& drivetrain = path.drivetrain;
+  const size_t sample_cnt = solution.x.size();
+
+  // The generators' wheel limits, which scale each family of dynamics
+  // residuals
+  //
+  //   vₘₐₓ = rω_max
+  //   Fₘₐₓ = min(τ_max/r, μmg/n)
+  //
+  // where n is the number of wheels the generator shares the normal force
+  // between
+  constexpr size_t num_wheels =
+      std::same_as<Solution, DifferentialSolution> ? 2 : 4;
+  const double v_max =
+      drivetrain.wheel_radius * drivetrain.wheel_max_angular_velocity;
+  const double F_max =
+      std::min(drivetrain.wheel_max_torque / drivetrain.wheel_radius,
+               drivetrain.wheel_cof * drivetrain.mass * 9.8 / num_wheels);
+  double a_max;
+  [[maybe_unused]] double α_max = 0.0;
+  if constexpr (std::same_as<Solution, DifferentialSolution>) {
+    // A wheel accelerates fastest when both wheels push together or against
+    // each other
+    double a_linear =
+        differential_wheel_accelerations(drivetrain, F_max, F_max)[0];
+    double a_turning =
+        differential_wheel_accelerations(drivetrain, F_max, -F_max)[0];
+    a_max = std::max(std::abs(a_linear), std::abs(a_turning));
+  } else {
+    double module_radius = 0.0;
+    for (const auto& module : drivetrain.modules) {
+      module_radius = std::max(module_radius, module.norm());
+    }
+    const double F_total = drivetrain.modules.size() * F_max;
+    a_max = F_total / drivetrain.mass;
+    α_max = F_total * module_radius / drivetrain.moi;
+  }
+
+  // Returns a residual as a fraction of its scale, or the residual itself if
+  // the scale is degenerate
+  auto normalized = [](double residual, double scale) {
+    return scale > 0.0 ? residual / scale : residual;
+  };
+
+  double violation = 0.0;
+  for (double defect : dynamics_defects(drivetrain, solution, transcription)) {
+    violation =
+        std::max(violation, normalized(defect, drivetrain.wheel_radius));
+  }
+
+  // Path constraints
+  const size_t wpt_cnt = path.waypoints.size();
+  for (size_t wpt_index = 0; wpt_index < wpt_cnt; ++wpt_index) {
+    size_t index = get_index(control_interval_counts, wpt_index, 0);
+    if (index >= sample_cnt) {
+      break;
+    }
+
+    auto state = sample_state(drivetrain, solution, index);
+    for (const auto& constraint :
+         path.waypoints[wpt_index].waypoint_constraints) {
+      violation = std::max(violation, constraint_violation(constraint, state));
+    }
+  }
+  for (size_t sgmt_index = 0; sgmt_index + 1 < wpt_cnt; ++sgmt_index) {
+    const auto& constraints =
+        path.waypoints[sgmt_index + 1].segment_constraints;
+    if (constraints.empty()) {
+      continue;
+    }
+
+    size_t start_index = get_index(control_interval_counts, sgmt_index, 0);
+    size_t end_index = std::min(
+        get_index(control_interval_counts, sgmt_index + 1, 0), sample_cnt);
+    for (size_t index = start_index; index < end_index; ++index) {
+      auto state = sample_state(drivetrain, solution, index);
+      for (const auto& constraint : constraints) {
+        violation =
+            std::max(violation, constraint_violation(constraint, state));
+      }
+    }
+  }
+
+  // Wheel limits and force balance
+  auto over = [](double value, double max) {
+    return std::max(std::abs(value) - max, 0.0);
+  };
+
+  for (size_t index = 0; index < sample_cnt; ++index) {
+    if constexpr (std::same_as<Solution, DifferentialSolution>) {
+      const double Fl = solution.Fl[index];
+      const double Fr = solution.Fr[index];
+
+      violation = std::max({violation,
+                            normalized(over(solution.vl[index], v_max), v_max),
+                            normalized(over(solution.vr[index], v_max), v_max),
+                            normalized(over(Fl, F_max), F_max),
+                            normalized(over(Fr, F_max), F_max)});
+
+      auto [al, ar] = differential_wheel_accelerations(drivetrain, Fl, Fr);
+      violation = std::max(
+          {violation, normalized(std::abs(solution.al[index] - al), a_max),
+           normalized(std::abs(solution.ar[index] - ar), a_max)});
+    } else {
+      if (index >= solution.module_fx.size()) {
+        break;
+      }
+
+      Rotation2d θ{solution.thetacos[index], solution.thetasin[index]};
+      auto v_wrt_robot =
+          Translation2d{solution.vx[index], solution.vy[index]}.rotate_by(-θ);
+      const double ω = solution.omega[index];
+
+      const auto& module_fx = solution.module_fx[index];
+      const auto& module_fy = solution.module_fy[index];
+      auto force = [&](size_t module_index) {
+        if (module_index >= module_fx.size()) {
+          return Translation2d{};
+        }
+        return Translation2d{module_fx[module_index], module_fy[module_index]};
+      };
+
+      for (size_t module_index = 0; module_index < drivetrain.modules.size();
+           ++module_index) {
+        const auto& translation = drivetrain.modules[module_index];
+        Translation2d v_wheel_wrt_robot{
+            v_wrt_robot.x() - translation.y() * ω,
+            v_wrt_robot.y() + translation.x() * ω};
+        violation = std::max(
+            {violation,
+             normalized(over(v_wheel_wrt_robot.norm(), v_max), v_max),
+             normalized(over(force(module_index).norm(), F_max), F_max)});
+      }
+
+      auto [a, α] = swerve_accelerations(drivetrain, θ, force);
+      violation = std::max(
+          {violation, normalized(std::abs(solution.ax[index] - a.x()), a_max),
+           normalized(std::abs(solution.ay[index] - a.y()), a_max),
+           normalized(std::abs(solution.alpha[index] - α), α_max)});
+    }
+  }
+
+  return violation;
+}
+
+}  // namespace trajopt
@@ -0,0 +1,75 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <cmath>
+#include <concepts>
+#include <numbers>
+#include <vector>
+
+namespace trajopt {
+
+struct DifferentialSolution;
+
+/// Joins the solutions of consecutive parts of a path into one solution.
+///
+/// Each part must start where the previous one ends. The shared sample is
+/// taken from the later part, since its time step and acceleration belong to
+/// the later part's first control interval. Differential headings are shifted
+/// by whole turns so they stay continuous across the joins.
+///
+/// @tparam Solution The solution type (e.g., swerve, differential).
+/// @param parts The solutions of the parts, in path order. Must not be empty.
+/// @return The solution of the whole path.
+template <typename Solution>
+Solution stitch_solutions(const std::vector<Solution>& parts) {
+  Solution stitched = parts.front();
+
+  // Replaces the last sample of a field with a part's samples
+  auto append = [](auto& field, const auto& part_field) {
+    field.pop_back();
+    field.insert(field.end(), part_field.begin(), part_field.end());
+  };
+
+  for (size_t part_index = 1; part_index < parts.size(); ++part_index) {
+    const auto& part = parts.at(part_index);
+
+    append(stitched.dt, part.dt);
+    append(stitched.x, part.x);
+    append(stitched.y, part.y);
+    if constexpr (std::same_as<Solution, DifferentialSolution>) {
+      double turns =
+          std::round((stitched.heading.back() - part.heading.front()) /
+                     (2.0 * std::numbers::pi));
+      stitched.heading.pop_back();
+      for (double heading : part.heading) {
+        stitched.heading.push_back(heading + turns * 2.0 * std::numbers::pi);
+      }
+      append(stitched.vl, part.vl);
+      append(stitched.vr, part.vr);
+      append(stitched.angular_velocity, part.angular_velocity);
+      append(stitched.al, part.al);
+      append(stitched.ar, part.ar);
+      append(stitched.angular_acceleration, part.angular_acceleration);
+      append(stitched.Fl, part.Fl);
+      append(stitched.Fr, part.Fr);
+    } else {
+      append(stitched.thetacos, part.thetacos);
+      append(stitched.thetasin, part.thetasin);
+      append(stitched.vx, part.vx);
+      append(stitched.vy, part.vy);
+      append(stitched.omega, part.omega);
+      append(stitched.ax, part.ax);
+      append(stitched.ay, part.ay);
+      append(stitched.alpha, part.alpha);
+      append(stitched.module_fx, part.module_fx);
+      append(stitched.module_fy, part.module_fy);
+    }
+  }
+
+  return stitched;
+}
+
+}  // namespace trajopt
@@ -0,0 +1,246 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <utility>
+#include <vector>
+
+#include "trajopt/util/trajopt_util.hpp"
+
+namespace trajopt {
+
+struct DifferentialSolution;
+
+/// Retimes an initial guess with a velocity profile along its path.
+///
+/// Each segment keeps its shape, but its samples are moved along it to follow
+/// a rest-to-rest trapezoidal profile over the segment's estimated duration,
+/// so they bunch up where the robot is slow. The generators hold the time
+/// step constant within a segment, so every sample of a segment gets the same
+/// dt. The velocities and accelerations are the profile's own rather than
+/// finite differences of the positions, so the guess starts out close to
+/// satisfying the dynamics.
+///
+/// A segment's duration is the time to turn through its heading changes plus
+/// the time to drive its length, each with a trapezoidal profile at the
+/// drivetrain's chassis limits. Its profile ramps up and down for the same
+/// fraction of the duration as the longer of the two motions would.
+///
+/// @tparam Drivetrain The drivetrain type (e.g., swerve, differential).
+/// @tparam Solution The solution type (e.g., swerve, differential).
+/// @param guess The initial guess. Its poses are moved along its path, and its
+///     time steps, velocities, and accelerations are replaced.
+/// @param control_interval_counts The guess's control interval counts.
+/// @param drivetrain The drivetrain.
+template <typename Drivetrain, typename Solution>
+void time_parameterize_initial_guess(
+    Solution& guess, const std::vector<size_t>& control_interval_counts,
+    const Drivetrain& drivetrain) {
+  constexpr bool is_differential = std::same_as<Solution, DifferentialSolution>;
+
+  const auto limits = drivetrain.chassis_limits();
+  const size_t wpt_cnt = control_interval_counts.size() + 1;
+  const size_t samp_tot =
+      get_index(control_interval_counts, wpt_cnt - 1, 0) + 1;
+
+  // Unwrap the headings so consecutive samples turn the short way
+  std::vector<double> headings(samp_tot);
+  for (size_t index = 0; index < samp_tot; ++index) {
+    double heading;
+    if constexpr (is_differential) {
+      heading = guess.heading.at(index);
+    } else {
+      heading = std::atan2(guess.thetasin.at(index), guess.thetacos.at(index));
+    }
+    headings[index] =
+        index == 0 ? heading
+                   : headings[index - 1] +
+                         angle_modulus(heading - headings[index - 1]);
+  }
+  const std::vector<double> xs = guess.x;
+  const std::vector<double> ys = guess.y;
+
+  std::vector<double> dt(samp_tot, 0.0);
+  std::vector<double> θ = headings;
+  std::vector<double> vx(samp_tot, 0.0);
+  std::vector<double> vy(samp_tot, 0.0);
+  std::vector<double> ω(samp_tot, 0.0);
+  std::vector<double> ax(samp_tot, 0.0);
+  std::vector<double> ay(samp_tot, 0.0);
+  std::vector<double> α(samp_tot, 0.0);
+
+  // Speed and acceleration along the path, for wheel speeds
+  std::vector<double> v(samp_tot, 0.0);
+  std::vector<double> a(samp_tot, 0.0);
+
+  for (size_t sgmt_index = 0; sgmt_index < control_interval_counts.size();
+       ++sgmt_index) {
+    const size_t N_sgmt = control_interval_counts.at(sgmt_index);
+    const size_t sgmt_start = get_index(control_interval_counts, sgmt_index);
+
+    // A segment without intervals or motion takes no time
+    auto stay = [&] {
+      for (size_t index = sgmt_start; index <= sgmt_start + N_sgmt; ++index) {
+        dt[index] = 0.0;
+      }
+    };
+    if (N_sgmt == 0) {
+      stay();
+      continue;
+    }
+
+    // Parameterize the segment's path by its length, or by its heading change
+    // if it turns in place
+    double length = 0.0;
+    double turn = 0.0;
+    for (size_t k = 1; k <= N_sgmt; ++k) {
+      size_t index = sgmt_start + k;
+      length +=
+          std::hypot(xs[index] - xs[index - 1], ys[index] - ys[index - 1]);
+      turn += std::abs(headings[index] - headings[index - 1]);
+    }
+    if (length == 0.0 && turn == 0.0) {
+      stay();
+      continue;
+    }
+    const bool by_length = length > 0.0;
+    std::vector<double> c(N_sgmt + 1, 0.0);
+    for (size_t k = 1; k <= N_sgmt; ++k) {
+      size_t index = sgmt_start + k;
+      c[k] = c[k - 1] +
+             (by_length ? std::hypot(xs[index] - xs[index - 1],
+                                     ys[index] - ys[index - 1])
+                        : std::abs(headings[index] - headings[index - 1]));
+    }
+    const double C = c[N_sgmt];
+
+    const double angular_time =
+        calculate_trapezoidal_time(turn, limits.max_angular_velocity,
+                                   limits.max_angular_acceleration);
+    const double max_v =
+        angular_time > 0.0
+            ? std::min(limits.max_velocity, length / angular_time)
+            : limits.max_velocity;
+    const double linear_time =
+        calculate_trapezoidal_time(length, max_v, limits.max_acceleration);
+    const double T = angular_time + linear_time;
+
+    double ramp_fraction;
+    if (linear_time >= angular_time) {
+      ramp_fraction = std::min(max_v / limits.max_acceleration,
+                               linear_time / 2) /
+                      linear_time;
+    } else {
+      ramp_fraction = std::min(limits.max_angular_velocity /
+                                   limits.max_angular_acceleration,
+                               angular_time / 2) /
+                      angular_time;
+    }
+
+    // Progress from 0 to 1 ramps up at a constant acceleration, cruises, and
+    // ramps down symmetrically
+    const double t_ramp = ramp_fraction * T;
+    const double rate = 1.0 / (T - t_ramp);
+    const double accel = rate / t_ramp;
+
+    size_t piece = 0;
+    for (size_t k = 0; k <= N_sgmt; ++k) {
+      const double t = T * k / N_sgmt;
+      double progress;
+      double progress_rate;
+      double progress_accel;
+      if (t < t_ramp) {
+        progress = 0.5 * accel * t * t;
+        progress_rate = accel * t;
+        progress_accel = accel;
+      } else if (t <= T - t_ramp) {
+        progress = 0.5 * accel * t_ramp * t_ramp + rate * (t - t_ramp);
+        progress_rate = rate;
+        progress_accel = 0.0;
+      } else {
+        progress = 1.0 - 0.5 * accel * (T - t) * (T - t);
+        progress_rate = accel * (T - t);
+        progress_accel = -accel;
+      }
+      const double s = std::clamp(progress, 0.0, 1.0) * C;
+
+      // Find the piece of the path between two original samples that holds s
+      while (piece + 1 < N_sgmt &&
+             (c[piece + 1] < s || c[piece + 1] == c[piece])) {
+        ++piece;
+      }
+      const size_t from = sgmt_start + piece;
+      const double width = c[piece + 1] - c[piece];
+      const double u =
+          width > 0.0 ? std::clamp((s - c[piece]) / width, 0.0, 1.0) : 0.0;
+
+      // Derivatives of the pose with respect to the path parameter
+      double dx_dc = 0.0;
+      double dy_dc = 0.0;
+      double dθ_dc = 0.0;
+      if (width > 0.0) {
+        dx_dc = (xs[from + 1] - xs[from]) / width;
+        dy_dc = (ys[from + 1] - ys[from]) / width;
+        dθ_dc = (headings[from + 1] - headings[from]) / width;
+      }
+      const double ds_dc = std::hypot(dx_dc, dy_dc);
+
+      const size_t index = sgmt_start + k;
+      guess.x[index] = xs[from] + u * (xs[from + 1] - xs[from]);
+      guess.y[index] = ys[from] + u * (ys[from + 1] - ys[from]);
+      θ[index] = headings[from] + u * (headings[from + 1] - headings[from]);
+      vx[index] = dx_dc * C * progress_rate;
+      vy[index] = dy_dc * C * progress_rate;
+      ω[index] = dθ_dc * C * progress_rate;
+      ax[index] = dx_dc * C * progress_accel;
+      ay[index] = dy_dc * C * progress_accel;
+      α[index] = dθ_dc * C * progress_accel;
+      v[index] = ds_dc * C * progress_rate;
+      a[index] = ds_dc * C * progress_accel;
+    }
+
+    // The generators assign each segment's time step to its last sample too
+    for (size_t index = sgmt_start; index <= sgmt_start + N_sgmt; ++index) {
+      dt[index] = T / N_sgmt;
+    }
+  }
+
+  guess.dt = std::move(dt);
+  if constexpr (is_differential) {
+    // Wheel speeds differ from the chassis speed by the turn rate
+    const double half_trackwidth = drivetrain.trackwidth / 2;
+    guess.heading = θ;
+    guess.vl.resize(samp_tot);
+    guess.vr.resize(samp_tot);
+    guess.al.resize(samp_tot);
+    guess.ar.resize(samp_tot);
+    for (size_t index = 0; index < samp_tot; ++index) {
+      guess.vl[index] = v[index] - half_trackwidth * ω[index];
+      guess.vr[index] = v[index] + half_trackwidth * ω[index];
+      guess.al[index] = a[index] - half_trackwidth * α[index];
+      guess.ar[index] = a[index] + half_trackwidth * α[index];
+    }
+    guess.angular_velocity = std::move(ω);
+    guess.angular_acceleration = std::move(α);
+  } else {
+    guess.thetacos.resize(samp_tot);
+    guess.thetasin.resize(samp_tot);
+    for (size_t index = 0; index < samp_tot; ++index) {
+      guess.thetacos[index] = std::cos(θ[index]);
+      guess.thetasin[index] = std::sin(θ[index]);
+    }
+    guess.vx = std::move(vx);
+    guess.vy = std::move(vy);
+    guess.omega = std::move(ω);
+    guess.ax = std::move(ax);
+    guess.ay = std::move(ay);
+    guess.alpha = std::move(α);
+  }
+}
+
+}  // namespace trajopt
@@ -0,0 +1,42 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stdint.h>
+
+#include <concepts>
+
+namespace trajopt {
+
+/// How the drivetrain dynamics are enforced between consecutive samples.
+///
+/// Higher-order schemes model the motion within each control interval more
+/// accurately, so they reach the same accuracy with fewer samples.
+enum class Transcription : uint8_t {
+  /// Each interval is integrated with the acceleration at its first sample held
+  /// constant (second-order Taylor step). This is the swerve generator's
+  /// default.
+  CONSTANT_ACCELERATION,
+  /// Hermite–Simpson direct collocation: the state is a cubic over each
+  /// interval whose derivative matches the dynamics at both samples and the
+  /// midpoint. This is the differential generator's default.
+  HERMITE_SIMPSON,
+  /// Multiple shooting with a fourth-order Runge–Kutta step per interval.
+  RUNGE_KUTTA_4,
+};
+
+struct DifferentialSolution;
+
+/// Returns the transcription a generator uses when the path doesn't set one.
+///
+/// @tparam Solution The solution type (e.g., swerve, differential).
+template <typename Solution>
+constexpr Transcription default_transcription() {
+  if constexpr (std::same_as<Solution, DifferentialSolution>) {
+    return Transcription::HERMITE_SIMPSON;
+  } else {
+    return Transcription::CONSTANT_ACCELERATION;
+  }
+}
+
+}  // namespace trajopt
@@ -0,0 +1,80 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "trajopt/util/symbol_exports.hpp"
+
+namespace trajopt {
+
+/// A fixed-size thread pool where each worker owns a task queue and idle
+/// workers steal from the queues of busy ones.
+///
+/// Tasks are meant to be coarse (e.g., one trajectory solve each), so the
+/// queues are guarded by mutexes rather than being lock-free.
+class TRAJOPT_DLLEXPORT WorkStealingPool {
+ public:
+  /// Constructs a pool and starts its workers.
+  ///
+  /// @param thread_count The number of worker threads. If zero, one worker per
+  ///     hardware thread is started.
+  explicit WorkStealingPool(size_t thread_count = 0);
+
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+  /// Finishes every queued task, then stops the workers.
+  ~WorkStealingPool();
+
+  /// Queues a task. Tasks must not throw.
+  ///
+  /// @param task The task.
+  void submit(std::function<void()> task);
+
+  /// Blocks until every submitted task has finished.
+  void wait();
+
+  /// Returns the number of worker threads.
+  ///
+  /// @return The number of worker threads.
+  size_t thread_count() const { return m_queues.size(); }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::vector<std::jthread> m_threads;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_available;
+  std::condition_variable m_idle;
+
+  // Tasks submitted but not yet popped by a worker
+  size_t m_queued_count = 0;
+
+  // Tasks submitted but not yet finished
+  size_t m_pending_count = 0;
+
+  // Queue that receives the next submitted task
+  size_t m_next_queue = 0;
+
+  bool m_stopping = false;
+
+  void run(size_t index);
+
+  bool try_pop(size_t index, std::function<void()>& task);
+};
+
+}  // namespace trajopt
@@ -3,8 +3,10 @@
 #include "trajopt/differential_trajectory_generator.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
-#include <ranges>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <sleipnir/autodiff/variable.hpp>
@@ -13,7 +15,15 @@
 #include "trajopt/geometry/rotation2.hpp"
 #include "trajopt/geometry/translation2.hpp"
 #include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/compact_constraints.hpp"
+#include "trajopt/util/formulation.hpp"
+#include "trajopt/util/generation_budget.hpp"
+#include "trajopt/util/generation_stats.hpp"
+#include "trajopt/util/resample_solution.hpp"
+#include "trajopt/util/solution_violation.hpp"
+#include "trajopt/util/time_parameterize_initial_guess.hpp"
 #include "trajopt/util/trajopt_util.hpp"
+#include "util/generator_common.hpp"
 
 // Physics notation in this file:
 //
@@ -31,6 +41,22 @@
 
 namespace trajopt {
 
+ChassisLimits DifferentialDrivetrain::chassis_limits() const {
+  constexpr int num_wheels = 2;
+
+  const double chassis_max_force = wheel_max_torque * num_wheels / wheel_radius;
+  const double chassis_max_a = chassis_max_force / mass;
+  const double chassis_max_v = wheel_radius * wheel_max_angular_velocity;
+
+  // Turning in place drives the wheels in opposite directions
+  return ChassisLimits{
+      .max_velocity = chassis_max_v,
+      .max_acceleration = chassis_max_a,
+      .max_angular_velocity = chassis_max_v / (trackwidth / 2),
+      .max_angular_acceleration = chassis_max_a / (trackwidth / 2),
+      .min_wheel_spacing = trackwidth};
+}
+
 inline Translation2d wheel_to_chassis_speeds(double vl, double vr) {
   return Translation2d{(vl + vr) / 2, 0.0};
 }
@@ -43,7 +69,9 @@ inline Translation2v<double> wheel_to_chassis_speeds(slp::Variable<double> vl,
 DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
     DifferentialPathBuilder path_builder, int64_t handle)
     : path(path_builder.get_path()),
-      Ns(path_builder.get_control_interval_counts()) {
+      Ns(path_builder.get_control_interval_counts()),
+      transcription(path_builder.get_transcription().value_or(
+          default_transcription<DifferentialSolution>())) {
   // See equations just before (12.35) and (12.36) in
   // https://controls-in-frc.link/ for wheel acceleration equations.
   //
@@ -58,10 +86,14 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
   //   v = (vₗ + vᵣ) / 2
   //   ω = (vᵣ - vₗ) / (2r_b)
 
-  auto f =
-      [this](
-          const slp::VariableMatrix<double>& x,
-          const slp::VariableMatrix<double>& u) -> slp::VariableMatrix<double> {
+  //
+  // The heading's cosine and sine are passed in, so states at samples reuse the
+  // ones built for the sample.
+  auto f = [this](const slp::VariableMatrix<double>& x,
+                  const slp::VariableMatrix<double>& u,
+                  const slp::Variable<double>& cosθ,
+                  const slp::Variable<double>& sinθ)
+      -> slp::VariableMatrix<double> {
     slp::VariableMatrix<double> xdot{5};
 
     const auto& m = path.drivetrain.mass;
@@ -73,36 +105,76 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
         {1.0 / m - r_b * r_b / J, 1.0 / m + r_b * r_b / J}};
 
     auto v = (x[3] + x[4]) / 2.0;
-    xdot[0] = v * cos(x[2]);
-    xdot[1] = v * sin(x[2]);
+    xdot[0] = v * cosθ;
+    xdot[1] = v * sinθ;
     xdot[2] = (x[4] - x[3]) / path.drivetrain.trackwidth;
     xdot.segment(3, 2) = B * u;
 
     return xdot;
   };
 
+  using std::chrono::steady_clock;
+  using seconds = std::chrono::duration<double>;
+
+  auto construction_start = steady_clock::now();
   auto initial_guess = path_builder.calculate_spline_initial_guess();
+  time_parameterize_initial_guess(initial_guess, Ns, path.drivetrain);
+  seconds initial_guess_time = steady_clock::now() - construction_start;
+
+  // Obstacles near a segment's initial guess are applied like segment
+  // constraints, and the others are left out until a solution comes near them
+  const double obstacle_margin = path_builder.get_obstacle_margin();
+  auto obstacle_constraints =
+      path_builder.apply_obstacle_constraints(path, initial_guess);
+
+  generation_stats.removed_duplicate_constraints =
+      compact_constraints(path, Ns);
 
   problem.add_callback(
       [this, handle = handle](const slp::IterationInfo<double>&) -> bool {
-        constexpr int fps = 60;
-        constexpr std::chrono::duration<double> time_per_frame{1.0 / fps};
-
-        // FPS limit on sending updates
-        static auto last_frame_time = std::chrono::steady_clock::now();
-        auto now = std::chrono::steady_clock::now();
-        if (now - last_frame_time < time_per_frame) {
-          return trajopt::get_cancellation_flag();
+        auto now = steady_clock::now();
+        ++generation_stats.iterations;
+
+        // Rate limit on publishing to the progress channel
+        if (progress_channel != nullptr) {
+          const auto& options = progress_channel->options();
+          if (now - last_progress_time >=
+              std::chrono::duration<double>{1.0 / options.rate}) {
+            last_progress_time = now;
+            fill_differential_solution(progress_channel->write_buffer(),
+                                       options.payload);
+            progress_channel->publish();
+          }
+        }
+
+        detail::send_to_callbacks(
+            path, handle, now, last_callback_time,
+            [this] { return construct_differential_solution(); });
+
+        // The iterate is only copied out of the problem if it can beat the
+        // best one so far
+        if (best_iterate.has_value()) {
+          double total_time = 0.0;
+          for (auto& dt : dts) {
+            total_time += dt.value();
+          }
+          if (best_iterate->can_improve(total_time)) {
+            fill_differential_solution(iterate, ProgressPayload::FULL);
+            best_iterate->offer(iterate, violation(iterate));
+          }
         }
 
-        last_frame_time = now;
+        generation_stats.callback_time +=
+            seconds{steady_clock::now() - now}.count();
 
-        auto soln = construct_differential_solution();
-        for (auto& callback : this->path.callbacks) {
-          callback(soln, handle);
+        // Stop once the running generate() call's budget runs out
+        if (seconds{now - solve_start_time}.count() >= budget.max_solve_time ||
+            generation_stats.iterations >= budget.max_iterations) {
+          budget_exhausted = true;
+          return true;
         }
 
-        return trajopt::get_cancellation_flag();
+        return cancellation_token.is_cancelled();
       });
 
   size_t wpt_cnt = path.waypoints.size();
@@ -137,50 +209,42 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
     dts.emplace_back(problem.decision_variable());
   }
 
+  generation_stats.decision_variable_counts = {
+      {"states", 7 * samp_tot},
+      {"inputs", 2 * samp_tot},
+      {"time steps", samp_tot}};
+
   constexpr int num_wheels = 2;
 
   // Minimize total time
-  const double chassis_max_force = path.drivetrain.wheel_max_torque *
-                                   num_wheels / path.drivetrain.wheel_radius;
-  const double chassis_max_a = chassis_max_force / path.drivetrain.mass;
-  const double chassis_max_v =
-      path.drivetrain.wheel_radius * path.drivetrain.wheel_max_angular_velocity;
-  const double chassis_max_ω = chassis_max_v * (path.drivetrain.trackwidth / 2);
-  const double chassis_max_α = chassis_max_a * (path.drivetrain.trackwidth / 2);
-  for (size_t sgmt_index = 0; sgmt_index < Ns.size(); ++sgmt_index) {
-    size_t N_sgmt = Ns.at(sgmt_index);
-    size_t sgmt_start = get_index(Ns, sgmt_index);
-    size_t sgmt_end = get_index(Ns, sgmt_index + 1);
-
-    if (N_sgmt == 0) {
-      for (size_t index = sgmt_start; index < sgmt_end + 1; ++index) {
-        dts.at(index).set_value(0.0);
-      }
-    } else {
-      // Use initialGuess and Ns to find the dx, dy, dθ between wpts
-      const double dx =
-          initial_guess.x.at(sgmt_end) - initial_guess.x.at(sgmt_start);
-      const double dy =
-          initial_guess.y.at(sgmt_end) - initial_guess.y.at(sgmt_start);
-      const double dist = std::hypot(dx, dy);
-      const double θ_0 = initial_guess.heading.at(sgmt_start);
-      const double θ_1 = initial_guess.heading.at(sgmt_end);
-      const double dθ = std::abs(angle_modulus(θ_1 - θ_0));
-
-      const double angular_time =
-          calculate_trapezoidal_time(dθ, chassis_max_ω, chassis_max_α);
-      const double linear_time = calculate_trapezoidal_time(
-          dist, std::min(chassis_max_v, dist / angular_time), chassis_max_a);
-      const double sgmt_time = angular_time + linear_time;
-
-      for (size_t index = sgmt_start; index < sgmt_end + 1; ++index) {
-        auto& dt = dts.at(index);
-        problem.subject_to(slp::bounds(0, dt, 3));
-        dt.set_value(sgmt_time / N_sgmt);
-      }
-    }
+  detail::minimize_total_time(problem, dts, Ns, initial_guess.dt);
+
+  // Returns the dynamics at a state between samples
+  auto f_between = [&](const slp::VariableMatrix<double>& x,
+                       const slp::VariableMatrix<double>& u) {
+    return f(x, u, cos(x[2]), sin(x[2]));
+  };
+
+  // Build each sample's heading trig and dynamics once. Consecutive intervals
+  // and the constraints applied at a sample share them.
+  cosθ.reserve(samp_tot);
+  sinθ.reserve(samp_tot);
+  std::vector<slp::VariableMatrix<double>> xdots;
+  xdots.reserve(samp_tot);
+  for (size_t index = 0; index < samp_tot; ++index) {
+    cosθ.emplace_back(cos(θ.at(index)));
+    sinθ.emplace_back(sin(θ.at(index)));
+
+    slp::VariableMatrix x_k{{x.at(index)},
+                            {y.at(index)},
+                            {θ.at(index)},
+                            {vl.at(index)},
+                            {vr.at(index)}};
+    slp::VariableMatrix u_k{{Fl.at(index)}, {Fr.at(index)}};
+    xdots.emplace_back(f(x_k, u_k, cosθ.at(index), sinθ.at(index)));
   }
-  problem.minimize(std::accumulate(dts.begin(), dts.end(), slp::Variable{0.0}));
+  generation_stats.shared_subexpression_counts = {
+      {"heading trig", 2 * samp_tot}, {"dynamics", samp_tot}};
 
   // Apply dynamics constraints
   for (size_t wpt_index = 0; wpt_index < wpt_cnt - 1; ++wpt_index) {
@@ -209,17 +273,58 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
         problem.subject_to(dt_k_1 == dt_k);
       }
 
-      // Dynamics constraints - direct collocation
-      // (https://mec560sbu.github.io/2016/09/30/direct_collocation/)
-      auto xdot_k = f(x_k, u_k);
-      auto xdot_k_1 = f(x_k_1, u_k_1);
-      auto xdot_c =
-          -3 / (2 * dt_k) * (x_k - x_k_1) - 0.25 * (xdot_k + xdot_k_1);
-
-      auto x_c = 0.5 * (x_k + x_k_1) + dt_k / 8 * (xdot_k - xdot_k_1);
+      const auto& xdot_k = xdots.at(index);
       auto u_c = 0.5 * (u_k + u_k_1);
 
-      problem.subject_to(xdot_c == f(x_c, u_c));
+      switch (transcription) {
+        case Transcription::CONSTANT_ACCELERATION: {
+          // Second-order Taylor step with the wheel accelerations held
+          // constant
+          //
+          //   d²x/dt² = a cosθ − vω sinθ
+          //   d²y/dt² = a sinθ + vω cosθ
+          //   d²θ/dt² = α
+          auto v = (x_k[3] + x_k[4]) / 2.0;
+          auto ω_k = xdot_k[2];
+          auto a = (xdot_k[3] + xdot_k[4]) / 2.0;
+          auto α_k = (xdot_k[4] - xdot_k[3]) / path.drivetrain.trackwidth;
+
+          slp::VariableMatrix<double> xddot_k{
+              {a * cosθ.at(index) - v * ω_k * sinθ.at(index)},
+              {a * sinθ.at(index) + v * ω_k * cosθ.at(index)},
+              {α_k},
+              {0.0},
+              {0.0}};
+
+          problem.subject_to(x_k_1 == x_k + dt_k * xdot_k +
+                                          0.5 * dt_k * dt_k * xddot_k);
+          break;
+        }
+        case Transcription::HERMITE_SIMPSON: {
+          // Dynamics constraints - direct collocation
+          // (https://mec560sbu.github.io/2016/09/30/direct_collocation/)
+          const auto& xdot_k_1 = xdots.at(index + 1);
+          auto xdot_c =
+              -3 / (2 * dt_k) * (x_k - x_k_1) - 0.25 * (xdot_k + xdot_k_1);
+
+          auto x_c = 0.5 * (x_k + x_k_1) + dt_k / 8 * (xdot_k - xdot_k_1);
+
+          problem.subject_to(xdot_c == f_between(x_c, u_c));
+          break;
+        }
+        case Transcription::RUNGE_KUTTA_4: {
+          // Multiple shooting with the wheel forces varying linearly over the
+          // interval
+          auto k1 = xdot_k;
+          auto k2 = f_between(x_k + dt_k / 2 * k1, u_c);
+          auto k3 = f_between(x_k + dt_k / 2 * k2, u_c);
+          auto k4 = f_between(x_k + dt_k * k3, u_k_1);
+
+          problem.subject_to(x_k_1 ==
+                             x_k + dt_k / 6 * (k1 + 2.0 * k2 + 2.0 * k3 + k4));
+          break;
+        }
+      }
 
       problem.subject_to(al.at(index) == xdot_k[3]);
       problem.subject_to(ar.at(index) == xdot_k[4]);
@@ -256,11 +361,38 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
     problem.subject_to(slp::bounds(-F_max, Fr.at(index), F_max));
   }
 
+  // Dynamics constrain each control interval, and wheel limits each sample
+  auto& constraint_counts = generation_stats.constraint_counts;
+  constraint_counts["dynamics"] = samp_tot - 1;
+  constraint_counts["wheel limits"] = samp_tot;
+
+  const auto lazy_margin = path_builder.get_lazy_geometric_constraints();
+
+  // Leaves a geometric constraint out of the problem if the initial guess is
+  // far from it at the sample
+  auto defer_constraint = [&](const Constraint& constraint, size_t index) {
+    if (!lazy_margin.has_value()) {
+      return false;
+    }
+
+    Pose2d pose{initial_guess.x.at(index), initial_guess.y.at(index),
+                initial_guess.heading.at(index)};
+    auto margin = constraint_margin(constraint, pose);
+    if (!margin.has_value() ||
+        margin.value() < lazy_margin.value()) {
+      return false;
+    }
+
+    inactive_constraints.push_back({constraint, index, lazy_margin.value()});
+    return true;
+  };
+
   for (size_t wpt_index = 0; wpt_index < wpt_cnt; ++wpt_index) {
     // First index of next wpt - 1
     size_t index = get_index(Ns, wpt_index, 0);
 
-    Pose2v<double> pose_k{x.at(index), y.at(index), {θ.at(index)}};
+    Pose2v<double> pose_k{
+        x.at(index), y.at(index), {cosθ.at(index), sinθ.at(index)}};
     Translation2v<double> v_k =
         wheel_to_chassis_speeds(vl.at(index), vr.at(index));
     auto ω_k = (vr.at(index) - vl.at(index)) / path.drivetrain.trackwidth;
@@ -269,9 +401,14 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
     auto α_k = (ar.at(index) - al.at(index)) / path.drivetrain.trackwidth;
 
     for (auto& constraint : path.waypoints.at(wpt_index).waypoint_constraints) {
+      if (defer_constraint(constraint, index)) {
+        continue;
+      }
+
       std::visit(
           [&](auto&& arg) { arg.apply(problem, pose_k, v_k, ω_k, a_k, α_k); },
           constraint);
+      generation_stats.count_constraint(constraint);
     }
   }
 
@@ -280,7 +417,8 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
     size_t end_index = get_index(Ns, sgmt_index + 1, 0);
 
     for (size_t index = start_index; index < end_index; ++index) {
-      Pose2v<double> pose_k{x.at(index), y.at(index), {θ.at(index)}};
+      Pose2v<double> pose_k{
+          x.at(index), y.at(index), {cosθ.at(index), sinθ.at(index)}};
       Translation2v<double> v_k =
           wheel_to_chassis_speeds(vl.at(index), vr.at(index));
       auto ω_k = (vr.at(index) - vl.at(index)) / path.drivetrain.trackwidth;
@@ -290,100 +428,255 @@ DifferentialTrajectoryGenerator::DifferentialTrajectoryGenerator(
 
       for (auto& constraint :
            path.waypoints.at(sgmt_index + 1).segment_constraints) {
+        if (defer_constraint(constraint, index)) {
+          continue;
+        }
+
         std::visit(
             [&](auto&& arg) { arg.apply(problem, pose_k, v_k, ω_k, a_k, α_k); },
             constraint);
+        generation_stats.count_constraint(constraint);
       }
     }
   }
 
+  // A segment's far obstacles are checked at its samples up to the next
+  // segment's first, which the next segment checks
+  for (size_t sgmt_index = 0; sgmt_index < sgmt_cnt; ++sgmt_index) {
+    size_t start_index = get_index(Ns, sgmt_index, 0);
+    size_t end_index = get_index(Ns, sgmt_index + 1, 0);
+    if (sgmt_index + 1 == sgmt_cnt) {
+      ++end_index;
+    }
+
+    for (const auto& constraint : obstacle_constraints.at(sgmt_index).far) {
+      for (size_t index = start_index; index < end_index; ++index) {
+        inactive_constraints.push_back({constraint, index, obstacle_margin});
+      }
+    }
+  }
+  generation_stats.inactive_constraints = inactive_constraints.size();
+
+  auto initial_guess_start = steady_clock::now();
   apply_initial_guess(initial_guess);
+  initial_guess_time += steady_clock::now() - initial_guess_start;
+
+  generation_stats.initial_guess_time = initial_guess_time.count();
+  generation_stats.construction_time =
+      seconds{steady_clock::now() - construction_start}.count() -
+      generation_stats.initial_guess_time;
 }
 
 std::expected<DifferentialSolution, slp::ExitStatus>
-DifferentialTrajectoryGenerator::generate(bool diagnostics) {
-  get_cancellation_flag() = 0;
-
-  // tolerance of 1e-4 is 0.1 mm
-  auto status = problem.solve({.tolerance = 1e-4, .diagnostics = diagnostics});
-
-  if (static_cast<int>(status) < 0 ||
-      status == slp::ExitStatus::CALLBACK_REQUESTED_STOP) {
+DifferentialTrajectoryGenerator::generate(bool diagnostics,
+                                          GenerationStats* stats) {
+  auto status = solve(diagnostics, stats);
+  if (detail::failed(status)) {
     return std::unexpected{status};
   } else {
     return construct_differential_solution();
   }
 }
 
+BudgetedGeneration<DifferentialSolution>
+DifferentialTrajectoryGenerator::generate(const GenerationBudget& budget,
+                                          bool diagnostics,
+                                          GenerationStats* stats) {
+  this->budget = budget;
+  best_iterate.emplace();
+
+  auto status = solve(diagnostics, stats);
+
+  BudgetedGeneration<DifferentialSolution> result{
+      .status = status, .budget_exhausted = budget_exhausted};
+  if (detail::failed(status)) {
+    result.solution = best_iterate->solution();
+  } else {
+    result.solution = construct_differential_solution();
+  }
+  if (result.solution.has_value()) {
+    result.violation = violation(result.solution.value());
+  }
+
+  this->budget = GenerationBudget{};
+  best_iterate.reset();
+  return result;
+}
+
+slp::ExitStatus DifferentialTrajectoryGenerator::solve(bool diagnostics,
+                                                       GenerationStats* stats) {
+  using std::chrono::steady_clock;
+
+  generation_stats.iterations = 0;
+  generation_stats.callback_time = 0.0;
+  budget_exhausted = false;
+
+  solve_start_time = steady_clock::now();
+
+  auto status = problem.solve(
+      {.tolerance = SOLVER_TOLERANCE, .diagnostics = diagnostics});
+
+  // Re-solve from the last solution until it doesn't come near any geometric
+  // constraint that was left out
+  while (!detail::failed(status) && activate_constraints() > 0) {
+    status = problem.solve(
+        {.tolerance = SOLVER_TOLERANCE, .diagnostics = diagnostics});
+  }
+
+  std::chrono::duration<double> solve_time =
+      steady_clock::now() - solve_start_time;
+  generation_stats.solve_time =
+      solve_time.count() - generation_stats.callback_time;
+  generation_stats.peak_memory = peak_memory_usage();
+  generation_stats.inactive_constraints = inactive_constraints.size();
+  if (stats != nullptr) {
+    *stats = generation_stats;
+  }
+
+  return status;
+}
+
+size_t DifferentialTrajectoryGenerator::activate_constraints() {
+  std::vector<LazyConstraint> still_inactive;
+  for (auto& lazy_constraint : inactive_constraints) {
+    auto& [constraint, index, activation_margin] = lazy_constraint;
+    Pose2d pose{x.at(index).value(), y.at(index).value(),
+                θ.at(index).value()};
+    if (constraint_margin(constraint, pose).value() >= activation_margin) {
+      still_inactive.push_back(std::move(lazy_constraint));
+      continue;
+    }
+
+    Pose2v<double> pose_k{
+        x.at(index), y.at(index), {cosθ.at(index), sinθ.at(index)}};
+    Translation2v<double> v_k =
+        wheel_to_chassis_speeds(vl.at(index), vr.at(index));
+    auto ω_k = (vr.at(index) - vl.at(index)) / path.drivetrain.trackwidth;
+    Translation2v<double> a_k =
+        wheel_to_chassis_speeds(al.at(index), ar.at(index));
+    auto α_k = (ar.at(index) - al.at(index)) / path.drivetrain.trackwidth;
+
+    std::visit(
+        [&](auto&& arg) { arg.apply(problem, pose_k, v_k, ω_k, a_k, α_k); },
+        constraint);
+    generation_stats.count_constraint(constraint);
+    activated_constraints.push_back(std::move(lazy_constraint));
+  }
+
+  size_t activated = inactive_constraints.size() - still_inactive.size();
+  inactive_constraints = std::move(still_inactive);
+  return activated;
+}
+
+bool DifferentialTrajectoryGenerator::warm_start(
+    const DifferentialSolution& solution,
+    const std::vector<size_t>& control_interval_counts) {
+  if (!solution_fits(solution, control_interval_counts)) {
+    return false;
+  }
+
+  auto seed = control_interval_counts == Ns
+                  ? solution
+                  : resample_solution(solution, control_interval_counts, Ns);
+
+  size_t sample_total = x.size();
+  for (size_t sample_index = 0; sample_index < sample_total; ++sample_index) {
+    x[sample_index].set_value(seed.x[sample_index]);
+    y[sample_index].set_value(seed.y[sample_index]);
+    θ[sample_index].set_value(seed.heading[sample_index]);
+    vl[sample_index].set_value(seed.vl[sample_index]);
+    vr[sample_index].set_value(seed.vr[sample_index]);
+    al[sample_index].set_value(seed.al[sample_index]);
+    ar[sample_index].set_value(seed.ar[sample_index]);
+    Fl[sample_index].set_value(seed.Fl[sample_index]);
+    Fr[sample_index].set_value(seed.Fr[sample_index]);
+
+    // Keep the constructor's time step guess where the seed has no duration
+    if (seed.dt[sample_index] > 0.0) {
+      dts[sample_index].set_value(seed.dt[sample_index]);
+    }
+  }
+
+  return true;
+}
+
 void DifferentialTrajectoryGenerator::apply_initial_guess(
     const DifferentialSolution& solution) {
+  // The guess is time-parameterized, so its wheel speeds and accelerations
+  // already agree with its time steps
   size_t sample_total = x.size();
   for (size_t sample_index = 0; sample_index < sample_total; ++sample_index) {
     x[sample_index].set_value(solution.x[sample_index]);
     y[sample_index].set_value(solution.y[sample_index]);
     θ[sample_index].set_value(solution.heading[sample_index]);
+    vl[sample_index].set_value(solution.vl[sample_index]);
+    vr[sample_index].set_value(solution.vr[sample_index]);
+    al[sample_index].set_value(solution.al[sample_index]);
+    ar[sample_index].set_value(solution.ar[sample_index]);
   }
+}
 
-  vl[0].set_value(0.0);
-  vr[0].set_value(0.0);
-  al[0].set_value(0.0);
-  ar[0].set_value(0.0);
-
-  for (size_t sample_index = 1; sample_index < sample_total; ++sample_index) {
-    double linear_velocity =
-        std::hypot(solution.x[sample_index] - solution.x[sample_index - 1],
-                   solution.y[sample_index] - solution.y[sample_index - 1]) /
-        solution.dt[sample_index];
-    double heading = solution.heading[sample_index];
-    double last_heading = solution.heading[sample_index - 1];
-
-    double ω =
-        Rotation2d{heading}.rotate_by(-Rotation2d{last_heading}).radians() /
-        solution.dt[sample_index];
-    vl[sample_index].set_value(
-        (linear_velocity - path.drivetrain.trackwidth / 2 * ω));
-    vr[sample_index].set_value(
-        (linear_velocity + path.drivetrain.trackwidth / 2 * ω));
-    al[sample_index].set_value(
-        (vl[sample_index].value() - vl[sample_index - 1].value()) /
-        solution.dt[sample_index]);
-    ar[sample_index].set_value(
-        (vr[sample_index].value() - vr[sample_index - 1].value()) /
-        solution.dt[sample_index]);
-  }
+double DifferentialTrajectoryGenerator::violation(
+    const DifferentialSolution& solution) const {
+  return std::max({solution_violation(path, Ns, solution, transcription),
+                   lazy_constraint_violation(path.drivetrain, solution,
+                                             inactive_constraints),
+                   lazy_constraint_violation(path.drivetrain, solution,
+                                             activated_constraints)});
 }
 
 DifferentialSolution
 DifferentialTrajectoryGenerator::construct_differential_solution() {
-  auto get_value = [](auto& var) { return var.value(); };
+  DifferentialSolution solution;
+  fill_differential_solution(solution, ProgressPayload::FULL);
+  return solution;
+}
 
-  auto vector_value = [&](std::vector<slp::Variable<double>>& row) {
-    return row | std::views::transform(get_value) |
-           std::ranges::to<std::vector>();
+void DifferentialTrajectoryGenerator::fill_differential_solution(
+    DifferentialSolution& solution, ProgressPayload payload) {
+  // Assign in place so the solution's storage is reused
+  auto fill_vector = [](std::vector<double>& values,
+                        std::vector<slp::Variable<double>>& row) {
+    values.resize(row.size());
+    for (size_t index = 0; index < row.size(); ++index) {
+      values[index] = row[index].value();
+    }
   };
-  const auto& trackwidth = path.drivetrain.trackwidth;
-  std::vector<double> ω;
-  for (size_t sample = 0; sample < vl.size(); ++sample) {
-    ω.push_back((vr.at(sample).value() - vl.at(sample).value()) / trackwidth);
-  }
-  std::vector<double> α;
-  for (size_t sample = 0; sample < al.size(); ++sample) {
-    α.push_back((ar.at(sample).value() - al.at(sample).value()) / trackwidth);
+
+  fill_vector(solution.dt, dts);
+  fill_vector(solution.x, x);
+  fill_vector(solution.y, y);
+  fill_vector(solution.heading, θ);
+
+  if (payload == ProgressPayload::FULL) {
+    fill_vector(solution.vl, vl);
+    fill_vector(solution.vr, vr);
+    fill_vector(solution.al, al);
+    fill_vector(solution.ar, ar);
+    fill_vector(solution.Fl, Fl);
+    fill_vector(solution.Fr, Fr);
+
+    const auto& trackwidth = path.drivetrain.trackwidth;
+    solution.angular_velocity.resize(vl.size());
+    for (size_t sample = 0; sample < vl.size(); ++sample) {
+      solution.angular_velocity[sample] =
+          (solution.vr[sample] - solution.vl[sample]) / trackwidth;
+    }
+    solution.angular_acceleration.resize(al.size());
+    for (size_t sample = 0; sample < al.size(); ++sample) {
+      solution.angular_acceleration[sample] =
+          (solution.ar[sample] - solution.al[sample]) / trackwidth;
+    }
+  } else {
+    // Zero the fields that aren't published, so they still have an entry per
+    // sample instead of a previous update's values
+    for (auto* values : {&solution.vl, &solution.vr, &solution.angular_velocity,
+                         &solution.al, &solution.ar,
+                         &solution.angular_acceleration, &solution.Fl,
+                         &solution.Fr}) {
+      values->assign(x.size(), 0.0);
+    }
   }
-  return DifferentialSolution{
-      vector_value(dts),
-      vector_value(x),
-      vector_value(y),
-      vector_value(θ),
-      vector_value(vl),
-      vector_value(vr),
-      ω,
-      vector_value(al),
-      vector_value(ar),
-      α,
-      vector_value(Fl),
-      vector_value(Fr),
-  };
 }
 
 }  // namespace trajopt
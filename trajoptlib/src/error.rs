@@ -27,6 +27,8 @@ pub enum TrajoptError {
     Timeout,
     #[error("Unparsable error code: {0}")]
     Unparsable(Box<str>),
+    #[error("Exception: {0}")]
+    Exception(Box<str>),
     #[error("Unknown error: {0:?}")]
     Unknown(i8),
 }
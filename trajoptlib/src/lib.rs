@@ -77,6 +77,20 @@ mod ffi {
         samples: Vec<DifferentialTrajectorySample>,
     }
 
+    struct SwerveBatchResult {
+        handle: i64,
+        trajectory: SwerveTrajectory,
+        error: i8,
+        exception: String,
+    }
+
+    struct DifferentialBatchResult {
+        handle: i64,
+        trajectory: DifferentialTrajectory,
+        error: i8,
+        exception: String,
+    }
+
     unsafe extern "C++" {
         include!("rust_ffi.hpp");
 
@@ -292,6 +306,27 @@ mod ffi {
             uuid: i64,
         ) -> Result<SwerveTrajectory>;
 
+        fn generate_preview(self: &SwerveTrajectoryGenerator) -> Result<SwerveTrajectory>;
+
+        fn add_buffer_callback(
+            self: Pin<&mut SwerveTrajectoryGenerator>,
+            callback: fn(&SwerveTrajectoryBuffer, i64),
+        );
+
+        fn generate_buffer(
+            self: &SwerveTrajectoryGenerator,
+            diagnostics: bool,
+            uuid: i64,
+        ) -> Result<UniquePtr<SwerveTrajectoryBuffer>>;
+
+        type SwerveTrajectoryBuffer;
+
+        fn sample_count(self: &SwerveTrajectoryBuffer) -> usize;
+
+        fn module_count(self: &SwerveTrajectoryBuffer) -> usize;
+
+        fn data(self: &SwerveTrajectoryBuffer) -> &[f64];
+
         type DifferentialTrajectoryGenerator;
 
         fn differential_trajectory_generator_new() -> UniquePtr<DifferentialTrajectoryGenerator>;
@@ -497,7 +532,47 @@ mod ffi {
             uuid: i64,
         ) -> Result<DifferentialTrajectory>;
 
-        // Cancel all generators
+        fn generate_preview(
+            self: &DifferentialTrajectoryGenerator,
+        ) -> Result<DifferentialTrajectory>;
+
+        // Batch generators
+
+        type SwerveBatchTrajectoryGenerator;
+
+        fn swerve_batch_trajectory_generator_new() -> UniquePtr<SwerveBatchTrajectoryGenerator>;
+
+        fn add_job(
+            self: Pin<&mut SwerveBatchTrajectoryGenerator>,
+            generator: &SwerveTrajectoryGenerator,
+            handle: i64,
+        );
+
+        fn generate(
+            self: &SwerveBatchTrajectoryGenerator,
+            concurrency: usize,
+            diagnostics: bool,
+        ) -> Vec<SwerveBatchResult>;
+
+        type DifferentialBatchTrajectoryGenerator;
+
+        fn differential_batch_trajectory_generator_new() -> UniquePtr<DifferentialBatchTrajectoryGenerator>;
+
+        fn add_job(
+            self: Pin<&mut DifferentialBatchTrajectoryGenerator>,
+            generator: &DifferentialTrajectoryGenerator,
+            handle: i64,
+        );
+
+        fn generate(
+            self: &DifferentialBatchTrajectoryGenerator,
+            concurrency: usize,
+            diagnostics: bool,
+        ) -> Vec<DifferentialBatchResult>;
+
+        // Cancel generators
+
+        fn cancel(handle: i64);
 
         fn cancel_all();
     }
@@ -897,6 +972,222 @@ impl SwerveTrajectoryGenerator {
             }
         }
     }
+
+    ///
+    /// Generate a preview of the trajectory without solving it.
+    ///
+    /// The path's spline initial guess is retimed so the wheels stay within
+    /// their speed and force limits, starting and ending at rest. This takes
+    /// milliseconds rather than seconds, but the path's other constraints
+    /// aren't enforced.
+    ///
+    /// Returns a result with either the preview `trajopt::SwerveTrajectory`, or a
+    /// TrajoptError if generation failed.
+    pub fn generate_preview(&self) -> Result<SwerveTrajectory, TrajoptError> {
+        match self.generator.generate_preview() {
+            Ok(trajectory) => Ok(trajectory),
+            Err(msg) => {
+                let what = msg.what();
+                Err(TrajoptError::from(
+                    what.parse::<i8>()
+                        .map_err(|_| TrajoptError::Unparsable(Box::from(what)))?,
+                ))
+            }
+        }
+    }
+
+    ///
+    /// Add a callback that will be called on each iteration of the solver with
+    /// the trajectory in column layout.
+    ///
+    /// Unlike `add_callback`, no Rust value is built per sample. Read the
+    /// columns in place with `SwerveTrajectoryBuffer::data()`, or copy them
+    /// with `SwerveTrajectoryColumns::from_buffer()`, during the call.
+    ///
+    /// * callback: a `fn` (not a closure) to be executed. The callback's first
+    ///   parameter will be a `trajopt::SwerveTrajectoryBuffer`, and the second
+    ///   parameter will be an `i64` equal to the handle passed in `generate()`
+    ///   or `generate_columns()`
+    ///
+    /// This function can be called multiple times to add multiple callbacks.
+    pub fn add_buffer_callback(&mut self, callback: fn(&SwerveTrajectoryBuffer, i64)) {
+        crate::ffi::SwerveTrajectoryGenerator::add_buffer_callback(
+            self.generator.pin_mut(),
+            callback,
+        );
+    }
+
+    ///
+    /// Generate the trajectory in column layout.
+    ///
+    /// The trajectory crosses the FFI boundary as one slice, so this costs a
+    /// single copy however many samples it has.
+    ///
+    /// * diagnostics: If true, prints per-iteration details of the solver to
+    ///   stdout.
+    /// * handle: A number used to identify results from this generation in the
+    ///   callbacks. If no callbacks were added, this value has no significance.
+    ///
+    /// Returns a result with either the final trajectory's columns, or a
+    /// TrajoptError if generation failed.
+    pub fn generate_columns(
+        &self,
+        diagnostics: bool,
+        handle: i64,
+    ) -> Result<SwerveTrajectoryColumns, TrajoptError> {
+        match self.generator.generate_buffer(diagnostics, handle) {
+            Ok(buffer) => Ok(SwerveTrajectoryColumns::from_buffer(&buffer)),
+            Err(msg) => {
+                let what = msg.what();
+                Err(TrajoptError::from(
+                    what.parse::<i8>()
+                        .map_err(|_| TrajoptError::Unparsable(Box::from(what)))?,
+                ))
+            }
+        }
+    }
+}
+
+///
+/// A per-sample field of a `SwerveTrajectoryColumns`, in column order.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum SwerveTrajectoryField {
+    Timestamp,
+    X,
+    Y,
+    Heading,
+    VelocityX,
+    VelocityY,
+    AngularVelocity,
+    AccelerationX,
+    AccelerationY,
+    AngularAcceleration,
+}
+
+impl SwerveTrajectoryField {
+    /// The number of per-sample fields.
+    pub const COUNT: usize = 10;
+}
+
+///
+/// A swerve trajectory stored as columns of one buffer.
+///
+/// The buffer holds each field of `SwerveTrajectoryField` in order, then each
+/// module's x forces, then each module's y forces, each a column with one
+/// value per sample.
+#[derive(Debug, serde::Serialize, Clone, PartialEq)]
+pub struct SwerveTrajectoryColumns {
+    sample_count: usize,
+    module_count: usize,
+    data: Vec<f64>,
+}
+
+impl<'de> serde::Deserialize<'de> for SwerveTrajectoryColumns {
+    ///
+    /// Deserialize the columns, rejecting data whose length doesn't match the
+    /// sample and module counts, so the column accessors can't index past it.
+    fn deserialize<D: serde::Deserializer<'de>>(deserializer: D) -> Result<Self, D::Error> {
+        #[derive(serde::Deserialize)]
+        #[serde(rename = "SwerveTrajectoryColumns")]
+        struct Unchecked {
+            sample_count: usize,
+            module_count: usize,
+            data: Vec<f64>,
+        }
+
+        let columns = Unchecked::deserialize(deserializer)?;
+        let expected_len = columns
+            .module_count
+            .checked_mul(2)
+            .and_then(|module_columns| module_columns.checked_add(SwerveTrajectoryField::COUNT))
+            .and_then(|column_count| column_count.checked_mul(columns.sample_count));
+        if expected_len != Some(columns.data.len()) {
+            return Err(serde::de::Error::custom(format!(
+                "data has {} values, which doesn't match {} samples of {} modules",
+                columns.data.len(),
+                columns.sample_count,
+                columns.module_count,
+            )));
+        }
+
+        Ok(SwerveTrajectoryColumns {
+            sample_count: columns.sample_count,
+            module_count: columns.module_count,
+            data: columns.data,
+        })
+    }
+}
+
+impl SwerveTrajectoryColumns {
+    ///
+    /// Copy a trajectory's columns out of a buffer with a single copy.
+    pub fn from_buffer(buffer: &SwerveTrajectoryBuffer) -> SwerveTrajectoryColumns {
+        SwerveTrajectoryColumns {
+            sample_count: buffer.sample_count(),
+            module_count: buffer.module_count(),
+            data: buffer.data().to_vec(),
+        }
+    }
+
+    pub fn sample_count(&self) -> usize {
+        self.sample_count
+    }
+
+    pub fn module_count(&self) -> usize {
+        self.module_count
+    }
+
+    ///
+    /// Every column, as described on `SwerveTrajectoryColumns`.
+    pub fn data(&self) -> &[f64] {
+        &self.data
+    }
+
+    pub fn column(&self, field: SwerveTrajectoryField) -> &[f64] {
+        self.slice(field as usize)
+    }
+
+    pub fn module_forces_x(&self, module: usize) -> &[f64] {
+        assert!(module < self.module_count);
+        self.slice(SwerveTrajectoryField::COUNT + module)
+    }
+
+    pub fn module_forces_y(&self, module: usize) -> &[f64] {
+        assert!(module < self.module_count);
+        self.slice(SwerveTrajectoryField::COUNT + self.module_count + module)
+    }
+
+    fn slice(&self, index: usize) -> &[f64] {
+        &self.data[index * self.sample_count..(index + 1) * self.sample_count]
+    }
+}
+
+impl From<&SwerveTrajectoryColumns> for SwerveTrajectory {
+    fn from(columns: &SwerveTrajectoryColumns) -> SwerveTrajectory {
+        use SwerveTrajectoryField::*;
+
+        let samples = (0..columns.sample_count())
+            .map(|index| SwerveTrajectorySample {
+                timestamp: columns.column(Timestamp)[index],
+                x: columns.column(X)[index],
+                y: columns.column(Y)[index],
+                heading: columns.column(Heading)[index],
+                velocity_x: columns.column(VelocityX)[index],
+                velocity_y: columns.column(VelocityY)[index],
+                angular_velocity: columns.column(AngularVelocity)[index],
+                acceleration_x: columns.column(AccelerationX)[index],
+                acceleration_y: columns.column(AccelerationY)[index],
+                angular_acceleration: columns.column(AngularAcceleration)[index],
+                module_forces_x: (0..columns.module_count())
+                    .map(|module| columns.module_forces_x(module)[index])
+                    .collect(),
+                module_forces_y: (0..columns.module_count())
+                    .map(|module| columns.module_forces_y(module)[index])
+                    .collect(),
+            })
+            .collect();
+        SwerveTrajectory { samples }
+    }
 }
 
 pub struct DifferentialTrajectoryGenerator {
@@ -1280,8 +1571,171 @@ impl DifferentialTrajectoryGenerator {
             }
         }
     }
+
+    ///
+    /// Generate a preview of the trajectory without solving it.
+    ///
+    /// The path's spline initial guess is retimed so the wheels stay within
+    /// their speed and force limits, starting and ending at rest. This takes
+    /// milliseconds rather than seconds, but the path's other constraints
+    /// aren't enforced.
+    ///
+    /// Returns a result with either the preview `trajopt::DifferentialTrajectory`, or a
+    /// TrajoptError if generation failed.
+    pub fn generate_preview(&self) -> Result<DifferentialTrajectory, TrajoptError> {
+        match self.generator.generate_preview() {
+            Ok(trajectory) => Ok(trajectory),
+            Err(msg) => {
+                let what = msg.what();
+                Err(TrajoptError::from(
+                    what.parse::<i8>()
+                        .map_err(|_| TrajoptError::Unparsable(Box::from(what)))?,
+                ))
+            }
+        }
+    }
+}
+
+pub struct SwerveBatchTrajectoryGenerator {
+    batch: cxx::UniquePtr<crate::ffi::SwerveBatchTrajectoryGenerator>,
+}
+
+impl Default for SwerveBatchTrajectoryGenerator {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl SwerveBatchTrajectoryGenerator {
+    pub fn new() -> SwerveBatchTrajectoryGenerator {
+        SwerveBatchTrajectoryGenerator {
+            batch: crate::ffi::swerve_batch_trajectory_generator_new(),
+        }
+    }
+
+    ///
+    /// Add a snapshot of the generator's path to the batch. Later changes to
+    /// the generator don't affect the batch.
+    ///
+    /// * generator: The generator whose path to add.
+    /// * handle: The handle passed to the path's callbacks. Passing it to
+    ///   `cancel()` cancels this job, whether it's queued or running.
+    pub fn add_job(&mut self, generator: &SwerveTrajectoryGenerator, handle: i64) {
+        crate::ffi::SwerveBatchTrajectoryGenerator::add_job(
+            self.batch.pin_mut(),
+            &generator.generator,
+            handle,
+        );
+    }
+
+    ///
+    /// Generate every job in the batch on a work-stealing thread pool.
+    ///
+    /// * concurrency: The maximum number of jobs solved at once. If zero, one
+    ///   job per hardware thread is solved at once.
+    /// * diagnostics: If true, prints per-iteration details of the solver to
+    ///   stdout.
+    ///
+    /// Returns each job's handle and result, in the order the jobs were added.
+    pub fn generate(
+        &self,
+        concurrency: usize,
+        diagnostics: bool,
+    ) -> Vec<(i64, Result<SwerveTrajectory, TrajoptError>)> {
+        self.batch
+            .generate(concurrency, diagnostics)
+            .into_iter()
+            .map(|result| {
+                if !result.exception.is_empty() {
+                    (
+                        result.handle,
+                        Err(TrajoptError::Exception(Box::from(result.exception))),
+                    )
+                } else if result.error == 0 {
+                    (result.handle, Ok(result.trajectory))
+                } else {
+                    (result.handle, Err(TrajoptError::from(result.error)))
+                }
+            })
+            .collect()
+    }
+}
+
+pub struct DifferentialBatchTrajectoryGenerator {
+    batch: cxx::UniquePtr<crate::ffi::DifferentialBatchTrajectoryGenerator>,
+}
+
+impl Default for DifferentialBatchTrajectoryGenerator {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl DifferentialBatchTrajectoryGenerator {
+    pub fn new() -> DifferentialBatchTrajectoryGenerator {
+        DifferentialBatchTrajectoryGenerator {
+            batch: crate::ffi::differential_batch_trajectory_generator_new(),
+        }
+    }
+
+    ///
+    /// Add a snapshot of the generator's path to the batch. Later changes to
+    /// the generator don't affect the batch.
+    ///
+    /// * generator: The generator whose path to add.
+    /// * handle: The handle passed to the path's callbacks. Passing it to
+    ///   `cancel()` cancels this job, whether it's queued or running.
+    pub fn add_job(&mut self, generator: &DifferentialTrajectoryGenerator, handle: i64) {
+        crate::ffi::DifferentialBatchTrajectoryGenerator::add_job(
+            self.batch.pin_mut(),
+            &generator.generator,
+            handle,
+        );
+    }
+
+    ///
+    /// Generate every job in the batch on a work-stealing thread pool.
+    ///
+    /// * concurrency: The maximum number of jobs solved at once. If zero, one
+    ///   job per hardware thread is solved at once.
+    /// * diagnostics: If true, prints per-iteration details of the solver to
+    ///   stdout.
+    ///
+    /// Returns each job's handle and result, in the order the jobs were added.
+    pub fn generate(
+        &self,
+        concurrency: usize,
+        diagnostics: bool,
+    ) -> Vec<(i64, Result<DifferentialTrajectory, TrajoptError>)> {
+        self.batch
+            .generate(concurrency, diagnostics)
+            .into_iter()
+            .map(|result| {
+                if !result.exception.is_empty() {
+                    (
+                        result.handle,
+                        Err(TrajoptError::Exception(Box::from(result.exception))),
+                    )
+                } else if result.error == 0 {
+                    (result.handle, Ok(result.trajectory))
+                } else {
+                    (result.handle, Err(TrajoptError::from(result.error)))
+                }
+            })
+            .collect()
+    }
 }
 
+///
+/// Cancel every running generation that was started with the given handle.
+///
+/// Generations started with other handles keep running.
+pub fn cancel(handle: i64) {
+    crate::ffi::cancel(handle);
+}
+
+///
+/// Cancel every running generation in this process.
 pub fn cancel_all() {
     crate::ffi::cancel_all();
 }
@@ -1293,7 +1747,81 @@ pub use ffi::DifferentialTrajectorySample;
 pub use ffi::Pose2d;
 pub use ffi::SwerveDrivetrain;
 pub use ffi::SwerveTrajectory;
+pub use ffi::SwerveTrajectoryBuffer;
 pub use ffi::SwerveTrajectorySample;
 pub use ffi::Translation2d;
 
 pub mod error;
+
+#[cfg(test)]
+mod tests {
+    use std::sync::Mutex;
+
+    use super::*;
+
+    // cancel_all() reaches every generation in the process, so tests that
+    // cancel mustn't run at the same time
+    static CANCELLING: Mutex<()> = Mutex::new(());
+
+    fn generator() -> SwerveTrajectoryGenerator {
+        let mut generator = SwerveTrajectoryGenerator::new();
+        generator.set_drivetrain(&SwerveDrivetrain {
+            mass: 45.0,
+            moi: 6.0,
+            wheel_radius: 0.04,
+            wheel_max_angular_velocity: 70.0,
+            wheel_max_torque: 2.0,
+            wheel_cof: 1.5,
+            modules: vec![
+                Translation2d { x: 0.6, y: 0.6 },
+                Translation2d { x: 0.6, y: -0.6 },
+                Translation2d { x: -0.6, y: 0.6 },
+                Translation2d { x: -0.6, y: -0.6 },
+            ],
+        });
+        generator.pose_wpt(0, 0.0, 0.0, 0.0);
+        generator.pose_wpt(1, 4.0, 2.0, 1.0);
+        generator.set_control_interval_counts(vec![20]);
+        generator
+    }
+
+    /// Solves three jobs one at a time. The first job's callback runs on each
+    /// of its iterations, while the other two are queued behind it.
+    fn generate_cancelling(
+        callback: fn(SwerveTrajectory, i64),
+    ) -> Vec<(i64, Result<SwerveTrajectory, TrajoptError>)> {
+        let mut first = generator();
+        first.add_callback(callback);
+
+        let mut batch = SwerveBatchTrajectoryGenerator::new();
+        batch.add_job(&first, 1);
+        batch.add_job(&generator(), 2);
+        batch.add_job(&generator(), 3);
+        batch.generate(1, false)
+    }
+
+    #[test]
+    fn cancel_stops_only_its_handle() {
+        let _lock = CANCELLING.lock().unwrap();
+
+        let results = generate_cancelling(|_, _| cancel(3));
+
+        assert_eq!(results[0].0, 1);
+        assert!(results[0].1.is_ok());
+        assert_eq!(results[1].0, 2);
+        assert!(results[1].1.is_ok());
+        assert_eq!(results[2].0, 3);
+        assert!(results[2].1.is_err());
+    }
+
+    #[test]
+    fn cancel_all_stops_every_handle() {
+        let _lock = CANCELLING.lock().unwrap();
+
+        let results = generate_cancelling(|_, _| cancel_all());
+
+        for (_, result) in results {
+            assert!(result.is_err());
+        }
+    }
+}
@@ -0,0 +1,299 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/point_mass_trajectory_generator.hpp"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sleipnir/optimization/problem.hpp>
+#include <sleipnir/optimization/solver/exit_status.hpp>
+
+#include "trajopt/geometry/rotation2.hpp"
+#include "trajopt/util/compact_constraints.hpp"
+#include "trajopt/util/distribute_module_forces.hpp"
+#include "trajopt/util/formulation.hpp"
+#include "trajopt/util/generation_stats.hpp"
+#include "trajopt/util/time_parameterize_initial_guess.hpp"
+#include "trajopt/util/trajopt_util.hpp"
+#include "util/generator_common.hpp"
+
+// Physics notation in this file:
+//
+//   x = linear position
+//   v = linear velocity
+//   a = linear acceleration
+//   θ = heading
+//   ω = angular velocity
+//   α = angular acceleration
+//   F = force
+//   τ = torque
+//   t = time
+//
+// A `d` prefix to one of these means delta.
+
+namespace trajopt {
+
+PointMassTrajectoryGenerator::PointMassTrajectoryGenerator(
+    SwervePathBuilder path_builder, int64_t handle)
+    : path(path_builder.get_path()),
+      Ns(path_builder.get_control_interval_counts()) {
+  using std::chrono::steady_clock;
+  using seconds = std::chrono::duration<double>;
+
+  auto construction_start = steady_clock::now();
+  auto initial_guess = path_builder.calculate_linear_initial_guess();
+  time_parameterize_initial_guess(initial_guess, Ns, path.drivetrain);
+  seconds initial_guess_time = steady_clock::now() - construction_start;
+
+  // Obstacles near a segment's initial guess are applied like segment
+  // constraints. The full problem checks the others.
+  path_builder.apply_obstacle_constraints(path, initial_guess);
+
+  generation_stats.removed_duplicate_constraints =
+      compact_constraints(path, Ns);
+
+  problem.add_callback(
+      [this, handle = handle](const slp::IterationInfo<double>&) -> bool {
+        auto now = steady_clock::now();
+        ++generation_stats.iterations;
+
+        detail::send_to_callbacks(
+            path, handle, now, last_callback_time,
+            [this] { return construct_swerve_solution(); });
+
+        generation_stats.callback_time +=
+            seconds{steady_clock::now() - now}.count();
+
+        return cancellation_token.is_cancelled();
+      });
+
+  size_t wpt_cnt = path.waypoints.size();
+  size_t samp_tot = get_index(Ns, wpt_cnt - 1, 0) + 1;
+  const auto& drivetrain = path.drivetrain;
+  size_t module_cnt = drivetrain.modules.size();
+
+  x.reserve(samp_tot);
+  y.reserve(samp_tot);
+  cosθ.reserve(samp_tot);
+  sinθ.reserve(samp_tot);
+  vx.reserve(samp_tot);
+  vy.reserve(samp_tot);
+  ω.reserve(samp_tot);
+  ax.reserve(samp_tot);
+  ay.reserve(samp_tot);
+  α.reserve(samp_tot);
+  dts.reserve(samp_tot);
+
+  for (size_t index = 0; index < samp_tot; ++index) {
+    x.emplace_back(problem.decision_variable());
+    y.emplace_back(problem.decision_variable());
+    cosθ.emplace_back(problem.decision_variable());
+    sinθ.emplace_back(problem.decision_variable());
+    vx.emplace_back(problem.decision_variable());
+    vy.emplace_back(problem.decision_variable());
+    ω.emplace_back(problem.decision_variable());
+    ax.emplace_back(problem.decision_variable());
+    ay.emplace_back(problem.decision_variable());
+    α.emplace_back(problem.decision_variable());
+    dts.emplace_back(problem.decision_variable());
+  }
+
+  generation_stats.decision_variable_counts = {{"states", 10 * samp_tot},
+                                               {"time steps", samp_tot}};
+
+  // Minimize total time
+  detail::minimize_total_time(problem, dts, Ns, initial_guess.dt);
+
+  // Apply kinematics constraints
+  for (size_t wpt_index = 0; wpt_index < wpt_cnt - 1; ++wpt_index) {
+    size_t N_sgmt = Ns.at(wpt_index);
+
+    for (size_t sample_index = 0; sample_index < N_sgmt; ++sample_index) {
+      size_t index = get_index(Ns, wpt_index, sample_index);
+
+      Translation2v<double> x_k{x.at(index), y.at(index)};
+      Translation2v<double> x_k_1{x.at(index + 1), y.at(index + 1)};
+
+      Rotation2v<double> θ_k{cosθ.at(index), sinθ.at(index)};
+      Rotation2v<double> θ_k_1{cosθ.at(index + 1), sinθ.at(index + 1)};
+
+      Translation2v<double> v_k{vx.at(index), vy.at(index)};
+      Translation2v<double> v_k_1{vx.at(index + 1), vy.at(index + 1)};
+
+      auto ω_k = ω.at(index);
+      auto ω_k_1 = ω.at(index + 1);
+
+      Translation2v<double> a_k{ax.at(index), ay.at(index)};
+      auto α_k = α.at(index);
+
+      auto dt_k = dts.at(index);
+      if (sample_index < N_sgmt - 1) {
+        auto dt_k_1 = dts.at(index + 1);
+        problem.subject_to(dt_k_1 == dt_k);
+      }
+
+      auto dt_k_sq = dt_k * dt_k;
+
+      // xₖ₊₁ = xₖ + vₖt + 1/2aₖt²
+      // θₖ₊₁ = θₖ + ωₖt + 1/2αₖt²
+      // vₖ₊₁ = vₖ + aₖt
+      // ωₖ₊₁ = ωₖ + αₖt
+      problem.subject_to(x_k_1 == x_k + v_k * dt_k + a_k * 0.5 * dt_k_sq);
+      problem.subject_to(θ_k_1 == θ_k + Rotation2v<double>{ω_k * dt_k} +
+                                      Rotation2v<double>{α_k * 0.5 * dt_k_sq});
+      problem.subject_to(v_k_1 == v_k + a_k * dt_k);
+      problem.subject_to(ω_k_1 == ω_k + α_k * dt_k);
+    }
+  }
+
+  const double v_max =
+      drivetrain.wheel_radius * drivetrain.wheel_max_angular_velocity;
+
+  // Matches SwerveTrajectoryGenerator's limit on each module's force
+  const double F_max =
+      std::min(drivetrain.wheel_max_torque / drivetrain.wheel_radius,
+               drivetrain.wheel_cof * drivetrain.mass * 9.8 /
+                   detail::swerve_num_wheels);
+
+  double r_sq_sum = 0.0;
+  for (const auto& module : drivetrain.modules) {
+    r_sq_sum += module.squared_norm();
+  }
+
+  for (size_t index = 0; index < samp_tot; ++index) {
+    Rotation2v<double> θ_k{cosθ.at(index), sinθ.at(index)};
+    Translation2v<double> v_k{vx.at(index), vy.at(index)};
+    Translation2v<double> a_k{ax.at(index), ay.at(index)};
+
+    // Apply module power constraints
+    auto v_wrt_robot = v_k.rotate_by(-θ_k);
+    for (const auto& translation : drivetrain.modules) {
+      Translation2v<double> v_wheel_wrt_robot{
+          v_wrt_robot.x() - translation.y() * ω.at(index),
+          v_wrt_robot.y() + translation.x() * ω.at(index)};
+
+      // |v|₂² ≤ vₘₐₓ²
+      problem.subject_to(v_wheel_wrt_robot.squared_norm() <= v_max * v_max);
+    }
+
+    // Bound the net force and torque by what the modules provide together.
+    // Each module pushing with Fₘₐₓ at an angle φ from the net force gives
+    //
+    //   |ΣF| = nFₘₐₓ cos φ
+    //   Στ = nFₘₐₓ r sin φ
+    //
+    // where r is the modules' root-mean-square distance from the origin, so
+    //
+    //   (ma)² + n(Jα)²/Σr² ≤ (nFₘₐₓ)²
+    //
+    // Modules at the origin can't turn the robot, so it doesn't.
+    const double n = static_cast<double>(module_cnt);
+    auto F_sq = (a_k * drivetrain.mass).squared_norm();
+    if (r_sq_sum > 0.0) {
+      auto τ = drivetrain.moi * α.at(index);
+      problem.subject_to(F_sq + n * τ * τ / r_sq_sum <= n * n * F_max * F_max);
+    } else {
+      problem.subject_to(α.at(index) == 0.0);
+      problem.subject_to(F_sq <= n * n * F_max * F_max);
+    }
+  }
+
+  // Kinematics constrain each control interval, and dynamics each sample
+  auto& constraint_counts = generation_stats.constraint_counts;
+  constraint_counts["kinematics"] = samp_tot - 1;
+  constraint_counts["dynamics"] = samp_tot;
+
+  // The problem isn't parametric, so parametric constraints are applied with
+  // constants
+  auto make_constants = [](const std::vector<double>& values) {
+    return std::vector<slp::Variable<double>>(values.begin(), values.end());
+  };
+  auto defer_none = [](const Constraint&, size_t) { return false; };
+  detail::apply_swerve_path_constraints(
+      problem,
+      detail::SwerveStateVariables{x, y, cosθ, sinθ, vx, vy, ω, ax, ay, α},
+      path, Ns, generation_stats, make_constants, defer_none);
+
+  auto initial_guess_start = steady_clock::now();
+  for (size_t index = 0; index < samp_tot; ++index) {
+    x[index].set_value(initial_guess.x[index]);
+    y[index].set_value(initial_guess.y[index]);
+    cosθ[index].set_value(initial_guess.thetacos[index]);
+    sinθ[index].set_value(initial_guess.thetasin[index]);
+    vx[index].set_value(initial_guess.vx[index]);
+    vy[index].set_value(initial_guess.vy[index]);
+    ω[index].set_value(initial_guess.omega[index]);
+    ax[index].set_value(initial_guess.ax[index]);
+    ay[index].set_value(initial_guess.ay[index]);
+    α[index].set_value(initial_guess.alpha[index]);
+  }
+  initial_guess_time += steady_clock::now() - initial_guess_start;
+
+  generation_stats.initial_guess_time = initial_guess_time.count();
+  generation_stats.construction_time =
+      seconds{steady_clock::now() - construction_start}.count() -
+      generation_stats.initial_guess_time;
+}
+
+std::expected<SwerveSolution, slp::ExitStatus>
+PointMassTrajectoryGenerator::generate(bool diagnostics,
+                                       GenerationStats* stats) {
+  using std::chrono::steady_clock;
+
+  generation_stats.iterations = 0;
+  generation_stats.callback_time = 0.0;
+
+  auto solve_start_time = steady_clock::now();
+
+  auto status = problem.solve(
+      {.tolerance = SOLVER_TOLERANCE, .diagnostics = diagnostics});
+
+  std::chrono::duration<double> solve_time =
+      steady_clock::now() - solve_start_time;
+  generation_stats.solve_time =
+      solve_time.count() - generation_stats.callback_time;
+  generation_stats.peak_memory = peak_memory_usage();
+  if (stats != nullptr) {
+    *stats = generation_stats;
+  }
+
+  if (detail::failed(status)) {
+    return std::unexpected{status};
+  } else {
+    return construct_swerve_solution();
+  }
+}
+
+SwerveSolution PointMassTrajectoryGenerator::construct_swerve_solution() {
+  auto values = [](std::vector<slp::Variable<double>>& row) {
+    std::vector<double> result;
+    result.reserve(row.size());
+    for (auto& variable : row) {
+      result.push_back(variable.value());
+    }
+    return result;
+  };
+
+  SwerveSolution solution{.dt = values(dts),
+                          .x = values(x),
+                          .y = values(y),
+                          .thetacos = values(cosθ),
+                          .thetasin = values(sinθ),
+                          .vx = values(vx),
+                          .vy = values(vy),
+                          .omega = values(ω),
+                          .ax = values(ax),
+                          .ay = values(ay),
+                          .alpha = values(α),
+                          .module_fx = {},
+                          .module_fy = {}};
+  distribute_module_forces(solution, path.drivetrain);
+  return solution;
+}
+
+}  // namespace trajopt
@@ -5,11 +5,19 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "trajopt/batch_trajectory_generator.hpp"
 #include "trajopt/constraint/angular_velocity_max_magnitude_constraint.hpp"
 #include "trajopt/constraint/lane_constraint.hpp"
 #include "trajopt/constraint/linear_acceleration_max_magnitude_constraint.hpp"
@@ -23,6 +31,212 @@
 
 namespace trajopt::rsffi {
 
+namespace {
+
+/// Cancellation tokens of the solves currently running through the FFI, keyed
+/// by the handle passed to generate().
+class CancellationRegistry {
+ public:
+  /// Registers a running solve's token for the lifetime of this object.
+  class Registration {
+   public:
+    Registration(int64_t handle, const trajopt::CancellationToken& token) {
+      auto& registry = CancellationRegistry::instance();
+      std::scoped_lock lock{registry.m_mutex};
+      m_entry = registry.m_tokens.emplace(handle, token);
+    }
+
+    Registration(const Registration&) = delete;
+    Registration& operator=(const Registration&) = delete;
+
+    ~Registration() {
+      auto& registry = CancellationRegistry::instance();
+      std::scoped_lock lock{registry.m_mutex};
+      registry.m_tokens.erase(m_entry);
+    }
+
+   private:
+    std::unordered_multimap<int64_t, trajopt::CancellationToken>::iterator
+        m_entry;
+  };
+
+  static CancellationRegistry& instance() {
+    static CancellationRegistry registry;
+    return registry;
+  }
+
+  void cancel(int64_t handle) {
+    std::scoped_lock lock{m_mutex};
+    auto [begin, end] = m_tokens.equal_range(handle);
+    for (auto it = begin; it != end; ++it) {
+      it->second.cancel();
+    }
+  }
+
+  void cancel_all() {
+    std::scoped_lock lock{m_mutex};
+    for (auto& entry : m_tokens) {
+      entry.second.cancel();
+    }
+  }
+
+ private:
+  std::mutex m_mutex;
+  std::unordered_multimap<int64_t, trajopt::CancellationToken> m_tokens;
+};
+
+/// Converts a swerve solution to the Rust trajectory type.
+SwerveTrajectory to_rust_trajectory(const trajopt::SwerveSolution& solution) {
+  using enum trajopt::FlatSwerveTrajectory::Field;
+
+  // Read the solution through the flat layout, so building the Rust samples
+  // doesn't first build a C++ sample with its own force vectors per sample
+  trajopt::FlatSwerveTrajectory flat{solution};
+
+  rust::Vec<SwerveTrajectorySample> rust_samples;
+  rust_samples.reserve(flat.size());
+  for (size_t index = 0; index < flat.size(); ++index) {
+    rust::Vec<double> fx;
+    rust::Vec<double> fy;
+    fx.reserve(flat.module_count());
+    fy.reserve(flat.module_count());
+    for (size_t module = 0; module < flat.module_count(); ++module) {
+      fx.push_back(flat.module_forces_x(module)[index]);
+      fy.push_back(flat.module_forces_y(module)[index]);
+    }
+
+    rust_samples.push_back(SwerveTrajectorySample{
+        flat.column(TIMESTAMP)[index], flat.column(X)[index],
+        flat.column(Y)[index], flat.column(HEADING)[index],
+        flat.column(VELOCITY_X)[index], flat.column(VELOCITY_Y)[index],
+        flat.column(ANGULAR_VELOCITY)[index],
+        flat.column(ACCELERATION_X)[index], flat.column(ACCELERATION_Y)[index],
+        flat.column(ANGULAR_ACCELERATION)[index], std::move(fx),
+        std::move(fy)});
+  }
+
+  return SwerveTrajectory{std::move(rust_samples)};
+}
+
+/// Converts a differential solution to the Rust trajectory type.
+DifferentialTrajectory to_rust_trajectory(
+    const trajopt::DifferentialSolution& solution) {
+  trajopt::DifferentialTrajectory cpp_trajectory{solution};
+
+  rust::Vec<DifferentialTrajectorySample> rust_samples;
+  for (const auto& cpp_sample : cpp_trajectory.samples) {
+    rust_samples.push_back(DifferentialTrajectorySample{
+        cpp_sample.timestamp, cpp_sample.x, cpp_sample.y, cpp_sample.heading,
+        cpp_sample.velocity_l, cpp_sample.velocity_r,
+        cpp_sample.angular_velocity, cpp_sample.acceleration_l,
+        cpp_sample.acceleration_r, cpp_sample.angular_acceleration,
+        cpp_sample.force_l, cpp_sample.force_r});
+  }
+
+  return DifferentialTrajectory{std::move(rust_samples)};
+}
+
+/// Calls Rust callbacks with a solve's progress from a separate thread, so
+/// converting the solver's intermediate solutions to Rust types never blocks
+/// the solver.
+class ProgressForwarder {
+ public:
+  /// Constructs a ProgressForwarder.
+  ///
+  /// @param generator The generator whose progress to forward.
+  /// @param enabled Whether there are any callbacks to forward progress to.
+  /// @param forward Converts a solution and calls the callbacks with it.
+  template <typename Generator, typename Forward>
+  ProgressForwarder(Generator& generator, bool enabled, Forward forward) {
+    if (!enabled) {
+      return;
+    }
+
+    m_thread = std::jthread{[channel = generator.open_progress_channel(),
+                             forward = std::move(forward)](
+                                std::stop_token stop_token) {
+      std::chrono::duration<double> period{1.0 / channel->options().rate};
+      std::mutex mutex;
+      std::condition_variable_any stopped;
+      std::unique_lock lock{mutex};
+
+      while (true) {
+        if (channel->receive()) {
+          forward(channel->read_buffer());
+        }
+
+        // Wait for the next update, waking early if the solve finished
+        if (stopped.wait_for(lock, stop_token, period, [&] {
+              return stop_token.stop_requested();
+            })) {
+          break;
+        }
+      }
+    }};
+  }
+
+ private:
+  std::jthread m_thread;
+};
+
+/// Calls swerve callbacks with a solution, converting it once for each
+/// layout that has callbacks.
+void call_swerve_callbacks(
+    const std::vector<rust::Fn<void(SwerveTrajectory, int64_t)>>& callbacks,
+    const std::vector<rust::Fn<void(const SwerveTrajectoryBuffer&, int64_t)>>&
+        buffer_callbacks,
+    const trajopt::SwerveSolution& solution, int64_t handle) {
+  if (!callbacks.empty()) {
+    auto trajectory = to_rust_trajectory(solution);
+    for (const auto& callback : callbacks) {
+      callback(trajectory, handle);
+    }
+  }
+
+  if (!buffer_callbacks.empty()) {
+    SwerveTrajectoryBuffer buffer{trajopt::FlatSwerveTrajectory{solution}};
+    for (const auto& callback : buffer_callbacks) {
+      callback(buffer, handle);
+    }
+  }
+}
+
+/// Returns the message of an exception a batch job threw.
+rust::String exception_message(const std::exception_ptr& exception) {
+  try {
+    std::rethrow_exception(exception);
+  } catch (const std::exception& e) {
+    return rust::String{e.what()};
+  } catch (...) {
+    return rust::String{"unknown exception"};
+  }
+}
+
+/// Converts a batch generation's results to the Rust result type.
+template <typename RustResult, typename Solution>
+rust::Vec<RustResult> to_rust_batch_results(
+    const std::vector<trajopt::BatchResult<Solution>>& results) {
+  rust::Vec<RustResult> rust_results;
+  for (const auto& result : results) {
+    if (result.exception != nullptr) {
+      rust_results.push_back(RustResult{result.handle, {}, 0,
+                                        exception_message(result.exception)});
+    } else if (result.solution.has_value()) {
+      rust_results.push_back(RustResult{
+          result.handle, to_rust_trajectory(result.solution.value()), 0, {}});
+    } else {
+      rust_results.push_back(
+          RustResult{result.handle,
+                     {},
+                     std::to_underlying(result.solution.error()),
+                     {}});
+    }
+  }
+  return rust_results;
+}
+
+}  // namespace
+
 void SwerveTrajectoryGenerator::set_drivetrain(
     const SwerveDrivetrain& drivetrain) {
   std::vector<trajopt::Translation2d> cpp_modules;
@@ -315,57 +529,56 @@ void SwerveTrajectoryGenerator::sgmt_keep_out_circle(size_t from_index,
 
 void SwerveTrajectoryGenerator::add_callback(
     rust::Fn<void(SwerveTrajectory, int64_t)> callback) {
-  path_builder.add_callback(
-      [=](const trajopt::SwerveSolution& solution, int64_t handle) {
-        trajopt::SwerveTrajectory cpp_trajectory{solution};
-
-        rust::Vec<SwerveTrajectorySample> rust_samples;
-        for (const auto& cpp_sample : cpp_trajectory.samples) {
-          rust::Vec<double> fx;
-          std::copy(cpp_sample.module_forces_x.begin(),
-                    cpp_sample.module_forces_x.end(), std::back_inserter(fx));
-
-          rust::Vec<double> fy;
-          std::copy(cpp_sample.module_forces_y.begin(),
-                    cpp_sample.module_forces_y.end(), std::back_inserter(fy));
-
-          rust_samples.push_back(SwerveTrajectorySample{
-              cpp_sample.timestamp, cpp_sample.x, cpp_sample.y,
-              cpp_sample.heading, cpp_sample.velocity_x, cpp_sample.velocity_y,
-              cpp_sample.angular_velocity, cpp_sample.acceleration_x,
-              cpp_sample.acceleration_y, cpp_sample.angular_acceleration,
-              std::move(fx), std::move(fy)});
-        }
+  callbacks.push_back(callback);
+}
 
-        callback(SwerveTrajectory{rust_samples}, handle);
-      });
+void SwerveTrajectoryGenerator::add_buffer_callback(
+    rust::Fn<void(const SwerveTrajectoryBuffer&, int64_t)> callback) {
+  buffer_callbacks.push_back(callback);
+}
+
+trajopt::SwervePathBuilder SwerveTrajectoryGenerator::get_path_builder()
+    const {
+  auto path_builder_with_callbacks = path_builder;
+  if (!callbacks.empty() || !buffer_callbacks.empty()) {
+    path_builder_with_callbacks.add_callback(
+        [callbacks = callbacks, buffer_callbacks = buffer_callbacks](
+            const trajopt::SwerveSolution& solution, int64_t handle) {
+          call_swerve_callbacks(callbacks, buffer_callbacks, solution, handle);
+        });
+  }
+  return path_builder_with_callbacks;
 }
 
 SwerveTrajectory SwerveTrajectoryGenerator::generate(bool diagnostics,
                                                      int64_t handle) const {
+  return to_rust_trajectory(solve(diagnostics, handle));
+}
+
+SwerveTrajectory SwerveTrajectoryGenerator::generate_preview() const {
+  trajopt::SwervePreviewTrajectoryGenerator generator{path_builder};
+  return to_rust_trajectory(generator.generate());
+}
+
+std::unique_ptr<SwerveTrajectoryBuffer>
+SwerveTrajectoryGenerator::generate_buffer(bool diagnostics,
+                                           int64_t handle) const {
+  return std::make_unique<SwerveTrajectoryBuffer>(
+      trajopt::FlatSwerveTrajectory{solve(diagnostics, handle)});
+}
+
+trajopt::SwerveSolution SwerveTrajectoryGenerator::solve(bool diagnostics,
+                                                         int64_t handle) const {
   trajopt::SwerveTrajectoryGenerator generator{path_builder, handle};
+  CancellationRegistry::Registration registration{
+      handle, generator.get_cancellation_token()};
+  ProgressForwarder forwarder{
+      generator, !callbacks.empty() || !buffer_callbacks.empty(),
+      [&](const trajopt::SwerveSolution& solution) {
+        call_swerve_callbacks(callbacks, buffer_callbacks, solution, handle);
+      }};
   if (auto sol = generator.generate(diagnostics); sol.has_value()) {
-    trajopt::SwerveTrajectory cpp_trajectory{sol.value()};
-
-    rust::Vec<SwerveTrajectorySample> rust_samples;
-    for (const auto& cpp_sample : cpp_trajectory.samples) {
-      rust::Vec<double> fx;
-      std::copy(cpp_sample.module_forces_x.begin(),
-                cpp_sample.module_forces_x.end(), std::back_inserter(fx));
-
-      rust::Vec<double> fy;
-      std::copy(cpp_sample.module_forces_y.begin(),
-                cpp_sample.module_forces_y.end(), std::back_inserter(fy));
-
-      rust_samples.push_back(SwerveTrajectorySample{
-          cpp_sample.timestamp, cpp_sample.x, cpp_sample.y, cpp_sample.heading,
-          cpp_sample.velocity_x, cpp_sample.velocity_y,
-          cpp_sample.angular_velocity, cpp_sample.acceleration_x,
-          cpp_sample.acceleration_y, cpp_sample.angular_acceleration,
-          std::move(fx), std::move(fy)});
-    }
-
-    return SwerveTrajectory{std::move(rust_samples)};
+    return std::move(sol.value());
   } else {
     throw sol.error();
   }
@@ -653,51 +866,107 @@ void DifferentialTrajectoryGenerator::sgmt_keep_out_circle(size_t from_index,
 
 void DifferentialTrajectoryGenerator::add_callback(
     rust::Fn<void(DifferentialTrajectory, int64_t)> callback) {
-  path_builder.add_callback([=](const trajopt::DifferentialSolution& solution,
-                                int64_t handle) {
-    trajopt::DifferentialTrajectory cpp_trajectory{solution};
-
-    rust::Vec<DifferentialTrajectorySample> rust_samples;
-    for (const auto& cpp_sample : cpp_trajectory.samples) {
-      rust_samples.push_back(DifferentialTrajectorySample{
-          cpp_sample.timestamp, cpp_sample.x, cpp_sample.y, cpp_sample.heading,
-          cpp_sample.velocity_l, cpp_sample.velocity_r,
-          cpp_sample.angular_velocity, cpp_sample.acceleration_l,
-          cpp_sample.acceleration_r, cpp_sample.force_l, cpp_sample.force_r});
-    }
+  callbacks.push_back(callback);
+}
 
-    callback(DifferentialTrajectory{rust_samples}, handle);
-  });
+trajopt::DifferentialPathBuilder
+DifferentialTrajectoryGenerator::get_path_builder() const {
+  auto path_builder_with_callbacks = path_builder;
+  for (const auto& callback : callbacks) {
+    path_builder_with_callbacks.add_callback(
+        [=](const trajopt::DifferentialSolution& solution, int64_t handle) {
+          callback(to_rust_trajectory(solution), handle);
+        });
+  }
+  return path_builder_with_callbacks;
 }
 
 DifferentialTrajectory DifferentialTrajectoryGenerator::generate(
     bool diagnostics, int64_t handle) const {
   trajopt::DifferentialTrajectoryGenerator generator{path_builder, handle};
+  CancellationRegistry::Registration registration{
+      handle, generator.get_cancellation_token()};
+  ProgressForwarder forwarder{
+      generator, !callbacks.empty(),
+      [&](const trajopt::DifferentialSolution& solution) {
+        auto trajectory = to_rust_trajectory(solution);
+        for (const auto& callback : callbacks) {
+          callback(trajectory, handle);
+        }
+      }};
   if (auto sol = generator.generate(diagnostics); sol.has_value()) {
-    trajopt::DifferentialTrajectory cpp_trajectory{sol.value()};
-
-    rust::Vec<DifferentialTrajectorySample> rust_samples;
-    for (const auto& cpp_sample : cpp_trajectory.samples) {
-      rust_samples.push_back(DifferentialTrajectorySample{
-          cpp_sample.timestamp, cpp_sample.x, cpp_sample.y, cpp_sample.heading,
-          cpp_sample.velocity_l, cpp_sample.velocity_r,
-          cpp_sample.angular_velocity, cpp_sample.acceleration_l,
-          cpp_sample.acceleration_r, cpp_sample.force_l, cpp_sample.force_r});
-    }
-
-    return DifferentialTrajectory{std::move(rust_samples)};
+    return to_rust_trajectory(sol.value());
   } else {
     throw sol.error();
   }
 }
 
+DifferentialTrajectory DifferentialTrajectoryGenerator::generate_preview()
+    const {
+  trajopt::DifferentialPreviewTrajectoryGenerator generator{path_builder};
+  return to_rust_trajectory(generator.generate());
+}
+
 std::unique_ptr<DifferentialTrajectoryGenerator>
 differential_trajectory_generator_new() {
   return std::make_unique<DifferentialTrajectoryGenerator>();
 }
 
+void SwerveBatchTrajectoryGenerator::add_job(
+    const SwerveTrajectoryGenerator& generator, int64_t handle) {
+  tokens.emplace_back(handle,
+                      batch.add_job(generator.get_path_builder(), handle));
+}
+
+rust::Vec<SwerveBatchResult> SwerveBatchTrajectoryGenerator::generate(
+    size_t concurrency, bool diagnostics) const {
+  std::vector<std::unique_ptr<CancellationRegistry::Registration>>
+      registrations;
+  for (const auto& [handle, token] : tokens) {
+    registrations.push_back(
+        std::make_unique<CancellationRegistry::Registration>(handle, token));
+  }
+
+  return to_rust_batch_results<SwerveBatchResult>(
+      batch.generate(concurrency, diagnostics));
+}
+
+std::unique_ptr<SwerveBatchTrajectoryGenerator>
+swerve_batch_trajectory_generator_new() {
+  return std::make_unique<SwerveBatchTrajectoryGenerator>();
+}
+
+void DifferentialBatchTrajectoryGenerator::add_job(
+    const DifferentialTrajectoryGenerator& generator, int64_t handle) {
+  tokens.emplace_back(handle,
+                      batch.add_job(generator.get_path_builder(), handle));
+}
+
+rust::Vec<DifferentialBatchResult>
+DifferentialBatchTrajectoryGenerator::generate(size_t concurrency,
+                                               bool diagnostics) const {
+  std::vector<std::unique_ptr<CancellationRegistry::Registration>>
+      registrations;
+  for (const auto& [handle, token] : tokens) {
+    registrations.push_back(
+        std::make_unique<CancellationRegistry::Registration>(handle, token));
+  }
+
+  return to_rust_batch_results<DifferentialBatchResult>(
+      batch.generate(concurrency, diagnostics));
+}
+
+std::unique_ptr<DifferentialBatchTrajectoryGenerator>
+differential_batch_trajectory_generator_new() {
+  return std::make_unique<DifferentialBatchTrajectoryGenerator>();
+}
+
+void cancel(int64_t handle) {
+  CancellationRegistry::instance().cancel(handle);
+}
+
 void cancel_all() {
-  trajopt::get_cancellation_flag() = 1;
+  CancellationRegistry::instance().cancel_all();
 }
 
 }  // namespace trajopt::rsffi
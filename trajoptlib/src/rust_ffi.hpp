@@ -6,11 +6,14 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <rust/cxx.h>
 #include <sleipnir/optimization/solver/exit_status.hpp>
 
+#include "trajopt/batch_trajectory_generator.hpp"
 #include "trajopt/differential_trajectory_generator.hpp"
+#include "trajopt/preview_trajectory_generator.hpp"
 #include "trajopt/swerve_trajectory_generator.hpp"
 
 // override cxx try/catch so it catches thrown integers/exit conditions
@@ -29,10 +32,35 @@ namespace trajopt::rsffi {
 
 struct SwerveTrajectory;
 struct DifferentialTrajectory;
+struct SwerveBatchResult;
+struct DifferentialBatchResult;
 struct Pose2d;
 struct SwerveDrivetrain;
 struct DifferentialDrivetrain;
 
+/// A swerve trajectory in the column layout of trajopt::FlatSwerveTrajectory,
+/// which Rust reads as one slice instead of sample by sample.
+class SwerveTrajectoryBuffer {
+ public:
+  explicit SwerveTrajectoryBuffer(trajopt::FlatSwerveTrajectory trajectory)
+      : trajectory{std::move(trajectory)} {}
+
+  /// Returns the number of samples.
+  size_t sample_count() const { return trajectory.size(); }
+
+  /// Returns the number of modules.
+  size_t module_count() const { return trajectory.module_count(); }
+
+  /// Returns every column, as laid out by trajopt::FlatSwerveTrajectory.
+  rust::Slice<const double> data() const {
+    auto data = trajectory.data();
+    return rust::Slice<const double>{data.data(), data.size()};
+  }
+
+ private:
+  trajopt::FlatSwerveTrajectory trajectory;
+};
+
 class SwerveTrajectoryGenerator {
  public:
   SwerveTrajectoryGenerator() = default;
@@ -104,8 +132,42 @@ class SwerveTrajectoryGenerator {
   // https://github.com/dtolnay/cxx/issues/1052
   SwerveTrajectory generate(bool diagnostics = false, int64_t handle = 0) const;
 
+  /// Generates a preview trajectory by retiming the path's spline initial
+  /// guess, without solving the optimization problem.
+  SwerveTrajectory generate_preview() const;
+
+  /// Add a callback that will be called on each iteration of the solver with
+  /// the trajectory in column layout.
+  ///
+  /// Unlike add_callback(), the trajectory is passed without building a Rust
+  /// value per sample. The buffer is only valid during the call.
+  ///
+  /// @param callback A `fn` (not a closure) to be executed. The callback's
+  ///     first parameter will be a `trajopt::SwerveTrajectoryBuffer`, and the
+  ///     second parameter will be an `i64` equal to the handle passed in
+  ///     `generate()` or `generate_buffer()`.
+  void add_buffer_callback(
+      rust::Fn<void(const SwerveTrajectoryBuffer&, int64_t)> callback);
+
+  /// Generates a trajectory in column layout.
+  ///
+  /// @param diagnostics Enables diagnostic prints.
+  /// @param handle The handle passed to the callbacks and to cancel().
+  std::unique_ptr<SwerveTrajectoryBuffer> generate_buffer(
+      bool diagnostics = false, int64_t handle = 0) const;
+
+  /// Returns the path built so far with the callbacks attached to it, for
+  /// solves that call them on the solver thread.
+  trajopt::SwervePathBuilder get_path_builder() const;
+
  private:
   trajopt::SwervePathBuilder path_builder;
+  std::vector<rust::Fn<void(SwerveTrajectory, int64_t)>> callbacks;
+  std::vector<rust::Fn<void(const SwerveTrajectoryBuffer&, int64_t)>>
+      buffer_callbacks;
+
+  /// Solves the path, forwarding progress to every callback.
+  trajopt::SwerveSolution solve(bool diagnostics, int64_t handle) const;
 };
 
 class DifferentialTrajectoryGenerator {
@@ -182,8 +244,64 @@ class DifferentialTrajectoryGenerator {
   DifferentialTrajectory generate(bool diagnostics = false,
                                   int64_t handle = 0) const;
 
+  /// Generates a preview trajectory by retiming the path's spline initial
+  /// guess, without solving the optimization problem.
+  DifferentialTrajectory generate_preview() const;
+
+  /// Returns the path built so far with the callbacks attached to it, for
+  /// solves that call them on the solver thread.
+  trajopt::DifferentialPathBuilder get_path_builder() const;
+
  private:
   trajopt::DifferentialPathBuilder path_builder;
+  std::vector<rust::Fn<void(DifferentialTrajectory, int64_t)>> callbacks;
+};
+
+class SwerveBatchTrajectoryGenerator {
+ public:
+  SwerveBatchTrajectoryGenerator() = default;
+
+  /// Adds a snapshot of the generator's path to the batch.
+  ///
+  /// @param generator The generator whose path to add.
+  /// @param handle The handle passed to the path's callbacks and to cancel().
+  void add_job(const SwerveTrajectoryGenerator& generator, int64_t handle);
+
+  /// Generates every job in the batch on a work-stealing thread pool.
+  ///
+  /// @param concurrency The maximum number of jobs solved at once. If zero, one
+  ///     job per hardware thread is solved at once.
+  /// @param diagnostics Enables diagnostic prints.
+  rust::Vec<SwerveBatchResult> generate(size_t concurrency,
+                                        bool diagnostics) const;
+
+ private:
+  trajopt::SwerveBatchTrajectoryGenerator batch;
+  std::vector<std::pair<int64_t, trajopt::CancellationToken>> tokens;
+};
+
+class DifferentialBatchTrajectoryGenerator {
+ public:
+  DifferentialBatchTrajectoryGenerator() = default;
+
+  /// Adds a snapshot of the generator's path to the batch.
+  ///
+  /// @param generator The generator whose path to add.
+  /// @param handle The handle passed to the path's callbacks and to cancel().
+  void add_job(const DifferentialTrajectoryGenerator& generator,
+               int64_t handle);
+
+  /// Generates every job in the batch on a work-stealing thread pool.
+  ///
+  /// @param concurrency The maximum number of jobs solved at once. If zero, one
+  ///     job per hardware thread is solved at once.
+  /// @param diagnostics Enables diagnostic prints.
+  rust::Vec<DifferentialBatchResult> generate(size_t concurrency,
+                                              bool diagnostics) const;
+
+ private:
+  trajopt::DifferentialBatchTrajectoryGenerator batch;
+  std::vector<std::pair<int64_t, trajopt::CancellationToken>> tokens;
 };
 
 std::unique_ptr<SwerveTrajectoryGenerator> swerve_trajectory_generator_new();
@@ -191,6 +309,18 @@ std::unique_ptr<SwerveTrajectoryGenerator> swerve_trajectory_generator_new();
 std::unique_ptr<DifferentialTrajectoryGenerator>
 differential_trajectory_generator_new();
 
+std::unique_ptr<SwerveBatchTrajectoryGenerator>
+swerve_batch_trajectory_generator_new();
+
+std::unique_ptr<DifferentialBatchTrajectoryGenerator>
+differential_batch_trajectory_generator_new();
+
+/// Cancels every running generation started with the given handle.
+///
+/// @param handle The handle passed to generate().
+void cancel(int64_t handle);
+
+/// Cancels every running generation in this process.
 void cancel_all();
 
 }  // namespace trajopt::rsffi
@@ -6,7 +6,11 @@
 
 #include <algorithm>
 #include <chrono>
+#include <concepts>
 #include <ranges>
+#include <string>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include <sleipnir/optimization/problem.hpp>
@@ -14,7 +18,15 @@
 
 #include "trajopt/geometry/rotation2.hpp"
 #include "trajopt/util/cancellation.hpp"
+#include "trajopt/util/compact_constraints.hpp"
+#include "trajopt/util/formulation.hpp"
+#include "trajopt/util/generation_budget.hpp"
+#include "trajopt/util/generation_stats.hpp"
+#include "trajopt/util/resample_solution.hpp"
+#include "trajopt/util/solution_violation.hpp"
+#include "trajopt/util/time_parameterize_initial_guess.hpp"
 #include "trajopt/util/trajopt_util.hpp"
+#include "util/generator_common.hpp"
 
 // Physics notation in this file:
 //
@@ -32,32 +44,186 @@
 
 namespace trajopt {
 
+namespace {
+
+/// Returns the drivetrain constants the problem is parameterized by: the mass,
+/// moment of inertia, max wheel speed, max wheel force, and each module's x
+/// and y position.
+std::vector<double> drivetrain_parameter_values(
+    const SwerveDrivetrain& drivetrain) {
+  const double v_max =
+      drivetrain.wheel_radius * drivetrain.wheel_max_angular_velocity;
+
+  // τ = r x F
+  // F = τ/r
+  const double wheel_max_force =
+      drivetrain.wheel_max_torque / drivetrain.wheel_radius;
+
+  // friction = μmg
+  const double normal_force_per_wheel =
+      drivetrain.mass * 9.8 / detail::swerve_num_wheels;
+  const double wheel_max_friction_force =
+      drivetrain.wheel_cof * normal_force_per_wheel;
+
+  const double F_max = std::min(wheel_max_force, wheel_max_friction_force);
+
+  std::vector<double> values{drivetrain.mass, drivetrain.moi, v_max, F_max};
+  for (const auto& module : drivetrain.modules) {
+    values.push_back(module.x());
+    values.push_back(module.y());
+  }
+  return values;
+}
+
+/// Returns the values of every parameter of the path's problem, in the order
+/// the generator's constructor creates them.
+std::vector<double> swerve_parameter_values(const SwervePath& path) {
+  auto values = drivetrain_parameter_values(path.drivetrain);
+
+  auto append_constraint_values =
+      [&](const std::vector<Constraint>& constraints) {
+        for (const auto& constraint : constraints) {
+          std::visit(
+              [&]<typename T>(const T& arg) {
+                if constexpr (ParametricConstraintLike<T>) {
+                  auto constraint_values = arg.parameter_values();
+                  values.insert(values.end(), constraint_values.begin(),
+                                constraint_values.end());
+                }
+              },
+              constraint);
+        }
+      };
+
+  for (const auto& waypoint : path.waypoints) {
+    append_constraint_values(waypoint.waypoint_constraints);
+  }
+
+  // The first waypoint's segment constraints aren't applied
+  for (size_t wpt_index = 1; wpt_index < path.waypoints.size(); ++wpt_index) {
+    append_constraint_values(path.waypoints.at(wpt_index).segment_constraints);
+  }
+
+  return values;
+}
+
+/// Returns true if the two constraint lists build the same problem structure,
+/// so they differ at most in parameter values.
+bool same_structure(const std::vector<Constraint>& lhs,
+                    const std::vector<Constraint>& rhs) {
+  return std::ranges::equal(
+      lhs, rhs, [](const Constraint& lhs_constraint,
+                   const Constraint& rhs_constraint) {
+        return std::visit(
+            []<typename L, typename R>(const L& lhs_arg, const R& rhs_arg) {
+              if constexpr (!std::same_as<L, R>) {
+                return false;
+              } else if constexpr (ParametricConstraintLike<L>) {
+                return lhs_arg.parameter_values().size() ==
+                       rhs_arg.parameter_values().size();
+              } else {
+                return lhs_arg == rhs_arg;
+              }
+            },
+            lhs_constraint, rhs_constraint);
+      });
+}
+
+}  // namespace
+
+ChassisLimits SwerveDrivetrain::chassis_limits() const {
+  double min_width = INFINITY;
+  for (size_t i = 0; i < modules.size(); ++i) {
+    auto mod_a = modules.at(i);
+    size_t mod_b_idx = i == 0 ? modules.size() - 1 : i - 1;
+    auto mod_b = modules.at(mod_b_idx);
+    min_width = std::min(
+        min_width, std::hypot(mod_a.x() - mod_b.x(), mod_a.y() - mod_b.y()));
+  }
+
+  const double chassis_max_force =
+      wheel_max_torque * detail::swerve_num_wheels / wheel_radius;
+  const double chassis_max_a = chassis_max_force / mass;
+  const double chassis_max_v = wheel_radius * wheel_max_angular_velocity;
+  const double wheel_max_position_radius =
+      std::ranges::max(modules, {}, &Translation2d::norm).norm();
+
+  return ChassisLimits{
+      .max_velocity = chassis_max_v,
+      .max_acceleration = chassis_max_a,
+      .max_angular_velocity = chassis_max_v / wheel_max_position_radius,
+      .max_angular_acceleration = chassis_max_a / wheel_max_position_radius,
+      .min_wheel_spacing = min_width};
+}
+
 SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
     SwervePathBuilder path_builder, int64_t handle)
     : path(path_builder.get_path()),
-      Ns(path_builder.get_control_interval_counts()) {
+      Ns(path_builder.get_control_interval_counts()),
+      transcription(path_builder.get_transcription().value_or(
+          default_transcription<SwerveSolution>())) {
+  using std::chrono::steady_clock;
+  using seconds = std::chrono::duration<double>;
+
+  auto construction_start = steady_clock::now();
   auto initial_guess = path_builder.calculate_linear_initial_guess();
+  time_parameterize_initial_guess(initial_guess, Ns, path.drivetrain);
+  seconds initial_guess_time = steady_clock::now() - construction_start;
+
+  // Obstacles near a segment's initial guess are applied like segment
+  // constraints, and the others are left out until a solution comes near them
+  const double obstacle_margin = path_builder.get_obstacle_margin();
+  auto obstacle_constraints =
+      path_builder.apply_obstacle_constraints(path, initial_guess);
+
+  generation_stats.removed_duplicate_constraints =
+      compact_constraints(path, Ns);
 
   problem.add_callback(
       [this, handle = handle](const slp::IterationInfo<double>&) -> bool {
-        constexpr int fps = 60;
-        constexpr std::chrono::duration<double> time_per_frame{1.0 / fps};
-
-        // FPS limit on sending updates
-        static auto last_frame_time = std::chrono::steady_clock::now();
-        auto now = std::chrono::steady_clock::now();
-        if (now - last_frame_time < time_per_frame) {
-          return trajopt::get_cancellation_flag();
+        auto now = steady_clock::now();
+        ++generation_stats.iterations;
+
+        // Rate limit on publishing to the progress channel
+        if (progress_channel != nullptr) {
+          const auto& options = progress_channel->options();
+          if (now - last_progress_time >=
+              std::chrono::duration<double>{1.0 / options.rate}) {
+            last_progress_time = now;
+            fill_swerve_solution(progress_channel->write_buffer(),
+                                 options.payload);
+            progress_channel->publish();
+          }
+        }
+
+        detail::send_to_callbacks(
+            path, handle, now, last_callback_time,
+            [this] { return construct_swerve_solution(); });
+
+        // The iterate is only copied out of the problem if it can beat the
+        // best one so far
+        if (best_iterate.has_value()) {
+          double total_time = 0.0;
+          for (auto& dt : dts) {
+            total_time += dt.value();
+          }
+          if (best_iterate->can_improve(total_time)) {
+            fill_swerve_solution(iterate, ProgressPayload::FULL);
+            best_iterate->offer(iterate, violation(iterate));
+          }
         }
 
-        last_frame_time = now;
+        generation_stats.callback_time +=
+            seconds{steady_clock::now() - now}.count();
 
-        auto soln = construct_swerve_solution();
-        for (auto& callback : this->path.callbacks) {
-          callback(soln, handle);
+        // Stop once the running generate() call's budget runs out
+        if (seconds{now - solve_start_time}.count() >= budget.max_solve_time ||
+            generation_stats.iterations >= budget.max_iterations) {
+          budget_exhausted = true;
+          return true;
         }
 
-        return trajopt::get_cancellation_flag();
+        return cancellation_token.is_cancelled();
       });
 
   size_t wpt_cnt = path.waypoints.size();
@@ -107,64 +273,80 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
     dts.emplace_back(problem.decision_variable());
   }
 
-  double min_width = INFINITY;
-  for (size_t i = 0; i < path.drivetrain.modules.size(); ++i) {
-    auto mod_a = path.drivetrain.modules.at(i);
-    size_t mod_b_idx = i == 0 ? path.drivetrain.modules.size() - 1 : i - 1;
-    auto mod_b = path.drivetrain.modules.at(mod_b_idx);
-    min_width = std::min(
-        min_width, std::hypot(mod_a.x() - mod_b.x(), mod_a.y() - mod_b.y()));
+  generation_stats.decision_variable_counts = {
+      {"states", 10 * samp_tot},
+      {"inputs", 2 * module_cnt * samp_tot},
+      {"time steps", samp_tot}};
+
+  // Creates parameters with the given values, or constants unless the path is
+  // parametric
+  auto make_parameters = [this, parametric = path_builder.get_parametric()](
+                             const std::vector<double>& values) {
+    std::vector<slp::Variable<double>> new_parameters;
+    for (double value : values) {
+      if (parametric) {
+        auto& parameter = parameters.emplace_back();
+        parameter.set_value(value);
+        new_parameters.push_back(parameter);
+      } else {
+        new_parameters.emplace_back(value);
+      }
+    }
+    return new_parameters;
+  };
+
+  // Minimize total time
+  detail::minimize_total_time(problem, dts, Ns, initial_guess.dt);
+
+  // Drivetrain constants are parameters of a parametric path so update() can
+  // change them
+  auto drivetrain_parameters =
+      make_parameters(drivetrain_parameter_values(path.drivetrain));
+  const auto& mass = drivetrain_parameters[0];
+  const auto& moi = drivetrain_parameters[1];
+  const auto& v_max = drivetrain_parameters[2];
+  const auto& F_max = drivetrain_parameters[3];
+  std::vector<Translation2v<double>> modules;
+  for (size_t module_index = 0; module_index < module_cnt; ++module_index) {
+    modules.emplace_back(drivetrain_parameters[4 + 2 * module_index],
+                         drivetrain_parameters[5 + 2 * module_index]);
   }
 
-  constexpr int num_wheels = 4;
+  // Returns a module's force at a sample
+  auto module_force = [&](size_t index, size_t module_index) {
+    return Translation2v<double>{Fx.at(index).at(module_index),
+                                 Fy.at(index).at(module_index)};
+  };
 
-  // Minimize total time
-  const double chassis_max_force = path.drivetrain.wheel_max_torque *
-                                   num_wheels / path.drivetrain.wheel_radius;
-  const double chassis_max_a = chassis_max_force / path.drivetrain.mass;
-  const double chassis_max_v =
-      path.drivetrain.wheel_radius * path.drivetrain.wheel_max_angular_velocity;
-  const double wheel_max_position_radius =
-      std::ranges::max(path.drivetrain.modules, {}, &Translation2d::norm)
-          .norm();
-  const double chassis_max_ω = chassis_max_v / wheel_max_position_radius;
-  const double chassis_max_α = chassis_max_a / wheel_max_position_radius;
-  for (size_t sgmt_index = 0; sgmt_index < Ns.size(); ++sgmt_index) {
-    size_t N_sgmt = Ns.at(sgmt_index);
-    size_t sgmt_start = get_index(Ns, sgmt_index);
-    size_t sgmt_end = get_index(Ns, sgmt_index + 1);
-
-    if (N_sgmt == 0) {
-      for (size_t index = sgmt_start; index < sgmt_end + 1; ++index) {
-        dts.at(index).set_value(0.0);
-      }
-    } else {
-      // Use initial_guess and Ns to find the dx, dy, dθ between wpts
-      const double dx =
-          initial_guess.x.at(sgmt_end) - initial_guess.x.at(sgmt_start);
-      const double dy =
-          initial_guess.y.at(sgmt_end) - initial_guess.y.at(sgmt_start);
-      const double dist = std::hypot(dx, dy);
-      const double θ_0 = std::atan2(initial_guess.thetasin.at(sgmt_start),
-                                    initial_guess.thetacos.at(sgmt_start));
-      const double θ_1 = std::atan2(initial_guess.thetasin.at(sgmt_end),
-                                    initial_guess.thetacos.at(sgmt_end));
-      const double dθ = std::abs(angle_modulus(θ_1 - θ_0));
-
-      const double angular_time =
-          calculate_trapezoidal_time(dθ, chassis_max_ω, chassis_max_α);
-      const double linear_time = calculate_trapezoidal_time(
-          dist, std::min(chassis_max_v, dist / angular_time), chassis_max_a);
-      const double sgmt_time = angular_time + linear_time;
-
-      for (size_t index = sgmt_start; index < sgmt_end + 1; ++index) {
-        auto& dt = dts.at(index);
-        problem.subject_to(slp::bounds(0, dt, 3));
-        dt.set_value(sgmt_time / N_sgmt);
-      }
+  // Returns the module offsets from the robot's origin at the given heading
+  auto rotate_modules = [&](const Rotation2v<double>& θ) {
+    std::vector<Translation2v<double>> rotated_modules;
+    rotated_modules.reserve(module_cnt);
+    for (const auto& module : modules) {
+      rotated_modules.push_back(module.rotate_by(θ));
     }
+    return rotated_modules;
+  };
+
+  // The module offsets at each sample's heading, built once and shared by
+  // every torque evaluated at that heading
+  std::vector<std::vector<Translation2v<double>>> sample_modules;
+  sample_modules.reserve(samp_tot);
+  for (size_t index = 0; index < samp_tot; ++index) {
+    sample_modules.push_back(
+        rotate_modules(Rotation2v<double>{cosθ.at(index), sinθ.at(index)}));
   }
-  problem.minimize(std::accumulate(dts.begin(), dts.end(), slp::Variable{0.0}));
+
+  // Returns the net torque about the robot's origin, where r are the module
+  // offsets at the robot's heading and force(i) is the force on module i
+  auto net_torque = [&](const std::vector<Translation2v<double>>& r,
+                        auto&& force) {
+    slp::Variable τ_net = 0.0;
+    for (size_t module_index = 0; module_index < module_cnt; ++module_index) {
+      τ_net += r.at(module_index).cross(force(module_index));
+    }
+    return τ_net;
+  };
 
   // Apply kinematics constraints
   for (size_t wpt_index = 0; wpt_index < wpt_cnt - 1; ++wpt_index) {
@@ -197,19 +379,118 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
         problem.subject_to(dt_k_1 == dt_k);
       }
 
-      // xₖ₊₁ = xₖ + vₖt + 1/2aₖt²
-      // θₖ₊₁ = θₖ + ωₖt + 1/2αₖt²
-      // vₖ₊₁ = vₖ + aₖt
-      // ωₖ₊₁ = ωₖ + αₖt
-      problem.subject_to(x_k_1 == x_k + v_k * dt_k + a_k * 0.5 * dt_k * dt_k);
-      problem.subject_to(θ_k_1 ==
-                         θ_k + Rotation2v<double>{ω_k * dt_k} +
-                             Rotation2v<double>{α_k * 0.5 * dt_k * dt_k});
-      problem.subject_to(v_k_1 == v_k + a_k * dt_k);
-      problem.subject_to(ω_k_1 == ω_k + α_k * dt_k);
+      // Shared by every second-order term of the interval
+      auto dt_k_sq = dt_k * dt_k;
+
+      // Module forces halfway through the interval, shared by the stages that
+      // evaluate the torque there
+      std::vector<Translation2v<double>> F_c_values;
+      if (transcription != Transcription::CONSTANT_ACCELERATION) {
+        F_c_values.reserve(module_cnt);
+        for (size_t module_index = 0; module_index < module_cnt;
+             ++module_index) {
+          F_c_values.push_back((module_force(index, module_index) +
+                                module_force(index + 1, module_index)) *
+                               0.5);
+        }
+      }
+      auto F_c = [&](size_t module_index) {
+        return F_c_values.at(module_index);
+      };
+
+      switch (transcription) {
+        case Transcription::CONSTANT_ACCELERATION: {
+          // xₖ₊₁ = xₖ + vₖt + 1/2aₖt²
+          // θₖ₊₁ = θₖ + ωₖt + 1/2αₖt²
+          // vₖ₊₁ = vₖ + aₖt
+          // ωₖ₊₁ = ωₖ + αₖt
+          problem.subject_to(x_k_1 ==
+                             x_k + v_k * dt_k + a_k * 0.5 * dt_k_sq);
+          problem.subject_to(θ_k_1 ==
+                             θ_k + Rotation2v<double>{ω_k * dt_k} +
+                                 Rotation2v<double>{α_k * 0.5 * dt_k_sq});
+          problem.subject_to(v_k_1 == v_k + a_k * dt_k);
+          problem.subject_to(ω_k_1 == ω_k + α_k * dt_k);
+          break;
+        }
+        case Transcription::HERMITE_SIMPSON: {
+          // The linear acceleration doesn't depend on the state, so
+          // collocating the translation at the midpoint reduces to
+          //
+          //   xₖ₊₁ = xₖ + 1/2(vₖ + vₖ₊₁)t + 1/12(aₖ − aₖ₊₁)t²
+          //   vₖ₊₁ = vₖ + 1/2(aₖ + aₖ₊₁)t
+          //
+          // The angular acceleration depends on the heading through the module
+          // positions, so it's evaluated at the interpolated midpoint heading.
+          //
+          //   θₖ₊₁ = θₖ + 1/2(ωₖ + ωₖ₊₁)t + 1/12(αₖ − αₖ₊₁)t²
+          //   θ_c = θₖ + 1/8(3ωₖ + ωₖ₊₁)t + 1/24(αₖ − αₖ₊₁)t²
+          //   ωₖ₊₁ = ωₖ + 1/6(αₖ + 4α_c + αₖ₊₁)t
+          auto θ_c = θ_k + Rotation2v<double>{(3 * ω_k + ω_k_1) / 8 * dt_k +
+                                              (α_k - α_k_1) / 24 * dt_k_sq};
+          auto α_c = net_torque(rotate_modules(θ_c), F_c) / moi;
+
+          problem.subject_to(x_k_1 == x_k + (v_k + v_k_1) * 0.5 * dt_k +
+                                          (a_k - a_k_1) / 12 * dt_k_sq);
+          problem.subject_to(
+              θ_k_1 == θ_k + Rotation2v<double>{
+                                 (ω_k + ω_k_1) * 0.5 * dt_k +
+                                 (α_k - α_k_1) / 12 * dt_k_sq});
+          problem.subject_to(v_k_1 == v_k + (a_k + a_k_1) * 0.5 * dt_k);
+          problem.subject_to(ω_k_1 ==
+                             ω_k + (α_k + 4 * α_c + α_k_1) / 6 * dt_k);
+          break;
+        }
+        case Transcription::RUNGE_KUTTA_4: {
+          // The module forces vary linearly over the interval, so the
+          // translation's RK4 step is exact.
+          //
+          //   xₖ₊₁ = xₖ + vₖt + 1/6(2aₖ + aₖ₊₁)t²
+          //   vₖ₊₁ = vₖ + 1/2(aₖ + aₖ₊₁)t
+          //
+          // Each of the rotation's stages evaluates the angular acceleration
+          // at the stage's heading.
+          auto F_k_1 = [&](size_t module_index) {
+            return module_force(index + 1, module_index);
+          };
+
+          auto ω_2 = ω_k + α_k * 0.5 * dt_k;
+          auto θ_2 = θ_k + Rotation2v<double>{ω_k * 0.5 * dt_k};
+          auto α_2 = net_torque(rotate_modules(θ_2), F_c) / moi;
+          auto ω_3 = ω_k + α_2 * 0.5 * dt_k;
+          auto θ_3 = θ_k + Rotation2v<double>{ω_2 * 0.5 * dt_k};
+          auto α_3 = net_torque(rotate_modules(θ_3), F_c) / moi;
+          auto ω_4 = ω_k + α_3 * dt_k;
+          auto θ_4 = θ_k + Rotation2v<double>{ω_3 * dt_k};
+          auto α_4 = net_torque(rotate_modules(θ_4), F_k_1) / moi;
+
+          problem.subject_to(x_k_1 == x_k + v_k * dt_k +
+                                          (a_k * 2 + a_k_1) / 6 * dt_k_sq);
+          problem.subject_to(
+              θ_k_1 ==
+              θ_k + Rotation2v<double>{(ω_k + 2 * ω_2 + 2 * ω_3 + ω_4) / 6 *
+                                       dt_k});
+          problem.subject_to(v_k_1 == v_k + (a_k + a_k_1) * 0.5 * dt_k);
+          problem.subject_to(ω_k_1 == ω_k + (α_k + 2 * α_2 + 2 * α_3 + α_4) /
+                                                6 * dt_k);
+          break;
+        }
+      }
     }
   }
 
+  // Each interval shares its squared time step, each sample its rotated module
+  // offsets, and intervals that evaluate the torque between samples share
+  // their midpoint module forces
+  const size_t interval_cnt = samp_tot - 1;
+  generation_stats.shared_subexpression_counts = {
+      {"squared time steps", interval_cnt},
+      {"rotated module offsets", samp_tot * module_cnt}};
+  if (transcription != Transcription::CONSTANT_ACCELERATION) {
+    generation_stats.shared_subexpression_counts["midpoint module forces"] =
+        interval_cnt * module_cnt;
+  }
+
   for (size_t index = 0; index < samp_tot; ++index) {
     Rotation2v<double> θ_k{cosθ.at(index), sinθ.at(index)};
     Translation2v<double> v_k{vx.at(index), vy.at(index)};
@@ -221,50 +502,25 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
                                   slp::Variable{0.0});
 
     // Solve for net torque
-    slp::Variable τ_net = 0.0;
-    for (size_t module_index = 0; module_index < path.drivetrain.modules.size();
-         ++module_index) {
-      const auto& translation = path.drivetrain.modules.at(module_index);
-      auto r = translation.rotate_by(θ_k);
-      Translation2v<double> F{Fx.at(index).at(module_index),
-                              Fy.at(index).at(module_index)};
-
-      τ_net += r.cross(F);
-    }
+    auto τ_net = net_torque(sample_modules.at(index), [&](size_t module_index) {
+      return module_force(index, module_index);
+    });
 
     // Apply module power constraints
     auto v_wrt_robot = v_k.rotate_by(-θ_k);
-    for (size_t module_index = 0; module_index < path.drivetrain.modules.size();
-         ++module_index) {
-      const auto& translation = path.drivetrain.modules.at(module_index);
+    for (size_t module_index = 0; module_index < module_cnt; ++module_index) {
+      const auto& translation = modules.at(module_index);
 
       Translation2v<double> v_wheel_wrt_robot{
           v_wrt_robot.x() - translation.y() * ω.at(index),
           v_wrt_robot.y() + translation.x() * ω.at(index)};
-      const double v_max = path.drivetrain.wheel_radius *
-                           path.drivetrain.wheel_max_angular_velocity;
 
       // |v|₂² ≤ vₘₐₓ²
       problem.subject_to(v_wheel_wrt_robot.squared_norm() <= v_max * v_max);
 
-      Translation2v<double> module_force{Fx.at(index).at(module_index),
-                                         Fy.at(index).at(module_index)};
-
-      // τ = r x F
-      // F = τ/r
-      const double wheel_max_force =
-          path.drivetrain.wheel_max_torque / path.drivetrain.wheel_radius;
-
-      // friction = μmg
-      const double normal_force_per_wheel =
-          path.drivetrain.mass * 9.8 / num_wheels;
-      const double wheel_max_friction_force =
-          path.drivetrain.wheel_cof * normal_force_per_wheel;
-
-      const double F_max = std::min(wheel_max_force, wheel_max_friction_force);
-
       // |F|₂² ≤ Fₘₐₓ²
-      problem.subject_to(module_force.squared_norm() <= F_max * F_max);
+      problem.subject_to(module_force(index, module_index).squared_norm() <=
+                         F_max * F_max);
     }
 
     // Apply dynamics constraints
@@ -272,138 +528,339 @@ SwerveTrajectoryGenerator::SwerveTrajectoryGenerator(
     //   ΣF_xₖ = ma_xₖ
     //   ΣF_yₖ = ma_yₖ
     //   Στₖ = Jαₖ
-    problem.subject_to(Fx_net == path.drivetrain.mass * ax.at(index));
-    problem.subject_to(Fy_net == path.drivetrain.mass * ay.at(index));
-    problem.subject_to(τ_net == path.drivetrain.moi * α.at(index));
+    problem.subject_to(Fx_net == mass * ax.at(index));
+    problem.subject_to(Fy_net == mass * ay.at(index));
+    problem.subject_to(τ_net == moi * α.at(index));
   }
 
-  for (size_t wpt_index = 0; wpt_index < wpt_cnt; ++wpt_index) {
-    // First index of next wpt - 1
-    size_t index = get_index(Ns, wpt_index, 0);
+  // Kinematics constrain each control interval, and dynamics each sample
+  auto& constraint_counts = generation_stats.constraint_counts;
+  constraint_counts["kinematics"] = samp_tot - 1;
+  constraint_counts["dynamics"] = samp_tot;
 
-    Pose2v<double> pose_k{
-        x.at(index), y.at(index), {cosθ.at(index), sinθ.at(index)}};
-    Translation2v<double> v_k{vx.at(index), vy.at(index)};
-    auto ω_k = ω.at(index);
-    Translation2v<double> a_k{ax.at(index), ay.at(index)};
-    auto α_k = α.at(index);
-
-    for (auto& constraint : path.waypoints.at(wpt_index).waypoint_constraints) {
-      std::visit(
-          [&](auto&& arg) { arg.apply(problem, pose_k, v_k, ω_k, a_k, α_k); },
-          constraint);
+  const auto lazy_margin = path_builder.get_lazy_geometric_constraints();
+
+  // Leaves a geometric constraint out of the problem if the initial guess is
+  // far from it at the sample. Geometric constraints aren't parametric, so
+  // this doesn't change which parameters are created.
+  auto defer_constraint = [&](const Constraint& constraint, size_t index) {
+    if (!lazy_margin.has_value()) {
+      return false;
     }
-  }
 
+    Pose2d pose{initial_guess.x.at(index),
+                initial_guess.y.at(index),
+                {initial_guess.thetacos.at(index),
+                 initial_guess.thetasin.at(index)}};
+    auto margin = constraint_margin(constraint, pose);
+    if (!margin.has_value() ||
+        margin.value() < lazy_margin.value()) {
+      return false;
+    }
+
+    inactive_constraints.push_back({constraint, index, lazy_margin.value()});
+    return true;
+  };
+
+  detail::SwerveStateVariables states{x, y, cosθ, sinθ, vx, vy, ω, ax, ay, α};
+  detail::apply_swerve_path_constraints(problem, states, path, Ns,
+                                        generation_stats, make_parameters,
+                                        defer_constraint);
+
+  // A segment's far obstacles are checked at its samples up to the next
+  // segment's first, which the next segment checks
   for (size_t sgmt_index = 0; sgmt_index < sgmt_cnt; ++sgmt_index) {
     size_t start_index = get_index(Ns, sgmt_index, 0);
     size_t end_index = get_index(Ns, sgmt_index + 1, 0);
+    if (sgmt_index + 1 == sgmt_cnt) {
+      ++end_index;
+    }
 
-    for (size_t index = start_index; index < end_index; ++index) {
-      Pose2v<double> pose_k{
-          x.at(index), y.at(index), {cosθ.at(index), sinθ.at(index)}};
-      Translation2v<double> v_k{vx.at(index), vy.at(index)};
-      auto ω_k = ω.at(index);
-      Translation2v<double> a_k{ax.at(index), ay.at(index)};
-      auto α_k = α.at(index);
-
-      for (auto& constraint :
-           path.waypoints.at(sgmt_index + 1).segment_constraints) {
-        std::visit(
-            [&](auto&& arg) { arg.apply(problem, pose_k, v_k, ω_k, a_k, α_k); },
-            constraint);
+    for (const auto& constraint : obstacle_constraints.at(sgmt_index).far) {
+      for (size_t index = start_index; index < end_index; ++index) {
+        inactive_constraints.push_back({constraint, index, obstacle_margin});
       }
     }
   }
+  generation_stats.inactive_constraints = inactive_constraints.size();
 
+  auto initial_guess_start = steady_clock::now();
   apply_initial_guess(initial_guess);
+  initial_guess_time += steady_clock::now() - initial_guess_start;
+
+  generation_stats.initial_guess_time = initial_guess_time.count();
+  generation_stats.construction_time =
+      seconds{steady_clock::now() - construction_start}.count() -
+      generation_stats.initial_guess_time;
 }
 
 std::expected<SwerveSolution, slp::ExitStatus>
-SwerveTrajectoryGenerator::generate(bool diagnostics) {
-  get_cancellation_flag() = 0;
-
-  // tolerance of 1e-4 is 0.1 mm
-  auto status = problem.solve({.tolerance = 1e-4, .diagnostics = diagnostics});
-
-  if (static_cast<int>(status) < 0 ||
-      status == slp::ExitStatus::CALLBACK_REQUESTED_STOP) {
+SwerveTrajectoryGenerator::generate(bool diagnostics, GenerationStats* stats) {
+  auto status = solve(diagnostics, stats);
+  if (detail::failed(status)) {
     return std::unexpected{status};
   } else {
     return construct_swerve_solution();
   }
 }
 
+BudgetedGeneration<SwerveSolution> SwerveTrajectoryGenerator::generate(
+    const GenerationBudget& budget, bool diagnostics, GenerationStats* stats) {
+  this->budget = budget;
+  best_iterate.emplace();
+
+  auto status = solve(diagnostics, stats);
+
+  BudgetedGeneration<SwerveSolution> result{
+      .status = status, .budget_exhausted = budget_exhausted};
+  if (detail::failed(status)) {
+    result.solution = best_iterate->solution();
+  } else {
+    result.solution = construct_swerve_solution();
+  }
+  if (result.solution.has_value()) {
+    result.violation = violation(result.solution.value());
+  }
+
+  this->budget = GenerationBudget{};
+  best_iterate.reset();
+  return result;
+}
+
+slp::ExitStatus SwerveTrajectoryGenerator::solve(bool diagnostics,
+                                                 GenerationStats* stats) {
+  using std::chrono::steady_clock;
+
+  generation_stats.iterations = 0;
+  generation_stats.callback_time = 0.0;
+  budget_exhausted = false;
+
+  solve_start_time = steady_clock::now();
+
+  auto status = problem.solve(
+      {.tolerance = SOLVER_TOLERANCE, .diagnostics = diagnostics});
+
+  // Re-solve from the last solution until it doesn't come near any geometric
+  // constraint that was left out
+  while (!detail::failed(status) && activate_constraints() > 0) {
+    status = problem.solve(
+        {.tolerance = SOLVER_TOLERANCE, .diagnostics = diagnostics});
+  }
+
+  std::chrono::duration<double> solve_time =
+      steady_clock::now() - solve_start_time;
+  generation_stats.solve_time =
+      solve_time.count() - generation_stats.callback_time;
+  generation_stats.peak_memory = peak_memory_usage();
+  generation_stats.inactive_constraints = inactive_constraints.size();
+  if (stats != nullptr) {
+    *stats = generation_stats;
+  }
+
+  return status;
+}
+
+size_t SwerveTrajectoryGenerator::activate_constraints() {
+  detail::SwerveStateVariables states{x, y, cosθ, sinθ, vx, vy, ω, ax, ay, α};
+  std::vector<LazyConstraint> still_inactive;
+  for (auto& lazy_constraint : inactive_constraints) {
+    auto& [constraint, index, activation_margin] = lazy_constraint;
+    Pose2d pose{x.at(index).value(),
+                y.at(index).value(),
+                {cosθ.at(index).value(), sinθ.at(index).value()}};
+    if (constraint_margin(constraint, pose).value() >= activation_margin) {
+      still_inactive.push_back(std::move(lazy_constraint));
+      continue;
+    }
+
+    std::visit(
+        [&](auto& arg) {
+          detail::apply_swerve_constraint(problem, states, arg, index, {});
+        },
+        constraint);
+    generation_stats.count_constraint(constraint);
+    activated_constraints.push_back(std::move(lazy_constraint));
+  }
+
+  size_t activated = inactive_constraints.size() - still_inactive.size();
+  inactive_constraints = std::move(still_inactive);
+  return activated;
+}
+
+bool SwerveTrajectoryGenerator::update(SwervePathBuilder path_builder) {
+  // A parametric problem has at least the drivetrain's parameters
+  if (parameters.empty()) {
+    return false;
+  }
+
+  auto& new_path = path_builder.get_path();
+  if (path_builder.get_control_interval_counts() != Ns ||
+      path_builder.get_transcription().value_or(
+          default_transcription<SwerveSolution>()) != transcription ||
+      new_path.waypoints.size() != path.waypoints.size() ||
+      new_path.drivetrain.modules.size() != path.drivetrain.modules.size()) {
+    return false;
+  }
+
+  // Which constraints are left out depends on the initial guess, which the new
+  // path doesn't have
+  if (!inactive_constraints.empty() || !path_builder.get_obstacles().empty() ||
+      path_builder.get_lazy_geometric_constraints().has_value()) {
+    return false;
+  }
+
+  compact_constraints(new_path, Ns);
+
+  for (size_t wpt_index = 0; wpt_index < path.waypoints.size(); ++wpt_index) {
+    const auto& waypoint = path.waypoints.at(wpt_index);
+    const auto& new_waypoint = new_path.waypoints.at(wpt_index);
+    if (!same_structure(waypoint.waypoint_constraints,
+                        new_waypoint.waypoint_constraints) ||
+        (wpt_index > 0 && !same_structure(waypoint.segment_constraints,
+                                          new_waypoint.segment_constraints))) {
+      return false;
+    }
+  }
+
+  auto values = swerve_parameter_values(new_path);
+  for (size_t index = 0; index < parameters.size(); ++index) {
+    parameters.at(index).set_value(values.at(index));
+  }
+
+  path = std::move(new_path);
+
+  return true;
+}
+
+bool SwerveTrajectoryGenerator::warm_start(
+    const SwerveSolution& solution,
+    const std::vector<size_t>& control_interval_counts) {
+  if (!solution_fits(solution, control_interval_counts)) {
+    return false;
+  }
+
+  auto seed = control_interval_counts == Ns
+                  ? solution
+                  : resample_solution(solution, control_interval_counts, Ns);
+
+  size_t sample_total = x.size();
+  for (size_t sample_index = 0; sample_index < sample_total; ++sample_index) {
+    x[sample_index].set_value(seed.x[sample_index]);
+    y[sample_index].set_value(seed.y[sample_index]);
+    cosθ[sample_index].set_value(seed.thetacos[sample_index]);
+    sinθ[sample_index].set_value(seed.thetasin[sample_index]);
+    vx[sample_index].set_value(seed.vx[sample_index]);
+    vy[sample_index].set_value(seed.vy[sample_index]);
+    ω[sample_index].set_value(seed.omega[sample_index]);
+    ax[sample_index].set_value(seed.ax[sample_index]);
+    ay[sample_index].set_value(seed.ay[sample_index]);
+    α[sample_index].set_value(seed.alpha[sample_index]);
+
+    // The module count may have changed since the seed was generated, and a
+    // seed without forces keeps the constructor's force guess
+    size_t module_cnt =
+        seed.module_fx.empty()
+            ? 0
+            : std::min(Fx[sample_index].size(),
+                       seed.module_fx[sample_index].size());
+    for (size_t module_index = 0; module_index < module_cnt; ++module_index) {
+      Fx[sample_index][module_index].set_value(
+          seed.module_fx[sample_index][module_index]);
+      Fy[sample_index][module_index].set_value(
+          seed.module_fy[sample_index][module_index]);
+    }
+
+    // Keep the constructor's time step guess where the seed has no duration
+    if (seed.dt[sample_index] > 0.0) {
+      dts[sample_index].set_value(seed.dt[sample_index]);
+    }
+  }
+
+  return true;
+}
+
 void SwerveTrajectoryGenerator::apply_initial_guess(
     const SwerveSolution& solution) {
+  // The guess is time-parameterized, so its velocities and accelerations
+  // already agree with its time steps
   size_t sample_total = x.size();
   for (size_t sample_index = 0; sample_index < sample_total; ++sample_index) {
     x[sample_index].set_value(solution.x[sample_index]);
     y[sample_index].set_value(solution.y[sample_index]);
     cosθ[sample_index].set_value(solution.thetacos[sample_index]);
     sinθ[sample_index].set_value(solution.thetasin[sample_index]);
+    vx[sample_index].set_value(solution.vx[sample_index]);
+    vy[sample_index].set_value(solution.vy[sample_index]);
+    ω[sample_index].set_value(solution.omega[sample_index]);
+    ax[sample_index].set_value(solution.ax[sample_index]);
+    ay[sample_index].set_value(solution.ay[sample_index]);
+    α[sample_index].set_value(solution.alpha[sample_index]);
   }
+}
 
-  vx[0].set_value(0.0);
-  vy[0].set_value(0.0);
-  ω[0].set_value(0.0);
-  ax[0].set_value(0.0);
-  ay[0].set_value(0.0);
-  α[0].set_value(0.0);
-
-  for (size_t sample_index = 1; sample_index < sample_total; ++sample_index) {
-    vx[sample_index].set_value(
-        (solution.x[sample_index] - solution.x[sample_index - 1]) /
-        solution.dt[sample_index]);
-    vy[sample_index].set_value(
-        (solution.y[sample_index] - solution.y[sample_index - 1]) /
-        solution.dt[sample_index]);
-
-    double cosθ = solution.thetacos[sample_index];
-    double sinθ = solution.thetasin[sample_index];
-    double last_cosθ = solution.thetacos[sample_index - 1];
-    double last_sinθ = solution.thetasin[sample_index - 1];
-
-    ω[sample_index].set_value(Rotation2d{cosθ, sinθ}
-                                  .rotate_by(-Rotation2d{last_cosθ, last_sinθ})
-                                  .radians() /
-                              solution.dt[sample_index]);
-
-    ax[sample_index].set_value(
-        (vx[sample_index].value() - vx[sample_index - 1].value()) /
-        solution.dt[sample_index]);
-    ay[sample_index].set_value(
-        (vy[sample_index].value() - vy[sample_index - 1].value()) /
-        solution.dt[sample_index]);
-    α[sample_index].set_value(
-        (ω[sample_index].value() - ω[sample_index - 1].value()) /
-        solution.dt[sample_index]);
-  }
+double SwerveTrajectoryGenerator::violation(
+    const SwerveSolution& solution) const {
+  return std::max({solution_violation(path, Ns, solution, transcription),
+                   lazy_constraint_violation(path.drivetrain, solution,
+                                             inactive_constraints),
+                   lazy_constraint_violation(path.drivetrain, solution,
+                                             activated_constraints)});
 }
 
 SwerveSolution SwerveTrajectoryGenerator::construct_swerve_solution() {
-  auto get_value = [](auto& var) { return var.value(); };
+  SwerveSolution solution;
+  fill_swerve_solution(solution, ProgressPayload::FULL);
+  return solution;
+}
 
-  auto vector_value = [&](std::vector<slp::Variable<double>>& row) {
-    return row | std::views::transform(get_value) |
-           std::ranges::to<std::vector>();
+void SwerveTrajectoryGenerator::fill_swerve_solution(SwerveSolution& solution,
+                                                     ProgressPayload payload) {
+  // Assign in place so the solution's storage is reused
+  auto fill_vector = [](std::vector<double>& values,
+                        std::vector<slp::Variable<double>>& row) {
+    values.resize(row.size());
+    for (size_t index = 0; index < row.size(); ++index) {
+      values[index] = row[index].value();
+    }
   };
 
-  auto matrix_value =
-      [&](std::vector<std::vector<slp::Variable<double>>>& mat) {
-        return mat | std::views::transform([&](auto& v) {
-                 return v | std::views::transform(get_value) |
-                        std::ranges::to<std::vector>();
-               }) |
-               std::ranges::to<std::vector>();
-      };
+  auto fill_matrix = [&](std::vector<std::vector<double>>& values,
+                         std::vector<std::vector<slp::Variable<double>>>& mat) {
+    values.resize(mat.size());
+    for (size_t index = 0; index < mat.size(); ++index) {
+      fill_vector(values[index], mat[index]);
+    }
+  };
 
-  return SwerveSolution{
-      vector_value(dts),  vector_value(x),    vector_value(y),
-      vector_value(cosθ), vector_value(sinθ), vector_value(vx),
-      vector_value(vy),   vector_value(ω),    vector_value(ax),
-      vector_value(ay),   vector_value(α),    matrix_value(Fx),
-      matrix_value(Fy)};
+  fill_vector(solution.dt, dts);
+  fill_vector(solution.x, x);
+  fill_vector(solution.y, y);
+  fill_vector(solution.thetacos, cosθ);
+  fill_vector(solution.thetasin, sinθ);
+
+  if (payload == ProgressPayload::FULL) {
+    fill_vector(solution.vx, vx);
+    fill_vector(solution.vy, vy);
+    fill_vector(solution.omega, ω);
+    fill_vector(solution.ax, ax);
+    fill_vector(solution.ay, ay);
+    fill_vector(solution.alpha, α);
+    fill_matrix(solution.module_fx, Fx);
+    fill_matrix(solution.module_fy, Fy);
+  } else {
+    // Zero the fields that aren't published, so they still have an entry per
+    // sample instead of a previous update's values
+    for (auto* values : {&solution.vx, &solution.vy, &solution.omega,
+                         &solution.ax, &solution.ay, &solution.alpha}) {
+      values->assign(x.size(), 0.0);
+    }
+    for (auto* values : {&solution.module_fx, &solution.module_fy}) {
+      values->resize(Fx.size());
+      for (size_t index = 0; index < Fx.size(); ++index) {
+        (*values)[index].assign(Fx[index].size(), 0.0);
+      }
+    }
+  }
 }
 
 }  // namespace trajopt
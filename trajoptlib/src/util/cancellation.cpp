@@ -2,11 +2,24 @@
 
 #include "trajopt/util/cancellation.hpp"
 
+#include <atomic>
+#include <memory>
+
 namespace trajopt {
 
-std::atomic<int>& get_cancellation_flag() {
-  static std::atomic<int> flag{0};
-  return flag;
+CancellationToken::CancellationToken()
+    : m_flag{std::make_shared<std::atomic<bool>>(false)} {}
+
+void CancellationToken::cancel() const {
+  m_flag->store(true, std::memory_order_relaxed);
+}
+
+void CancellationToken::reset() const {
+  m_flag->store(false, std::memory_order_relaxed);
+}
+
+bool CancellationToken::is_cancelled() const {
+  return m_flag->load(std::memory_order_relaxed);
 }
 
 }  // namespace trajopt
@@ -0,0 +1,136 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/util/generation_stats.hpp"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <concepts>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+// windows.h must be included before psapi.h
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "trajopt/constraint/constraint.hpp"
+
+namespace trajopt {
+
+GenerationStats& GenerationStats::operator+=(const GenerationStats& other) {
+  construction_time += other.construction_time;
+  initial_guess_time += other.initial_guess_time;
+  solve_time += other.solve_time;
+  callback_time += other.callback_time;
+  iterations += other.iterations;
+  for (const auto& [source, count] : other.decision_variable_counts) {
+    decision_variable_counts[source] += count;
+  }
+  for (const auto& [source, count] : other.constraint_counts) {
+    constraint_counts[source] += count;
+  }
+  removed_duplicate_constraints += other.removed_duplicate_constraints;
+  inactive_constraints += other.inactive_constraints;
+  for (const auto& [kind, count] : other.shared_subexpression_counts) {
+    shared_subexpression_counts[kind] += count;
+  }
+  peak_memory = std::max(peak_memory, other.peak_memory);
+  return *this;
+}
+
+void GenerationStats::count_constraint(const Constraint& constraint,
+                                       size_t applications) {
+  if (applications == 0) {
+    return;
+  }
+
+  std::string name{constraint_name(constraint)};
+  constraint_counts[name] += applications;
+  if (size_t variable_cnt = constraint_decision_variable_count(constraint);
+      variable_cnt > 0) {
+    decision_variable_counts[name] += variable_cnt * applications;
+  }
+}
+
+namespace {
+
+/// Returns the name of a constraint type.
+///
+/// @tparam T The constraint type.
+template <typename T>
+constexpr std::string_view constraint_type_name() {
+  if constexpr (std::same_as<T, AngularVelocityMaxMagnitudeConstraint>) {
+    return "AngularVelocityMaxMagnitudeConstraint";
+  } else if constexpr (std::same_as<T, LaneConstraint>) {
+    return "LaneConstraint";
+  } else if constexpr (std::same_as<T, LinePointConstraint>) {
+    return "LinePointConstraint";
+  } else if constexpr (std::same_as<T,
+                                    LinearAccelerationMaxMagnitudeConstraint>) {
+    return "LinearAccelerationMaxMagnitudeConstraint";
+  } else if constexpr (std::same_as<T, LinearVelocityDirectionConstraint>) {
+    return "LinearVelocityDirectionConstraint";
+  } else if constexpr (std::same_as<T, LinearVelocityMaxMagnitudeConstraint>) {
+    return "LinearVelocityMaxMagnitudeConstraint";
+  } else if constexpr (std::same_as<T, PointAtConstraint>) {
+    return "PointAtConstraint";
+  } else if constexpr (std::same_as<T, PointLineConstraint>) {
+    return "PointLineConstraint";
+  } else if constexpr (std::same_as<T, PointLineRegionConstraint>) {
+    return "PointLineRegionConstraint";
+  } else if constexpr (std::same_as<T, PointPointMaxConstraint>) {
+    return "PointPointMaxConstraint";
+  } else if constexpr (std::same_as<T, PointPointMinConstraint>) {
+    return "PointPointMinConstraint";
+  } else if constexpr (std::same_as<T, PolygonKeepOutConstraint>) {
+    return "PolygonKeepOutConstraint";
+  } else if constexpr (std::same_as<T, PoseEqualityConstraint>) {
+    return "PoseEqualityConstraint";
+  } else if constexpr (std::same_as<T, TranslationEqualityConstraint>) {
+    return "TranslationEqualityConstraint";
+  } else {
+    // Depends on T, so it only fails for a type without a name above
+    static_assert(sizeof(T) == 0, "Every Constraint type needs a name");
+  }
+}
+
+}  // namespace
+
+std::string_view constraint_name(const Constraint& constraint) {
+  return std::visit(
+      []<typename T>(const T&) { return constraint_type_name<T>(); },
+      constraint);
+}
+
+size_t peak_memory_usage() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                            sizeof(counters))) {
+    return 0;
+  }
+  return counters.PeakWorkingSetSize;
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  // macOS reports bytes
+  return static_cast<size_t>(usage.ru_maxrss);
+#else
+  // Linux reports kibibytes
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+}  // namespace trajopt
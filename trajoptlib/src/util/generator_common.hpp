@@ -0,0 +1,220 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <numeric>
+#include <span>
+#include <variant>
+#include <vector>
+
+#include <sleipnir/autodiff/variable.hpp>
+#include <sleipnir/optimization/problem.hpp>
+#include <sleipnir/optimization/solver/exit_status.hpp>
+
+#include "trajopt/constraint/constraint.hpp"
+#include "trajopt/geometry/pose2.hpp"
+#include "trajopt/geometry/rotation2.hpp"
+#include "trajopt/geometry/translation2.hpp"
+#include "trajopt/swerve_trajectory_generator.hpp"
+#include "trajopt/util/generation_stats.hpp"
+#include "trajopt/util/trajopt_util.hpp"
+
+namespace trajopt::detail {
+
+/// The number of wheels a swerve drivetrain's weight is shared between when
+/// each module's friction force is limited.
+inline constexpr int swerve_num_wheels = 4;
+
+/// Returns true if a solve's exit status doesn't come with a solution.
+inline bool failed(slp::ExitStatus status) {
+  return static_cast<int>(status) < 0 ||
+         status == slp::ExitStatus::CALLBACK_REQUESTED_STOP;
+}
+
+/// Sends an iteration's solution to a path's callbacks, at most 60 times a
+/// second.
+///
+/// @param path The path whose callbacks are sent the solution.
+/// @param handle The handle the callbacks are sent with the solution.
+/// @param now The time of the iteration.
+/// @param last_callback_time The time the callbacks were last sent a solution,
+///     which is updated if they're sent this one.
+/// @param construct_solution Returns the iteration's solution. It's only
+///     called if the callbacks are sent the solution.
+template <typename Path, typename ConstructSolution>
+void send_to_callbacks(
+    Path& path, int64_t handle, std::chrono::steady_clock::time_point now,
+    std::chrono::steady_clock::time_point& last_callback_time,
+    ConstructSolution&& construct_solution) {
+  constexpr int fps = 60;
+  constexpr std::chrono::duration<double> time_per_frame{1.0 / fps};
+
+  // FPS limit on sending updates
+  if (!path.callbacks.empty() && now - last_callback_time >= time_per_frame) {
+    last_callback_time = now;
+
+    auto soln = construct_solution();
+    for (auto& callback : path.callbacks) {
+      callback(soln, handle);
+    }
+  }
+}
+
+/// Minimizes a problem's total time.
+///
+/// Each time step is bounded and seeded from the initial guess's. Segments
+/// without control intervals take no time.
+///
+/// @param problem The problem.
+/// @param dts The time step of each sample.
+/// @param Ns The control interval count of each segment.
+/// @param initial_dts The initial guess's time step of each sample.
+inline void minimize_total_time(slp::Problem<double>& problem,
+                                std::vector<slp::Variable<double>>& dts,
+                                const std::vector<size_t>& Ns,
+                                const std::vector<double>& initial_dts) {
+  for (size_t sgmt_index = 0; sgmt_index < Ns.size(); ++sgmt_index) {
+    size_t N_sgmt = Ns.at(sgmt_index);
+    size_t sgmt_start = get_index(Ns, sgmt_index);
+    size_t sgmt_end = get_index(Ns, sgmt_index + 1);
+
+    if (N_sgmt == 0) {
+      for (size_t index = sgmt_start; index < sgmt_end + 1; ++index) {
+        dts.at(index).set_value(0.0);
+      }
+    } else {
+      for (size_t index = sgmt_start; index < sgmt_end + 1; ++index) {
+        auto& dt = dts.at(index);
+        problem.subject_to(slp::bounds(0, dt, 3));
+        dt.set_value(initial_dts.at(index));
+      }
+    }
+  }
+  problem.minimize(std::accumulate(dts.begin(), dts.end(), slp::Variable{0.0}));
+}
+
+/// A swerve problem's state variables at each sample.
+struct SwerveStateVariables {
+  std::vector<slp::Variable<double>>& x;
+  std::vector<slp::Variable<double>>& y;
+  std::vector<slp::Variable<double>>& cosθ;
+  std::vector<slp::Variable<double>>& sinθ;
+  std::vector<slp::Variable<double>>& vx;
+  std::vector<slp::Variable<double>>& vy;
+  std::vector<slp::Variable<double>>& ω;
+  std::vector<slp::Variable<double>>& ax;
+  std::vector<slp::Variable<double>>& ay;
+  std::vector<slp::Variable<double>>& α;
+};
+
+/// Applies a constraint to a swerve problem's states at a sample. Parametric
+/// constraints use the given parameters in place of their parameter values.
+///
+/// @param problem The problem.
+/// @param states The problem's state variables.
+/// @param constraint The constraint.
+/// @param index The sample's index.
+/// @param parameters The parameters of a parametric constraint.
+template <typename T>
+void apply_swerve_constraint(
+    slp::Problem<double>& problem, const SwerveStateVariables& states,
+    T& constraint, size_t index,
+    std::span<const slp::Variable<double>> parameters) {
+  Pose2v<double> pose_k{states.x.at(index),
+                        states.y.at(index),
+                        {states.cosθ.at(index), states.sinθ.at(index)}};
+  Translation2v<double> v_k{states.vx.at(index), states.vy.at(index)};
+  auto ω_k = states.ω.at(index);
+  Translation2v<double> a_k{states.ax.at(index), states.ay.at(index)};
+  auto α_k = states.α.at(index);
+
+  if constexpr (ParametricConstraintLike<T>) {
+    constraint.apply_parametric(problem, pose_k, v_k, ω_k, a_k, α_k,
+                                parameters);
+  } else {
+    constraint.apply(problem, pose_k, v_k, ω_k, a_k, α_k);
+  }
+}
+
+/// Applies a swerve path's waypoint and segment constraints to a problem and
+/// counts them.
+///
+/// @param problem The problem.
+/// @param states The problem's state variables.
+/// @param path The path.
+/// @param Ns The control interval count of each segment.
+/// @param stats The statistics the applied constraints are counted in.
+/// @param make_parameters Returns the parameters a parametric constraint is
+///     applied with from its parameter values. A segment constraint's samples
+///     share them.
+/// @param defer Returns true if a constraint is left out of the problem at a
+///     sample.
+template <typename MakeParameters, typename Defer>
+void apply_swerve_path_constraints(slp::Problem<double>& problem,
+                                   const SwerveStateVariables& states,
+                                   SwervePath& path,
+                                   const std::vector<size_t>& Ns,
+                                   GenerationStats& stats,
+                                   MakeParameters&& make_parameters,
+                                   Defer&& defer) {
+  // Creates the parameters of a constraint
+  auto make_constraint_parameters = [&]<typename T>(const T& constraint) {
+    if constexpr (ParametricConstraintLike<T>) {
+      return make_parameters(constraint.parameter_values());
+    } else {
+      return std::vector<slp::Variable<double>>{};
+    }
+  };
+
+  const size_t wpt_cnt = path.waypoints.size();
+  for (size_t wpt_index = 0; wpt_index < wpt_cnt; ++wpt_index) {
+    // First index of next wpt - 1
+    size_t index = get_index(Ns, wpt_index, 0);
+
+    for (auto& constraint : path.waypoints.at(wpt_index).waypoint_constraints) {
+      if (defer(constraint, index)) {
+        continue;
+      }
+
+      std::visit(
+          [&](auto& arg) {
+            apply_swerve_constraint(problem, states, arg, index,
+                                    make_constraint_parameters(arg));
+          },
+          constraint);
+      stats.count_constraint(constraint);
+    }
+  }
+
+  for (size_t sgmt_index = 0; sgmt_index + 1 < wpt_cnt; ++sgmt_index) {
+    size_t start_index = get_index(Ns, sgmt_index, 0);
+    size_t end_index = get_index(Ns, sgmt_index + 1, 0);
+
+    for (auto& constraint :
+         path.waypoints.at(sgmt_index + 1).segment_constraints) {
+      size_t applied = 0;
+      std::visit(
+          [&](auto& arg) {
+            // Every sample in the segment shares the constraint's parameters
+            auto constraint_parameters = make_constraint_parameters(arg);
+            for (size_t index = start_index; index < end_index; ++index) {
+              if (defer(constraint, index)) {
+                continue;
+              }
+
+              apply_swerve_constraint(problem, states, arg, index,
+                                      constraint_parameters);
+              ++applied;
+            }
+          },
+          constraint);
+      stats.count_constraint(constraint, applied);
+    }
+  }
+}
+
+}  // namespace trajopt::detail
@@ -0,0 +1,114 @@
+// Copyright (c) TrajoptLib contributors
+
+#include "trajopt/util/work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace trajopt {
+
+WorkStealingPool::WorkStealingPool(size_t thread_count) {
+  if (thread_count == 0) {
+    thread_count =
+        std::max(size_t{1}, size_t{std::thread::hardware_concurrency()});
+  }
+
+  m_queues.reserve(thread_count);
+  for (size_t i = 0; i < thread_count; ++i) {
+    m_queues.emplace_back(std::make_unique<Queue>());
+  }
+
+  m_threads.reserve(thread_count);
+  for (size_t i = 0; i < thread_count; ++i) {
+    m_threads.emplace_back([this, i] { run(i); });
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::scoped_lock lock{m_mutex};
+    m_stopping = true;
+  }
+  m_work_available.notify_all();
+
+  // std::jthread joins on destruction
+  m_threads.clear();
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+  {
+    std::scoped_lock lock{m_mutex};
+    auto& queue = *m_queues[m_next_queue];
+    m_next_queue = (m_next_queue + 1) % m_queues.size();
+
+    std::scoped_lock queue_lock{queue.mutex};
+    queue.tasks.emplace_back(std::move(task));
+    ++m_queued_count;
+    ++m_pending_count;
+  }
+  m_work_available.notify_one();
+}
+
+void WorkStealingPool::wait() {
+  std::unique_lock lock{m_mutex};
+  m_idle.wait(lock, [this] { return m_pending_count == 0; });
+}
+
+void WorkStealingPool::run(size_t index) {
+  while (true) {
+    std::function<void()> task;
+    if (try_pop(index, task)) {
+      task();
+
+      std::scoped_lock lock{m_mutex};
+      if (--m_pending_count == 0) {
+        m_idle.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock lock{m_mutex};
+    m_work_available.wait(
+        lock, [this] { return m_stopping || m_queued_count > 0; });
+    if (m_stopping && m_queued_count == 0) {
+      return;
+    }
+  }
+}
+
+bool WorkStealingPool::try_pop(size_t index, std::function<void()>& task) {
+  // Take the newest task from our own queue first, then steal the oldest task
+  // from the other workers' queues
+  for (size_t offset = 0; offset < m_queues.size(); ++offset) {
+    auto& queue = *m_queues[(index + offset) % m_queues.size()];
+
+    {
+      std::scoped_lock queue_lock{queue.mutex};
+      if (queue.tasks.empty()) {
+        continue;
+      }
+
+      if (offset == 0) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+    }
+
+    // The queue lock must be released first since submit() acquires the pool
+    // lock before the queue lock
+    std::scoped_lock lock{m_mutex};
+    --m_queued_count;
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace trajopt
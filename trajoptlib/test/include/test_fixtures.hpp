@@ -0,0 +1,74 @@
+// Copyright (c) TrajoptLib contributors
+
+#pragma once
+
+#include <stddef.h>
+
+#include <utility>
+#include <vector>
+
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/geometry/pose2.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+
+namespace test_fixtures {
+
+/// Returns a 45 kg swerve drivetrain with a module at each corner of a 1.2 m
+/// square.
+inline trajopt::SwerveDrivetrain swerve_drivetrain() {
+  return trajopt::SwerveDrivetrain{
+      .mass = 45,
+      .moi = 6,
+      .wheel_radius = 0.04,
+      .wheel_max_angular_velocity = 70,
+      .wheel_max_torque = 2,
+      .wheel_cof = 1.5,
+      .modules = {{+0.6, +0.6}, {+0.6, -0.6}, {-0.6, +0.6}, {-0.6, -0.6}}};
+}
+
+/// Returns a 45 kg differential drivetrain with a 0.6 m trackwidth.
+inline trajopt::DifferentialDrivetrain differential_drivetrain() {
+  return trajopt::DifferentialDrivetrain{.mass = 45,
+                                         .moi = 6,
+                                         .wheel_radius = 0.08,
+                                         .wheel_max_angular_velocity = 70,
+                                         .wheel_max_torque = 5,
+                                         .wheel_cof = 1.5,
+                                         .trackwidth = 0.6};
+}
+
+/// Returns a path through pose waypoints for swerve_drivetrain().
+///
+/// @param poses The pose of each waypoint.
+/// @param control_interval_counts The control interval count of each segment.
+inline trajopt::SwervePathBuilder make_swerve_path(
+    const std::vector<trajopt::Pose2d>& poses,
+    std::vector<size_t> control_interval_counts) {
+  trajopt::SwervePathBuilder path;
+  path.set_drivetrain(swerve_drivetrain());
+  for (size_t index = 0; index < poses.size(); ++index) {
+    const auto& pose = poses[index];
+    path.pose_wpt(index, pose.x(), pose.y(), pose.rotation().radians());
+  }
+  path.set_control_interval_counts(std::move(control_interval_counts));
+  return path;
+}
+
+/// Returns a path through pose waypoints for differential_drivetrain().
+///
+/// @param poses The pose of each waypoint.
+/// @param control_interval_counts The control interval count of each segment.
+inline trajopt::DifferentialPathBuilder make_differential_path(
+    const std::vector<trajopt::Pose2d>& poses,
+    std::vector<size_t> control_interval_counts) {
+  trajopt::DifferentialPathBuilder path;
+  path.set_drivetrain(differential_drivetrain());
+  for (size_t index = 0; index < poses.size(); ++index) {
+    const auto& pose = poses[index];
+    path.pose_wpt(index, pose.x(), pose.y(), pose.rotation().radians());
+  }
+  path.set_control_interval_counts(std::move(control_interval_counts));
+  return path;
+}
+
+}  // namespace test_fixtures
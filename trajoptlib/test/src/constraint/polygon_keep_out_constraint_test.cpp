@@ -0,0 +1,94 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <numbers>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+
+#include "test_fixtures.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("PolygonKeepOutConstraint - Margin", "[PolygonKeepOutConstraint]") {
+  using namespace trajopt;
+
+  // A 1 m square robot and a 1 m square obstacle centered at (3, 0)
+  PolygonKeepOutConstraint constraint{
+      {{0.5, 0.5}, {-0.5, 0.5}, {-0.5, -0.5}, {0.5, -0.5}},
+      {{2.5, -0.5}, {3.5, -0.5}, {3.5, 0.5}, {2.5, 0.5}},
+      0.25};
+
+  // Facing edges 2 m apart
+  CHECK_THAT(constraint.margin({0.0, 0.0, 0.0}), WithinAbs(2.0 - 0.25, 1e-9));
+
+  // Rotated 45°, the robot's corner reaches √2/2 m toward the obstacle
+  CHECK_THAT(constraint.margin({0.0, 0.0, std::numbers::pi / 4}),
+             WithinAbs(2.5 - std::sqrt(2.0) / 2 - 0.25, 1e-9));
+
+  // Overlapping by 0.5 m
+  CHECK_THAT(constraint.margin({2.5, 0.0, 0.0}), WithinAbs(-0.5 - 0.25, 1e-9));
+}
+
+TEST_CASE("PolygonKeepOutConstraint - Solve", "[PolygonKeepOutConstraint]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path;
+  path.set_drivetrain(test_fixtures::swerve_drivetrain());
+  path.set_bumpers(0.4, 0.4, 0.4, 0.4);
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 4.0, 0.0, 0.0);
+  path.set_control_interval_counts({20});
+
+  // A square in the way, which the robot has to go around
+  PolygonKeepOutConstraint constraint{
+      path.get_bumpers().front().points,
+      {{1.8, -0.1}, {2.2, -0.1}, {2.2, 0.3}, {1.8, 0.3}},
+      0.05};
+  path.sgmt_constraint(0, 1, constraint);
+
+  GenerationStats stats;
+  auto solution = SwerveTrajectoryGenerator{path}.generate(false, &stats);
+  REQUIRE(solution.has_value());
+
+  // Each application adds a separating axis and offset
+  REQUIRE(stats.constraint_counts.at("PolygonKeepOutConstraint") > 0);
+  CHECK(stats.decision_variable_counts.at("PolygonKeepOutConstraint") ==
+        3 * stats.constraint_counts.at("PolygonKeepOutConstraint"));
+
+  for (size_t i = 0; i < solution->x.size(); ++i) {
+    Pose2d pose{solution->x[i], solution->y[i],
+                Rotation2d{solution->thetacos[i], solution->thetasin[i]}};
+    CHECK(constraint.margin(pose) >= -1e-3);
+  }
+}
+
+TEST_CASE("PolygonKeepOutConstraint - Solve without safety distance",
+          "[PolygonKeepOutConstraint]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path;
+  path.set_drivetrain(test_fixtures::swerve_drivetrain());
+  path.set_bumpers(0.4, 0.4, 0.4, 0.4);
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 4.0, 0.0, 0.0);
+  path.set_control_interval_counts({20});
+
+  // With no safety distance, only a unit separating axis keeps the square out
+  KeepOutRegion obstacle{
+      .safety_distance = 0.0,
+      .points = {{1.8, -0.1}, {2.2, -0.1}, {2.2, 0.3}, {1.8, 0.3}}};
+  path.add_obstacle(obstacle);
+  PolygonKeepOutConstraint constraint{path.get_bumpers().front().points,
+                                      obstacle.points, 0.0};
+
+  auto solution = SwerveTrajectoryGenerator{path}.generate();
+  REQUIRE(solution.has_value());
+  for (size_t i = 0; i < solution->x.size(); ++i) {
+    Pose2d pose{solution->x[i], solution->y[i],
+                Rotation2d{solution->thetacos[i], solution->thetasin[i]}};
+    // Clear of the obstacle, to within the solver's tolerance
+    CHECK(constraint.margin(pose) >= -1e-4);
+  }
+}
@@ -0,0 +1,48 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/decomposed_trajectory_generator.hpp>
+
+#include "test_fixtures.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("DecomposedTrajectoryGenerator - Legs between full stops",
+          "[DecomposedTrajectoryGenerator]") {
+  trajopt::SwervePathBuilder path;
+  path.set_drivetrain(test_fixtures::swerve_drivetrain());
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 4.0, 0.0, 0.0);
+  path.pose_wpt(2, 4.0, 4.0, 1.0);
+  path.translation_wpt(3, 2.0, 4.0);
+  path.pose_wpt(4, 0.0, 4.0, 0.0);
+  path.set_control_interval_counts({20, 20, 10, 10});
+
+  // A stop needs a fixed pose and zero velocity
+  for (size_t index : {1, 2, 3}) {
+    path.wpt_constraint(index,
+                        trajopt::LinearVelocityMaxMagnitudeConstraint{0.0});
+    path.wpt_constraint(index,
+                        trajopt::AngularVelocityMaxMagnitudeConstraint{0.0});
+  }
+  CHECK(path.full_stop_waypoints() == std::vector<size_t>{1, 2});
+
+  trajopt::SwerveDecomposedTrajectoryGenerator generator{path};
+  CHECK(generator.leg_count() == 3);
+
+  trajopt::GenerationStats stats;
+  auto solution = generator.generate(0, false, &stats);
+  REQUIRE(solution.has_value());
+
+  CHECK(solution->x.size() == 61);
+  CHECK(stats.decision_variable_counts.at("time steps") == 63);
+  for (size_t index : {20, 40}) {
+    CHECK_THAT(solution->vx[index], WithinAbs(0.0, 1e-6));
+    CHECK_THAT(solution->vy[index], WithinAbs(0.0, 1e-6));
+  }
+  CHECK_THAT(solution->x[20], WithinAbs(4.0, 1e-6));
+  CHECK_THAT(solution->y[40], WithinAbs(4.0, 1e-6));
+}
@@ -0,0 +1,44 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <stddef.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/differential_trajectory_generator.hpp>
+
+#include "test_fixtures.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("DifferentialTrajectoryGenerator - Warm start",
+          "[DifferentialTrajectoryGenerator]") {
+  auto previous_path = test_fixtures::make_differential_path(
+      {{0.0, 0.0, 0.0}, {4.0, 1.0, 0.0}}, {20});
+  auto previous =
+      trajopt::DifferentialTrajectoryGenerator{previous_path}.generate();
+  REQUIRE(previous.has_value());
+
+  // The path's end moves slightly, with the same control interval counts and
+  // with counts the previous solution has to be resampled onto
+  for (size_t control_interval_count : {20, 30}) {
+    auto path = test_fixtures::make_differential_path(
+        {{0.0, 0.0, 0.0}, {4.1, 1.0, 0.0}}, {control_interval_count});
+
+    trajopt::GenerationStats cold_stats;
+    auto cold = trajopt::DifferentialTrajectoryGenerator{path}.generate(
+        false, &cold_stats);
+    REQUIRE(cold.has_value());
+
+    trajopt::DifferentialTrajectoryGenerator generator{path};
+    CHECK(generator.warm_start(previous.value(), {20}));
+    trajopt::GenerationStats warm_stats;
+    auto warm = generator.generate(false, &warm_stats);
+    REQUIRE(warm.has_value());
+
+    CHECK(warm->x.size() == control_interval_count + 1);
+    CHECK(warm_stats.iterations < cold_stats.iterations);
+    CHECK_THAT(warm->x.back(), WithinAbs(cold->x.back(), 1e-6));
+    CHECK_THAT(warm->y.back(), WithinAbs(cold->y.back(), 1e-6));
+    CHECK_THAT(warm->heading.back(), WithinAbs(cold->heading.back(), 1e-6));
+  }
+}
@@ -0,0 +1,48 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <stddef.h>
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/multi_resolution_trajectory_generator.hpp>
+
+#include "test_fixtures.hpp"
+
+TEST_CASE("MultiResolutionTrajectoryGenerator - Final level matches path",
+          "[MultiResolutionTrajectoryGenerator]") {
+  auto path = test_fixtures::make_swerve_path(
+      {{0.0, 0.0, 0.0}, {4.0, 0.0, 0.0}, {4.0, 4.0, 1.0}}, {32, 32});
+
+  trajopt::SwerveMultiResolutionTrajectoryGenerator generator{path};
+
+  trajopt::GenerationStats stats;
+  auto solution = generator.generate(false, &stats);
+  REQUIRE(solution.has_value());
+
+  CHECK(solution->x.size() == 65);
+
+  // Sizes are summed over the coarse levels and the final one
+  CHECK(stats.decision_variable_counts.at("time steps") > 65);
+}
+
+TEST_CASE("MultiResolutionTrajectoryGenerator - Refinement follows defects",
+          "[MultiResolutionTrajectoryGenerator]") {
+  // With one level after the next, the next level has half the path's
+  // resolution before weighting by defect
+  trajopt::MultiResolutionOptions options{.levels = 3};
+
+  // The segment with the larger defect gets more intervals
+  auto counts = trajopt::refine_control_interval_counts({1.0, 4.0}, {8, 8},
+                                                        {32, 32}, options, 1);
+  CHECK(counts == std::vector<size_t>{8, 26});
+
+  counts = trajopt::refine_control_interval_counts({4.0, 1.0}, {8, 8},
+                                                   {32, 32}, options, 1);
+  CHECK(counts == std::vector<size_t>{26, 8});
+
+  // Equal defects split the resolution evenly
+  counts = trajopt::refine_control_interval_counts({2.0, 2.0}, {8, 8},
+                                                   {32, 32}, options, 1);
+  CHECK(counts == std::vector<size_t>{16, 16});
+}
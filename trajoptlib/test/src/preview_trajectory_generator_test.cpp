@@ -0,0 +1,90 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <cmath>
+#include <numbers>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/preview_trajectory_generator.hpp>
+
+#include "test_fixtures.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("PreviewTrajectoryGenerator - Swerve wheel limits",
+          "[PreviewTrajectoryGenerator]") {
+  auto drivetrain = test_fixtures::swerve_drivetrain();
+
+  trajopt::SwervePathBuilder path;
+  path.set_drivetrain(drivetrain);
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 4.0, 2.0, 1.0);
+  path.set_control_interval_counts({20});
+
+  trajopt::SwervePreviewTrajectoryGenerator generator{path};
+  auto solution = generator.generate();
+
+  REQUIRE(solution.x.size() == 21);
+  REQUIRE(solution.module_fx.size() == 21);
+  CHECK_THAT(solution.x.front(), WithinAbs(0.0, 1e-9));
+  CHECK_THAT(solution.x.back(), WithinAbs(4.0, 1e-9));
+  CHECK_THAT(solution.y.back(), WithinAbs(2.0, 1e-9));
+  CHECK_THAT(std::atan2(solution.thetasin.back(), solution.thetacos.back()),
+             WithinAbs(1.0, 1e-9));
+  CHECK_THAT(solution.vx.front(), WithinAbs(0.0, 1e-9));
+  CHECK_THAT(solution.vx.back(), WithinAbs(0.0, 1e-9));
+  CHECK(solution.dt.front() > 0.0);
+
+  const double v_wheel =
+      drivetrain.wheel_radius * drivetrain.wheel_max_angular_velocity;
+  for (size_t index = 0; index < solution.x.size(); ++index) {
+    CHECK(solution.dt[index] == solution.dt.front());
+    trajopt::Rotation2d heading{solution.thetacos[index],
+                                solution.thetasin[index]};
+    for (const auto& module : drivetrain.modules) {
+      auto r = module.rotate_by(heading);
+      double wheel_speed =
+          std::hypot(solution.vx[index] - solution.omega[index] * r.y(),
+                     solution.vy[index] + solution.omega[index] * r.x());
+      CHECK(wheel_speed <= v_wheel * (1.0 + 1e-6));
+    }
+  }
+}
+
+TEST_CASE("PreviewTrajectoryGenerator - Differential stop",
+          "[PreviewTrajectoryGenerator]") {
+  auto path = test_fixtures::make_differential_path(
+      {{0.0, 0.0, 0.0}, {3.0, 0.0, 0.0}, {6.0, 0.0, 0.0}}, {10, 10});
+  path.wpt_constraint(1, trajopt::LinearVelocityMaxMagnitudeConstraint{0.0});
+
+  trajopt::DifferentialPreviewTrajectoryGenerator generator{path};
+  auto solution = generator.generate();
+
+  REQUIRE(solution.x.size() == 21);
+  CHECK_THAT(solution.x[10], WithinAbs(3.0, 1e-9));
+  for (size_t index : {0, 10, 20}) {
+    CHECK_THAT(solution.vl[index], WithinAbs(0.0, 1e-9));
+    CHECK_THAT(solution.vr[index], WithinAbs(0.0, 1e-9));
+  }
+
+  // Both segments are the same straight line, so they take the same time
+  CHECK_THAT(solution.dt[0], WithinAbs(solution.dt[19], 1e-9));
+}
+
+TEST_CASE("PreviewTrajectoryGenerator - Differential rotate in place",
+          "[PreviewTrajectoryGenerator]") {
+  auto path = test_fixtures::make_differential_path(
+      {{0.0, 0.0, 0.0}, {0.0, 0.0, std::numbers::pi / 2}}, {10});
+
+  // The course has zero length, so the guess turns the robot on the spot
+  trajopt::DifferentialPreviewTrajectoryGenerator generator{path};
+  auto solution = generator.generate();
+
+  REQUIRE(solution.x.size() == 11);
+  for (size_t index = 0; index < solution.x.size(); ++index) {
+    CHECK_THAT(solution.x[index], WithinAbs(0.0, 1e-9));
+    CHECK_THAT(solution.y[index], WithinAbs(0.0, 1e-9));
+    CHECK_THAT(solution.vl[index], WithinAbs(-solution.vr[index], 1e-9));
+  }
+  CHECK_THAT(solution.heading.back(), WithinAbs(std::numbers::pi / 2, 1e-9));
+}
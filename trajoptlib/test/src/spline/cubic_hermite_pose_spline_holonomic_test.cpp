@@ -0,0 +1,45 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/geometry/rotation2.hpp>
+#include <trajopt/spline/cubic_hermite_pose_spline_holonomic.hpp>
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("CubicHermitePoseSplineHolonomic - Batch matches single points",
+          "[CubicHermitePoseSplineHolonomic]") {
+  trajopt::CubicHermitePoseSplineHolonomic spline{
+      {0.0, 2.0}, {3.0, 1.0}, {0.0, 0.5}, {1.0, -1.0},
+      trajopt::Rotation2d{0.3}, trajopt::Rotation2d{2.0}};
+
+  std::vector<double> t{0.0, 0.1, 0.25, 0.5, 0.9, 1.0};
+
+  for (bool is_differential : {false, true}) {
+    auto points = spline.get_points(t, is_differential);
+    REQUIRE(points.has_value());
+    REQUIRE(points->x.size() == t.size());
+
+    for (size_t k = 0; k < t.size(); ++k) {
+      auto [pose, curvature] = spline.get_point(t[k], is_differential).value();
+      CHECK_THAT(points->x[k], WithinAbs(pose.x(), 1e-12));
+      CHECK_THAT(points->y[k], WithinAbs(pose.y(), 1e-12));
+      CHECK_THAT(points->cos[k], WithinAbs(pose.rotation().cos(), 1e-9));
+      CHECK_THAT(points->sin[k], WithinAbs(pose.rotation().sin(), 1e-9));
+      CHECK_THAT(points->curvature[k], WithinAbs(curvature, 1e-9));
+    }
+  }
+}
+
+TEST_CASE("CubicHermitePoseSplineHolonomic - Batch rejects zero velocity",
+          "[CubicHermitePoseSplineHolonomic]") {
+  // A spline that stays at one point has no course
+  trajopt::CubicHermitePoseSplineHolonomic spline{
+      {1.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}, {2.0, 0.0},
+      trajopt::Rotation2d{}, trajopt::Rotation2d{1.0}};
+
+  std::vector<double> t{0.0, 0.5};
+  CHECK_FALSE(spline.get_points(t, false).has_value());
+}
@@ -6,6 +6,8 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <trajopt/swerve_trajectory_generator.hpp>
 
+#include "test_fixtures.hpp"
+
 using Catch::Matchers::WithinAbs;
 
 TEST_CASE("SwervePathBuilder - Linear initial guess", "[SwervePathBuilder]") {
@@ -51,3 +53,62 @@ TEST_CASE("SwervePathBuilder - Spline initial guess", "[SwervePathBuilder]") {
     CHECK_THAT(result[i], WithinAbs(expected[i], 1e-15));
   }
 }
+
+TEST_CASE("SwervePathBuilder - Control interval count estimate",
+          "[SwervePathBuilder]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path;
+  path.set_drivetrain(test_fixtures::swerve_drivetrain());
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 1.0, 0.0, 0.0);
+  path.pose_wpt(2, 5.0, 0.0, 0.0);
+
+  // Short hops get fewer samples than long runs
+  CHECK(path.estimate_control_interval_counts() == std::vector<size_t>{10, 21});
+
+  // Slower segments take longer, so they get more samples
+  path.sgmt_constraint(1, 2, LinearVelocityMaxMagnitudeConstraint{1.0});
+  CHECK(path.estimate_control_interval_counts() == std::vector<size_t>{10, 43});
+
+  // Longer time steps give fewer samples
+  CHECK(path.estimate_control_interval_counts(0.2) ==
+        std::vector<size_t>{5, 22});
+}
+
+TEST_CASE("SwervePathBuilder - Obstacle corridor", "[SwervePathBuilder]") {
+  using namespace trajopt;
+
+  SwervePathBuilder path;
+  path.set_bumpers(0.5, 0.5, 0.5, 0.5);
+  path.pose_wpt(0, 0.0, 0.0, 0.0);
+  path.pose_wpt(1, 4.0, 0.0, 0.0);
+  path.pose_wpt(2, 4.0, 4.0, 0.0);
+  path.set_control_interval_counts({8, 8});
+
+  // Beside the first segment, beside the second segment, and far from both
+  path.add_obstacle({.safety_distance = 0.2, .points = {{2.0, 1.0}}});
+  path.add_obstacle(
+      {.safety_distance = 0.1,
+       .points = {{4.5, 2.0}, {5.0, 2.0}, {5.0, 3.0}, {4.5, 3.0}}});
+  path.add_obstacle({.safety_distance = 0.2, .points = {{10.0, 10.0}}});
+
+  // A region without points is ignored
+  CHECK_FALSE(path.add_obstacle({.safety_distance = 0.2, .points = {}}));
+  CHECK(path.get_obstacles().size() == 3);
+
+  CHECK(path.get_obstacles().query({1.5, 0.5}, {2.5, 1.5}) ==
+        std::vector<size_t>{0});
+  CHECK(path.get_obstacles().query({6.0, 6.0}, {8.0, 8.0}).empty());
+
+  auto constraints =
+      path.obstacle_constraints(path.calculate_linear_initial_guess());
+  REQUIRE(constraints.size() == 2);
+
+  // A circle keeps each of the 4 bumper corners and edges away from its
+  // center, and a square is kept apart from the bumpers by one constraint
+  CHECK(constraints[0].near.size() == 8);
+  CHECK(constraints[0].far.size() == 1 + 8);
+  CHECK(constraints[1].near.size() == 1);
+  CHECK(constraints[1].far.size() == 8 + 8);
+}
@@ -0,0 +1,360 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+
+#include "test_fixtures.hpp"
+
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+namespace {
+
+trajopt::SwervePathBuilder make_path(double end_x, double max_velocity) {
+  auto path = test_fixtures::make_swerve_path(
+      {{0.0, 0.0, 0.0}, {end_x, 0.0, 0.0}}, {10});
+  path.sgmt_constraint(
+      0, 1, trajopt::LinearVelocityMaxMagnitudeConstraint{max_velocity});
+  return path;
+}
+
+trajopt::SwervePathBuilder make_parametric_path(double end_x,
+                                                double max_velocity) {
+  auto path = make_path(end_x, max_velocity);
+  path.set_parametric(true);
+  return path;
+}
+
+double total_time(const trajopt::SwerveSolution& solution) {
+  return std::accumulate(solution.dt.begin(), solution.dt.end(), 0.0);
+}
+
+}  // namespace
+
+TEST_CASE("SwerveTrajectoryGenerator - Update parameters in place",
+          "[SwerveTrajectoryGenerator]") {
+  trajopt::SwerveTrajectoryGenerator generator{make_parametric_path(1.0, 2.5)};
+  REQUIRE(generator.generate().has_value());
+
+  // The new velocity limit is low enough to be reached
+  REQUIRE(generator.update(make_parametric_path(1.05, 1.5)));
+  auto updated = generator.generate();
+  REQUIRE(updated.has_value());
+
+  auto fresh =
+      trajopt::SwerveTrajectoryGenerator{make_path(1.05, 1.5)}.generate();
+  REQUIRE(fresh.has_value());
+
+  CHECK_THAT(updated->x.back(), WithinAbs(fresh->x.back(), 1e-6));
+  CHECK_THAT(updated->y.back(), WithinAbs(fresh->y.back(), 1e-6));
+  CHECK_THAT(
+      std::atan2(updated->thetasin.back(), updated->thetacos.back()),
+      WithinAbs(std::atan2(fresh->thetasin.back(), fresh->thetacos.back()),
+                1e-6));
+  CHECK_THAT(total_time(updated.value()),
+             WithinRel(total_time(fresh.value()), 1e-3));
+
+  double max_velocity = 0.0;
+  for (size_t i = 0; i < updated->vx.size(); ++i) {
+    max_velocity =
+        std::max(max_velocity, std::hypot(updated->vx[i], updated->vy[i]));
+  }
+  CHECK(max_velocity <= 1.5 + 1e-6);
+  CHECK(max_velocity > 1.5 - 1e-3);
+}
+
+TEST_CASE("SwerveTrajectoryGenerator - Update rejects structural changes",
+          "[SwerveTrajectoryGenerator]") {
+  trajopt::SwerveTrajectoryGenerator generator{make_parametric_path(1.0, 2.0)};
+
+  // A zero velocity limit is an equality constraint instead of an inequality
+  CHECK_FALSE(generator.update(make_parametric_path(1.0, 0.0)));
+
+  auto path = make_parametric_path(1.0, 2.0);
+  path.set_control_interval_counts({20});
+  CHECK_FALSE(generator.update(path));
+
+  path = make_parametric_path(1.0, 2.0);
+  path.wpt_constraint(1, trajopt::PointAtConstraint{
+                              trajopt::Translation2d{2.0, 0.0}, 0.1});
+  CHECK_FALSE(generator.update(path));
+
+  path = make_parametric_path(1.0, 2.0);
+  path.set_transcription(trajopt::Transcription::HERMITE_SIMPSON);
+  CHECK_FALSE(generator.update(path));
+
+  // Without parameters, values are folded into the problem
+  trajopt::SwerveTrajectoryGenerator constant{make_path(1.0, 2.0)};
+  CHECK_FALSE(constant.update(make_path(1.05, 2.5)));
+}
+
+TEST_CASE("SwerveTrajectoryGenerator - Warm start",
+          "[SwerveTrajectoryGenerator]") {
+  auto previous =
+      trajopt::SwerveTrajectoryGenerator{make_path(1.0, 2.0)}.generate();
+  REQUIRE(previous.has_value());
+
+  // The path's end moves slightly, with the same control interval counts and
+  // with counts the previous solution has to be resampled onto
+  for (size_t control_interval_count : {10, 15}) {
+    auto path = make_path(1.05, 2.0);
+    path.set_control_interval_counts({control_interval_count});
+
+    trajopt::GenerationStats cold_stats;
+    auto cold =
+        trajopt::SwerveTrajectoryGenerator{path}.generate(false, &cold_stats);
+    REQUIRE(cold.has_value());
+
+    trajopt::SwerveTrajectoryGenerator generator{path};
+    CHECK(generator.warm_start(previous.value(), {10}));
+    trajopt::GenerationStats warm_stats;
+    auto warm = generator.generate(false, &warm_stats);
+    REQUIRE(warm.has_value());
+
+    CHECK(warm->x.size() == control_interval_count + 1);
+    CHECK(warm_stats.iterations < cold_stats.iterations);
+    CHECK_THAT(warm->x.back(), WithinAbs(cold->x.back(), 1e-6));
+    CHECK_THAT(warm->y.back(), WithinAbs(cold->y.back(), 1e-6));
+    CHECK_THAT(std::atan2(warm->thetasin.back(), warm->thetacos.back()),
+               WithinAbs(std::atan2(cold->thetasin.back(),
+                                    cold->thetacos.back()),
+                         1e-6));
+  }
+}
+
+TEST_CASE("SwerveTrajectoryGenerator - Warm start checks the seed's layout",
+          "[SwerveTrajectoryGenerator]") {
+  auto previous =
+      trajopt::SwerveTrajectoryGenerator{make_path(1.0, 2.0)}.generate();
+  REQUIRE(previous.has_value());
+
+  trajopt::SwerveTrajectoryGenerator generator{make_path(1.05, 2.0)};
+
+  // The counts don't match the seed's sample count
+  CHECK_FALSE(generator.warm_start(previous.value(), {15}));
+
+  auto seed = previous.value();
+  seed.vx.pop_back();
+  CHECK_FALSE(generator.warm_start(seed, {10}));
+
+  seed = previous.value();
+  seed.module_fx.back().pop_back();
+  CHECK_FALSE(generator.warm_start(seed, {10}));
+
+  // A seed without module forces still seeds the states and time steps, and is
+  // resampled without them
+  seed = previous.value();
+  seed.module_fx.clear();
+  seed.module_fy.clear();
+  CHECK(generator.warm_start(seed, {10}));
+  CHECK(generator.generate().has_value());
+
+  auto path = make_path(1.05, 2.0);
+  path.set_control_interval_counts({15});
+  CHECK(trajopt::SwerveTrajectoryGenerator{path}.warm_start(seed, {10}));
+}
+
+TEST_CASE("SwerveTrajectoryGenerator - Pose-only progress",
+          "[SwerveTrajectoryGenerator]") {
+  trajopt::SwerveTrajectoryGenerator generator{make_path(1.0, 2.0)};
+  auto channel = generator.open_progress_channel(
+      {.payload = trajopt::ProgressPayload::POSES});
+  REQUIRE(generator.generate().has_value());
+  REQUIRE(channel->receive());
+
+  // Every field has an entry per sample, and the unpublished ones are zero
+  const auto& update = channel->read_buffer();
+  REQUIRE(update.x.size() == 11);
+  for (const auto* values : {&update.vx, &update.vy, &update.omega, &update.ax,
+                             &update.ay, &update.alpha}) {
+    CHECK(*values == std::vector(11, 0.0));
+  }
+  for (const auto* values : {&update.module_fx, &update.module_fy}) {
+    CHECK(*values == std::vector(11, std::vector(4, 0.0)));
+  }
+  CHECK(trajopt::SwerveTrajectory{update}.samples.size() == 11);
+}
+
+TEST_CASE("SwerveTrajectoryGenerator - Transcriptions",
+          "[SwerveTrajectoryGenerator]") {
+  using trajopt::Transcription;
+
+  auto reference = trajopt::SwerveTrajectoryGenerator{make_path(1.0, 2.0)}
+                       .generate();
+  REQUIRE(reference.has_value());
+
+  for (auto transcription :
+       {Transcription::HERMITE_SIMPSON, Transcription::RUNGE_KUTTA_4}) {
+    auto path = make_path(1.0, 2.0);
+    path.set_transcription(transcription);
+
+    auto solution = trajopt::SwerveTrajectoryGenerator{path}.generate();
+    REQUIRE(solution.has_value());
+
+    // Every scheme models the same motion
+    CHECK_THAT(total_time(solution.value()),
+               WithinRel(total_time(reference.value()), 0.05));
+  }
+}
+
+TEST_CASE("SwerveTrajectoryGenerator - Generation stats",
+          "[SwerveTrajectoryGenerator]") {
+  trajopt::SwerveTrajectoryGenerator generator{make_path(1.0, 2.0)};
+
+  trajopt::GenerationStats stats;
+  CHECK(generator.generate(false, &stats).has_value());
+
+  // 11 samples with 4 modules
+  CHECK(stats.decision_variable_counts.at("states") == 110);
+  CHECK(stats.decision_variable_counts.at("inputs") == 88);
+  CHECK(stats.decision_variable_counts.at("time steps") == 11);
+
+  CHECK(stats.constraint_counts.at("kinematics") == 10);
+  CHECK(stats.constraint_counts.at("dynamics") == 11);
+  CHECK(stats.constraint_counts.at("PoseEqualityConstraint") == 2);
+
+  // Every sample of the segment, plus the last waypoint. The first waypoint's
+  // copy constrains the segment's first sample again, so it's removed.
+  CHECK(stats.constraint_counts.at("LinearVelocityMaxMagnitudeConstraint") ==
+        11);
+  CHECK(stats.removed_duplicate_constraints == 1);
+
+  // Each of the 10 intervals builds its squared time step once
+  CHECK(stats.shared_subexpression_counts.at("squared time steps") == 10);
+
+  // Each of the 11 samples rotates its 4 module offsets once
+  CHECK(stats.shared_subexpression_counts.at("rotated module offsets") == 44);
+
+  CHECK(stats.iterations > 0);
+  CHECK(stats.solve_time > 0.0);
+}
+
+TEST_CASE("SwerveTrajectoryGenerator - Lazy geometric constraints",
+          "[SwerveTrajectoryGenerator]") {
+  auto path = make_path(4.0, 2.0);
+  path.set_lazy_geometric_constraints(0.5);
+  path.sgmt_constraint(0, 1,
+                       trajopt::PointPointMinConstraint{
+                           {0.0, 0.0}, {2.0, 5.0}, 0.5});
+
+  trajopt::GenerationStats stats;
+  REQUIRE(trajopt::SwerveTrajectoryGenerator{path}
+              .generate(false, &stats)
+              .has_value());
+
+  // The straight-line path never comes near the obstacle
+  CHECK(stats.inactive_constraints == 11);
+  CHECK_FALSE(stats.constraint_counts.contains("PointPointMinConstraint"));
+
+  // An obstacle on the initial guess is applied where it's needed
+  path = make_path(4.0, 2.0);
+  path.set_lazy_geometric_constraints(0.5);
+  path.sgmt_constraint(0, 1,
+                       trajopt::PointPointMinConstraint{
+                           {0.0, 0.0}, {2.0, 0.1}, 0.5});
+
+  auto solution = trajopt::SwerveTrajectoryGenerator{path}.generate(false,
+                                                                    &stats);
+  REQUIRE(solution.has_value());
+  CHECK(stats.constraint_counts.at("PointPointMinConstraint") > 0);
+  for (size_t i = 0; i < solution->x.size(); ++i) {
+    CHECK(std::hypot(solution->x[i] - 2.0, solution->y[i] - 0.1) >=
+          0.5 - 1e-3);
+  }
+}
+
+TEST_CASE("SwerveTrajectoryGenerator - Obstacles",
+          "[SwerveTrajectoryGenerator]") {
+  auto path = make_path(4.0, 2.0);
+  path.add_obstacle({.safety_distance = 0.5, .points = {{2.0, 0.1}}});
+  path.add_obstacle({.safety_distance = 0.5, .points = {{2.0, 5.0}}});
+
+  trajopt::GenerationStats stats;
+  auto solution =
+      trajopt::SwerveTrajectoryGenerator{path}.generate(false, &stats);
+  REQUIRE(solution.has_value());
+
+  // Only the obstacle on the path is applied, at the segment's samples and its
+  // last waypoint, and the solution clears both
+  CHECK(stats.constraint_counts.at("PointPointMinConstraint") == 11);
+  CHECK(stats.removed_duplicate_constraints == 0);
+  CHECK(stats.inactive_constraints == 11);
+  for (size_t i = 0; i < solution->x.size(); ++i) {
+    CHECK(std::hypot(solution->x[i] - 2.0, solution->y[i] - 0.1) >=
+          0.5 - 1e-3);
+  }
+}
+
+TEST_CASE("SwerveTrajectoryGenerator - Generation budget",
+          "[SwerveTrajectoryGenerator]") {
+  trajopt::SwerveTrajectoryGenerator limited{make_path(1.0, 2.0)};
+  auto result =
+      limited.generate(trajopt::GenerationBudget{.max_iterations = 2});
+
+  CHECK(result.budget_exhausted);
+  CHECK(result.status == slp::ExitStatus::CALLBACK_REQUESTED_STOP);
+  REQUIRE(result.solution.has_value());
+  CHECK(result.solution->x.size() == 11);
+  CHECK(std::isfinite(result.violation));
+
+  trajopt::SwerveTrajectoryGenerator unlimited{make_path(1.0, 2.0)};
+  result = unlimited.generate(trajopt::GenerationBudget{});
+
+  CHECK_FALSE(result.budget_exhausted);
+  CHECK(result.status == slp::ExitStatus::SUCCESS);
+  REQUIRE(result.solution.has_value());
+  CHECK(result.violation < 1e-3);
+}
+
+TEST_CASE("FlatSwerveTrajectory - Round trip", "[SwerveTrajectoryGenerator]") {
+  using enum trajopt::FlatSwerveTrajectory::Field;
+
+  trajopt::SwerveSolution solution{
+      .dt = {0.5, 0.25, 0.0},
+      .x = {0.0, 1.0, 2.0},
+      .y = {0.0, -1.0, -2.0},
+      .thetacos = {1.0, 0.0, -1.0},
+      .thetasin = {0.0, 1.0, 0.0},
+      .vx = {1.0, 2.0, 3.0},
+      .vy = {4.0, 5.0, 6.0},
+      .omega = {7.0, 8.0, 9.0},
+      .ax = {0.1, 0.2, 0.3},
+      .ay = {0.4, 0.5, 0.6},
+      .alpha = {0.7, 0.8, 0.9},
+      .module_fx = {{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}},
+      .module_fy = {{-1.0, -2.0}, {-3.0, -4.0}, {-5.0, -6.0}}};
+
+  trajopt::FlatSwerveTrajectory flat{solution};
+  REQUIRE(flat.size() == 3);
+  REQUIRE(flat.module_count() == 2);
+  CHECK(flat.data().size() == 3 * (trajopt::FlatSwerveTrajectory::field_count +
+                                   2 * flat.module_count()));
+
+  CHECK_THAT(flat.column(TIMESTAMP)[2], WithinRel(0.75));
+  CHECK_THAT(flat.column(HEADING)[1], WithinRel(std::numbers::pi / 2));
+  CHECK_THAT(flat.column(ANGULAR_ACCELERATION)[2], WithinRel(0.9));
+  CHECK(flat.module_forces_x(1)[2] == 6.0);
+  CHECK(flat.module_forces_y(0)[1] == -3.0);
+
+  // Matches the sample layout, and converts back to the same buffer
+  trajopt::SwerveTrajectory trajectory{solution};
+  auto samples = flat.to_trajectory().samples;
+  REQUIRE(samples.size() == trajectory.samples.size());
+  for (size_t index = 0; index < samples.size(); ++index) {
+    CHECK(samples[index].timestamp == trajectory.samples[index].timestamp);
+    CHECK(samples[index].heading == trajectory.samples[index].heading);
+    CHECK(samples[index].module_forces_x ==
+          trajectory.samples[index].module_forces_x);
+    CHECK(samples[index].module_forces_y ==
+          trajectory.samples[index].module_forces_y);
+  }
+  CHECK(std::ranges::equal(trajopt::FlatSwerveTrajectory{trajectory}.data(),
+                           flat.data()));
+}
@@ -0,0 +1,74 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <numeric>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/two_stage_trajectory_generator.hpp>
+
+#include "test_fixtures.hpp"
+
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+namespace {
+
+trajopt::SwervePathBuilder make_path() {
+  return test_fixtures::make_swerve_path({{0.0, 0.0, 0.0}, {4.0, 2.0, 1.0}},
+                                         {20});
+}
+
+double total_time(const trajopt::SwerveSolution& solution) {
+  return std::accumulate(solution.dt.begin(), solution.dt.end(), 0.0);
+}
+
+}  // namespace
+
+TEST_CASE("PointMassTrajectoryGenerator - Distributed module forces",
+          "[TwoStageTrajectoryGenerator]") {
+  auto path = make_path();
+  const auto& drivetrain = path.get_drivetrain();
+
+  trajopt::GenerationStats stats;
+  auto solution =
+      trajopt::PointMassTrajectoryGenerator{path}.generate(false, &stats);
+  REQUIRE(solution.has_value());
+  CHECK_FALSE(stats.decision_variable_counts.contains("inputs"));
+
+  // The forces produce the solution's accelerations
+  for (size_t index = 0; index < solution->x.size(); ++index) {
+    trajopt::Rotation2d θ{solution->thetacos[index],
+                          solution->thetasin[index]};
+    double Fx_net = 0.0;
+    double Fy_net = 0.0;
+    double τ_net = 0.0;
+    for (size_t module_index = 0; module_index < drivetrain.modules.size();
+         ++module_index) {
+      auto r = drivetrain.modules[module_index].rotate_by(θ);
+      double Fx = solution->module_fx[index][module_index];
+      double Fy = solution->module_fy[index][module_index];
+      Fx_net += Fx;
+      Fy_net += Fy;
+      τ_net += r.x() * Fy - r.y() * Fx;
+    }
+    CHECK_THAT(Fx_net, WithinAbs(drivetrain.mass * solution->ax[index], 1e-9));
+    CHECK_THAT(Fy_net, WithinAbs(drivetrain.mass * solution->ay[index], 1e-9));
+    CHECK_THAT(τ_net, WithinAbs(drivetrain.moi * solution->alpha[index], 1e-9));
+  }
+}
+
+TEST_CASE("TwoStageTrajectoryGenerator - Matches single-stage solve",
+          "[TwoStageTrajectoryGenerator]") {
+  auto reference = trajopt::SwerveTrajectoryGenerator{make_path()}.generate();
+  REQUIRE(reference.has_value());
+
+  trajopt::TwoStageTrajectoryGenerator generator{make_path()};
+  trajopt::GenerationStats stats;
+  auto solution = generator.generate(false, &stats);
+  REQUIRE(solution.has_value());
+
+  CHECK(solution->x.size() == 21);
+  CHECK(stats.decision_variable_counts.at("inputs") == 8 * 21);
+  CHECK_THAT(total_time(solution.value()),
+             WithinRel(total_time(reference.value()), 1e-3));
+}
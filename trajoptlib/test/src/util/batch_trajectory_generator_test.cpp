@@ -0,0 +1,104 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <stdint.h>
+
+#include <exception>
+#include <stdexcept>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <sleipnir/optimization/solver/exit_status.hpp>
+#include <trajopt/batch_trajectory_generator.hpp>
+
+#include "test_fixtures.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+trajopt::SwervePathBuilder make_path(double end_x) {
+  return test_fixtures::make_swerve_path({{0.0, 0.0, 0.0}, {end_x, 0.0, 0.0}},
+                                         {10});
+}
+
+}  // namespace
+
+TEST_CASE("BatchTrajectoryGenerator - Per-job results",
+          "[BatchTrajectoryGenerator]") {
+  trajopt::SwerveBatchTrajectoryGenerator batch;
+  batch.add_job(make_path(1.0), 1);
+  batch.add_job(make_path(2.0), 2);
+  batch.add_job(make_path(3.0), 3);
+
+  auto results = batch.generate(2);
+
+  REQUIRE(results.size() == 3);
+  for (size_t i = 0; i < results.size(); ++i) {
+    CHECK(results[i].handle == static_cast<int64_t>(i + 1));
+    CHECK_FALSE(results[i].exception);
+    REQUIRE(results[i].solution.has_value());
+    CHECK_THAT(results[i].solution->x.back(), WithinAbs(i + 1.0, 1e-6));
+    CHECK(results[i].stats.iterations > 0);
+  }
+}
+
+TEST_CASE("BatchTrajectoryGenerator - Per-job cancellation",
+          "[BatchTrajectoryGenerator]") {
+  // The first job cancels the second while it's queued, once
+  trajopt::CancellationToken second;
+  bool cancelled = false;
+  auto first_path = make_path(1.0);
+  first_path.add_callback([&](const trajopt::SwerveSolution&, int64_t) {
+    if (!cancelled) {
+      second.cancel();
+      cancelled = true;
+    }
+  });
+
+  trajopt::SwerveBatchTrajectoryGenerator batch;
+  batch.add_job(first_path, 1);
+  second = batch.add_job(make_path(2.0), 2);
+  batch.add_job(make_path(3.0), 3);
+
+  auto results = batch.generate(1);
+
+  REQUIRE(results.size() == 3);
+  CHECK(results[0].solution.has_value());
+  REQUIRE_FALSE(results[1].solution.has_value());
+  CHECK(results[1].solution.error() ==
+        slp::ExitStatus::CALLBACK_REQUESTED_STOP);
+  CHECK_FALSE(results[1].exception);
+  CHECK(results[1].stats.iterations == 0);
+  CHECK(results[2].solution.has_value());
+
+  // The next run starts with the cancellation cleared
+  results = batch.generate(1);
+
+  REQUIRE(results.size() == 3);
+  for (const auto& result : results) {
+    CHECK(result.solution.has_value());
+  }
+}
+
+TEST_CASE("BatchTrajectoryGenerator - Exception capture",
+          "[BatchTrajectoryGenerator]") {
+  auto throwing_path = make_path(1.0);
+  throwing_path.add_callback([](const trajopt::SwerveSolution&, int64_t) {
+    throw std::runtime_error{"callback failed"};
+  });
+
+  trajopt::SwerveBatchTrajectoryGenerator batch;
+  batch.add_job(throwing_path, 1);
+  batch.add_job(make_path(2.0), 2);
+
+  auto results = batch.generate(2);
+
+  REQUIRE(results.size() == 2);
+  REQUIRE(results[0].exception);
+  CHECK_THROWS_AS(std::rethrow_exception(results[0].exception),
+                  std::runtime_error);
+  CHECK_FALSE(results[0].solution.has_value());
+
+  CHECK_FALSE(results[1].exception);
+  CHECK(results[1].solution.has_value());
+}
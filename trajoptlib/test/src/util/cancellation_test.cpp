@@ -0,0 +1,57 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <stdint.h>
+
+#include <expected>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+#include <sleipnir/optimization/solver/exit_status.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/cancellation.hpp>
+
+#include "test_fixtures.hpp"
+
+TEST_CASE("CancellationToken - Copies share a flag", "[CancellationToken]") {
+  trajopt::CancellationToken token;
+  auto copy = token;
+  trajopt::CancellationToken other;
+
+  copy.cancel();
+  CHECK(token.is_cancelled());
+  CHECK_FALSE(other.is_cancelled());
+
+  token.reset();
+  CHECK_FALSE(copy.is_cancelled());
+}
+
+TEST_CASE("CancellationToken - Stops only its own solve",
+          "[CancellationToken]") {
+  // The cancelled path cancels its own token from its first iteration, while
+  // the other path's solve runs alongside it on a separate thread
+  trajopt::CancellationToken token;
+  auto cancelled_path = test_fixtures::make_swerve_path(
+      {{0.0, 0.0, 0.0}, {4.0, 2.0, 1.0}}, {20});
+  cancelled_path.add_callback(
+      [token](const trajopt::SwerveSolution&, int64_t) { token.cancel(); });
+  trajopt::SwerveTrajectoryGenerator cancelled{cancelled_path, 1};
+  cancelled.set_cancellation_token(token);
+
+  trajopt::SwerveTrajectoryGenerator other{
+      test_fixtures::make_swerve_path({{0.0, 0.0, 0.0}, {4.0, 2.0, 1.0}},
+                                      {20}),
+      2};
+
+  std::expected<trajopt::SwerveSolution, slp::ExitStatus> cancelled_result;
+  std::expected<trajopt::SwerveSolution, slp::ExitStatus> other_result;
+  {
+    std::jthread cancelled_thread{
+        [&] { cancelled_result = cancelled.generate(); }};
+    std::jthread other_thread{[&] { other_result = other.generate(); }};
+  }
+
+  REQUIRE_FALSE(cancelled_result.has_value());
+  CHECK(cancelled_result.error() == slp::ExitStatus::CALLBACK_REQUESTED_STOP);
+  CHECK(other_result.has_value());
+  CHECK_FALSE(other.get_cancellation_token().is_cancelled());
+}
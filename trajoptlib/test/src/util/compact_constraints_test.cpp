@@ -0,0 +1,69 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/compact_constraints.hpp>
+
+TEST_CASE("compact_constraints - Segment copies on waypoints",
+          "[compact_constraints]") {
+  using namespace trajopt;
+
+  SwervePathBuilder builder;
+  builder.pose_wpt(0, 0.0, 0.0, 0.0);
+  builder.pose_wpt(1, 1.0, 0.0, 0.0);
+  builder.pose_wpt(2, 2.0, 0.0, 0.0);
+  builder.sgmt_constraint(0, 2, LinearVelocityMaxMagnitudeConstraint{1.0});
+  builder.set_control_interval_counts({3, 4});
+
+  auto path = builder.get_path();
+  CHECK(compact_constraints(path, builder.get_control_interval_counts()) == 2);
+
+  // The first two waypoints start a constrained segment, so only the last
+  // keeps its copy
+  CHECK(path.waypoints[0].waypoint_constraints.size() == 1);
+  CHECK(path.waypoints[1].waypoint_constraints.size() == 1);
+  CHECK(path.waypoints[2].waypoint_constraints.size() == 2);
+  CHECK(path.waypoints[1].segment_constraints.size() == 1);
+  CHECK(path.waypoints[2].segment_constraints.size() == 1);
+}
+
+TEST_CASE("compact_constraints - Repeated constraints",
+          "[compact_constraints]") {
+  using namespace trajopt;
+
+  SwervePathBuilder builder;
+  builder.pose_wpt(0, 0.0, 0.0, 0.0);
+  builder.pose_wpt(1, 1.0, 0.0, 0.0);
+  builder.sgmt_constraint(0, 1, AngularVelocityMaxMagnitudeConstraint{1.0});
+  builder.sgmt_constraint(0, 1, AngularVelocityMaxMagnitudeConstraint{1.0});
+  builder.sgmt_constraint(0, 1, AngularVelocityMaxMagnitudeConstraint{2.0});
+  builder.set_control_interval_counts({5});
+
+  auto path = builder.get_path();
+
+  // The repeated segment constraint on each of the segment's 5 samples, and
+  // the first waypoint's 3 copies. The last waypoint's repeated copy goes too.
+  CHECK(compact_constraints(path, builder.get_control_interval_counts()) ==
+        5 + 3 + 1);
+  CHECK(path.waypoints[0].waypoint_constraints.size() == 1);
+  CHECK(path.waypoints[1].waypoint_constraints.size() == 3);
+  CHECK(path.waypoints[1].segment_constraints.size() == 2);
+}
+
+TEST_CASE("compact_constraints - Empty segment", "[compact_constraints]") {
+  using namespace trajopt;
+
+  SwervePathBuilder builder;
+  builder.pose_wpt(0, 0.0, 0.0, 0.0);
+  builder.pose_wpt(1, 0.0, 0.0, 0.0);
+  builder.sgmt_constraint(0, 1, LinearVelocityMaxMagnitudeConstraint{1.0});
+  builder.set_control_interval_counts({0});
+
+  // A segment without control intervals constrains no samples, so the
+  // waypoints keep their copies
+  auto path = builder.get_path();
+  CHECK(compact_constraints(path, builder.get_control_interval_counts()) == 0);
+  CHECK(path.waypoints[0].waypoint_constraints.size() == 2);
+}
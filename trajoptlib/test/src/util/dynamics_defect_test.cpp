@@ -0,0 +1,92 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/dynamics_defect.hpp>
+
+#include "test_fixtures.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+constexpr trajopt::Transcription transcriptions[] = {
+    trajopt::Transcription::CONSTANT_ACCELERATION,
+    trajopt::Transcription::HERMITE_SIMPSON,
+    trajopt::Transcription::RUNGE_KUTTA_4};
+
+// Constant acceleration of 2 m/s² along x from rest, sampled every 0.5 s
+trajopt::SwerveSolution make_solution() {
+  std::vector<double> zeros(5, 0.0);
+  std::vector<std::vector<double>> forces(5, std::vector<double>{});
+  return trajopt::SwerveSolution{{0.5, 0.5, 0.5, 0.5, 0.5},
+                                 {0.0, 0.25, 1.0, 2.25, 4.0},
+                                 zeros,
+                                 std::vector<double>(5, 1.0),
+                                 zeros,
+                                 {0.0, 1.0, 2.0, 3.0, 4.0},
+                                 zeros,
+                                 zeros,
+                                 std::vector<double>(5, 2.0),
+                                 zeros,
+                                 zeros,
+                                 forces,
+                                 forces};
+}
+
+}  // namespace
+
+TEST_CASE("dynamics_defects - Exact motion has no defect", "[TrajoptUtil]") {
+  for (auto transcription : transcriptions) {
+    for (double defect :
+         trajopt::dynamics_defects(test_fixtures::swerve_drivetrain(),
+                                   make_solution(), transcription)) {
+      CHECK_THAT(defect, WithinAbs(0.0, 1e-12));
+    }
+  }
+}
+
+TEST_CASE("dynamics_defects - Exact differential motion has no defect",
+          "[TrajoptUtil]") {
+  auto drivetrain = test_fixtures::differential_drivetrain();
+
+  // Constant speed of 1 m/s along x with no wheel forces, sampled every 0.5 s
+  std::vector<double> zeros(5, 0.0);
+  std::vector<double> ones(5, 1.0);
+  trajopt::DifferentialSolution solution{{0.5, 0.5, 0.5, 0.5, 0.5},
+                                         {0.0, 0.5, 1.0, 1.5, 2.0},
+                                         zeros,
+                                         zeros,
+                                         ones,
+                                         ones,
+                                         zeros,
+                                         zeros,
+                                         zeros,
+                                         zeros,
+                                         zeros,
+                                         zeros};
+
+  for (auto transcription : transcriptions) {
+    for (double defect :
+         trajopt::dynamics_defects(drivetrain, solution, transcription)) {
+      CHECK_THAT(defect, WithinAbs(0.0, 1e-12));
+    }
+  }
+}
+
+TEST_CASE("dynamics_defects - Largest defect per segment", "[TrajoptUtil]") {
+  auto solution = make_solution();
+
+  // Only the last interval is off, by 0.5 m in position
+  solution.x[4] += 0.5;
+
+  auto defects = trajopt::segment_dynamics_defects(
+      test_fixtures::swerve_drivetrain(), solution, {2, 2},
+      trajopt::Transcription::CONSTANT_ACCELERATION);
+  CHECK_THAT(defects[0], WithinAbs(0.0, 1e-12));
+  CHECK_THAT(defects[1], WithinAbs(0.5, 1e-12));
+}
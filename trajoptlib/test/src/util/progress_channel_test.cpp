@@ -0,0 +1,28 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/util/progress_channel.hpp>
+
+TEST_CASE("ProgressChannel - Receives latest update", "[ProgressChannel]") {
+  trajopt::ProgressChannel<std::vector<double>> channel;
+
+  CHECK_FALSE(channel.receive());
+
+  channel.write_buffer() = {1.0};
+  channel.publish();
+  channel.write_buffer() = {2.0};
+  channel.publish();
+
+  // Only the latest update is received
+  CHECK(channel.receive());
+  CHECK(channel.read_buffer() == std::vector{2.0});
+  CHECK_FALSE(channel.receive());
+  CHECK(channel.read_buffer() == std::vector{2.0});
+
+  channel.write_buffer() = {3.0};
+  channel.publish();
+  CHECK(channel.receive());
+  CHECK(channel.read_buffer() == std::vector{3.0});
+}
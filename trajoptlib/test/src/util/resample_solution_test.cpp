@@ -0,0 +1,57 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/resample_solution.hpp>
+
+namespace {
+
+trajopt::SwerveSolution make_solution(std::vector<double> dt,
+                                      std::vector<double> x,
+                                      std::vector<double> vx,
+                                      std::vector<std::vector<double>> fx) {
+  size_t samp_tot = x.size();
+  std::vector<double> zeros(samp_tot, 0.0);
+  return trajopt::SwerveSolution{std::move(dt),
+                                 std::move(x),
+                                 zeros,
+                                 std::vector<double>(samp_tot, 1.0),
+                                 zeros,
+                                 std::move(vx),
+                                 zeros,
+                                 zeros,
+                                 zeros,
+                                 zeros,
+                                 zeros,
+                                 fx,
+                                 fx};
+}
+
+}  // namespace
+
+TEST_CASE("resample_solution - Finer control intervals", "[TrajoptUtil]") {
+  auto solution =
+      make_solution({0.5, 0.5, 0.5}, {0, 1, 2}, {2, 2, 2}, {{0}, {2}, {4}});
+
+  auto result = trajopt::resample_solution(solution, {2}, {4});
+
+  CHECK(result.x == std::vector<double>{0, 0.5, 1, 1.5, 2});
+  CHECK(result.dt == std::vector<double>{0.25, 0.25, 0.25, 0.25, 0.25});
+  CHECK(result.vx == std::vector<double>{2, 2, 2, 2, 2});
+  CHECK(result.thetacos == std::vector<double>{1, 1, 1, 1, 1});
+  CHECK(result.module_fx ==
+        std::vector<std::vector<double>>{{0}, {1}, {2}, {3}, {4}});
+}
+
+TEST_CASE("resample_solution - Segments keep their durations",
+          "[TrajoptUtil]") {
+  auto solution = make_solution({1, 2, 2}, {0, 1, 3}, {0, 0, 0}, {{}, {}, {}});
+
+  auto result = trajopt::resample_solution(solution, {1, 1}, {1, 2});
+
+  CHECK(result.x == std::vector<double>{0, 1, 2, 3});
+  CHECK(result.dt == std::vector<double>{1, 1, 1, 1});
+}
@@ -0,0 +1,136 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <stdint.h>
+
+#include <bit>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/formulation.hpp>
+#include <trajopt/util/solution_cache.hpp>
+
+#include "test_fixtures.hpp"
+
+namespace {
+
+trajopt::SwervePathBuilder make_path() {
+  auto path = test_fixtures::make_swerve_path(
+      {{0.0, 0.0, 0.0}, {4.0, 0.0, 0.0}}, {20});
+  path.set_bumpers(0.7, 0.7, 0.7, 0.7);
+  return path;
+}
+
+}  // namespace
+
+TEST_CASE("PathBuilder - Content hash", "[SolutionCache]") {
+  auto path = make_path();
+  CHECK(path.content_hash() == make_path().content_hash());
+
+  auto moved = make_path();
+  moved.pose_wpt(1, 4.0, 0.5, 0.0);
+  CHECK(moved.content_hash() != path.content_hash());
+
+  auto constrained = make_path();
+  constrained.sgmt_constraint(
+      0, 1, trajopt::LinearVelocityMaxMagnitudeConstraint{1.0});
+  CHECK(constrained.content_hash() != path.content_hash());
+
+  auto refined = make_path();
+  refined.set_control_interval_counts({21});
+  CHECK(refined.content_hash() != path.content_hash());
+}
+
+TEST_CASE("SolutionCache - Round trip", "[SolutionCache]") {
+  auto directory =
+      std::filesystem::temp_directory_path() / "trajopt_solution_cache_test";
+  std::filesystem::remove_all(directory);
+
+  trajopt::SwerveSolution solution{
+      {0.1, 0.1, 0.0},
+      {0.0, 1.0 / 3.0, std::numeric_limits<double>::denorm_min()},
+      {0.0, -0.0, 2.0},
+      {1.0, 1.0, 1.0},
+      {0.0, 0.0, 0.0},
+      {0.0, 1e-300, 0.0},
+      {0.0, 0.0, 0.0},
+      {0.0, 0.0, 0.0},
+      {0.0, 0.0, 0.0},
+      {0.0, 0.0, 0.0},
+      {0.0, 0.0, 0.0},
+      {{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}},
+      {{-1.0, -2.0}, {-3.0, -4.0}, {-5.0, -6.0}}};
+
+  trajopt::SolutionCache<trajopt::SwerveSolution> cache{directory};
+  uint64_t key = make_path().content_hash();
+
+  CHECK_FALSE(cache.load(key).has_value());
+  REQUIRE(cache.store(key, solution));
+  auto loaded = cache.load(key);
+  REQUIRE(loaded.has_value());
+
+  auto same_bits = [](const std::vector<double>& a,
+                      const std::vector<double>& b) {
+    if (a.size() != b.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+      if (std::bit_cast<uint64_t>(a[i]) != std::bit_cast<uint64_t>(b[i])) {
+        return false;
+      }
+    }
+    return true;
+  };
+  CHECK(same_bits(loaded->dt, solution.dt));
+  CHECK(same_bits(loaded->x, solution.x));
+  CHECK(same_bits(loaded->y, solution.y));
+  CHECK(same_bits(loaded->vx, solution.vx));
+  CHECK(loaded->module_fx == solution.module_fx);
+  CHECK(loaded->module_fy == solution.module_fy);
+
+  CHECK(cache.hits() == 1);
+  CHECK(cache.misses() == 1);
+
+  // A different key misses
+  CHECK_FALSE(cache.load(key + 1).has_value());
+  CHECK(cache.misses() == 2);
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("SolutionCache - Formulation version", "[SolutionCache]") {
+  auto directory = std::filesystem::temp_directory_path() /
+                   "trajopt_solution_cache_version_test";
+  std::filesystem::remove_all(directory);
+
+  trajopt::SwerveSolution solution{
+      {0.1}, {0.0}, {0.0}, {1.0}, {0.0}, {0.0}, {0.0},
+      {0.0}, {0.0}, {0.0}, {0.0}, {{0.0}}, {{0.0}}};
+
+  trajopt::SolutionCache<trajopt::SwerveSolution> cache{directory};
+  uint64_t key = make_path().content_hash();
+  REQUIRE(cache.store(key, solution));
+  REQUIRE(cache.load(key).has_value());
+
+  // A solution stored by another formulation of the generators misses
+  auto file = directory / std::format("{:016x}.trajopt", key);
+  {
+    std::fstream stream{file, std::ios::binary | std::ios::in | std::ios::out};
+    stream.seekp(8);
+    uint64_t version = trajopt::FORMULATION_VERSION + 1;
+    for (int byte = 0; byte < 8; ++byte) {
+      stream.put(static_cast<char>((version >> (8 * byte)) & 0xff));
+    }
+  }
+  CHECK_FALSE(cache.load(key).has_value());
+
+  // And is replaced on the next store
+  REQUIRE(cache.store(key, solution));
+  CHECK(cache.load(key).has_value());
+
+  std::filesystem::remove_all(directory);
+}
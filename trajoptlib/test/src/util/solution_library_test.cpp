@@ -0,0 +1,68 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/solution_library.hpp>
+
+#include "test_fixtures.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+trajopt::SwervePathBuilder make_path(double end_x, double end_y,
+                                     size_t control_interval_count) {
+  return test_fixtures::make_swerve_path(
+      {{0.0, 0.0, 0.0}, {end_x, end_y, 0.0}}, {control_interval_count});
+}
+
+}  // namespace
+
+TEST_CASE("SolutionLibrary - Seed from nearest solution", "[SolutionLibrary]") {
+  std::vector<double> zeros(5, 0.0);
+  std::vector<std::vector<double>> forces(5, std::vector<double>(4, 0.0));
+  trajopt::SwerveSolution solution{{0.5, 0.5, 0.5, 0.5, 0.5},
+                                   {0.0, 1.0, 2.0, 3.0, 4.0},
+                                   zeros,
+                                   std::vector<double>(5, 1.0),
+                                   zeros,
+                                   {0.0, 2.0, 2.0, 2.0, 0.0},
+                                   zeros,
+                                   zeros,
+                                   zeros,
+                                   zeros,
+                                   zeros,
+                                   forces,
+                                   forces};
+
+  trajopt::SolutionLibrary<trajopt::SwerveDrivetrain, trajopt::SwerveSolution>
+      library;
+  library.add(make_path(4.0, 0.0, 4), solution);
+  CHECK(library.size() == 1);
+
+  // A moved waypoint and finer layout get the stored solution warped and
+  // resampled
+  auto seed = library.seed(make_path(4.0, 0.5, 8));
+  REQUIRE(seed.has_value());
+  REQUIRE(seed->x.size() == 9);
+  CHECK_THAT(seed->x.front(), WithinAbs(0.0, 1e-12));
+  CHECK_THAT(seed->y.front(), WithinAbs(0.0, 1e-12));
+  CHECK_THAT(seed->x.back(), WithinAbs(4.0, 1e-12));
+  CHECK_THAT(seed->y.back(), WithinAbs(0.5, 1e-12));
+  CHECK_THAT(seed->y[4], WithinAbs(0.25, 1e-12));
+  // The velocity turns with the segment toward the moved waypoint
+  CHECK(seed->vx[4] > 0.0);
+  CHECK_THAT(seed->vy[4], WithinAbs(seed->vx[4] * 0.5 / 4.0, 1e-12));
+  // The longer segment takes longer
+  CHECK(seed->dt[0] > 0.25);
+
+  // Paths too far away or with other waypoints have no seed
+  CHECK_FALSE(library.seed(make_path(4.0, 2.0, 8)).has_value());
+
+  auto longer = make_path(4.0, 0.0, 4);
+  longer.pose_wpt(2, 5.0, 0.0, 0.0);
+  CHECK_FALSE(library.seed(longer).has_value());
+}
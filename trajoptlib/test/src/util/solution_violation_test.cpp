@@ -0,0 +1,85 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/solution_violation.hpp>
+
+#include "test_fixtures.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+trajopt::SwervePathBuilder make_path(double end_x) {
+  return test_fixtures::make_swerve_path({{0.0, 0.0, 0.0}, {end_x, 0.0, 0.0}},
+                                         {4});
+}
+
+// Constant speed of 1 m/s along x with no module forces, sampled every 0.5 s
+trajopt::SwerveSolution make_solution() {
+  std::vector<double> zeros(5, 0.0);
+  std::vector<std::vector<double>> forces(5, std::vector<double>(4, 0.0));
+  return trajopt::SwerveSolution{{0.5, 0.5, 0.5, 0.5, 0.5},
+                                 {0.0, 0.5, 1.0, 1.5, 2.0},
+                                 zeros,
+                                 std::vector<double>(5, 1.0),
+                                 zeros,
+                                 std::vector<double>(5, 1.0),
+                                 zeros,
+                                 zeros,
+                                 zeros,
+                                 zeros,
+                                 zeros,
+                                 forces,
+                                 forces};
+}
+
+double violation(trajopt::SwervePathBuilder& path,
+                 const trajopt::SwerveSolution& solution) {
+  return trajopt::solution_violation(
+      path.get_path(), path.get_control_interval_counts(), solution,
+      trajopt::Transcription::CONSTANT_ACCELERATION);
+}
+
+}  // namespace
+
+TEST_CASE("solution_violation - Feasible solution", "[TrajoptUtil]") {
+  auto path = make_path(2.0);
+  CHECK_THAT(violation(path, make_solution()), WithinAbs(0.0, 1e-12));
+}
+
+TEST_CASE("solution_violation - Path constraints", "[TrajoptUtil]") {
+  // The last waypoint is 0.5 m past the solution's end
+  auto path = make_path(2.5);
+  CHECK_THAT(violation(path, make_solution()), WithinAbs(0.5, 1e-12));
+
+  // The segment's samples are 0.2 m/s over its velocity limit
+  path = make_path(2.0);
+  path.sgmt_constraint(0, 1,
+                       trajopt::LinearVelocityMaxMagnitudeConstraint{0.8});
+  CHECK_THAT(violation(path, make_solution()), WithinAbs(0.2, 1e-12));
+}
+
+TEST_CASE("solution_violation - Dynamics defects", "[TrajoptUtil]") {
+  auto path = make_path(2.0);
+  auto solution = make_solution();
+
+  // Ending 4 mm past where the last interval's motion reaches is a tenth of
+  // the 4 cm wheel radius, which outweighs missing the waypoint by 4 mm
+  solution.x.back() += 0.004;
+  CHECK_THAT(violation(path, solution), WithinAbs(0.1, 1e-12));
+}
+
+TEST_CASE("solution_violation - Module forces", "[TrajoptUtil]") {
+  auto path = make_path(2.0);
+  auto solution = make_solution();
+
+  // 60 N is 10 N over the wheel's 50 N torque limit, and unbalanced by the
+  // solution's zero acceleration by 0.3 of the 200 N the modules can push
+  // with together
+  solution.module_fx[2][0] = 60.0;
+  CHECK_THAT(violation(path, solution), WithinAbs(0.3, 1e-12));
+}
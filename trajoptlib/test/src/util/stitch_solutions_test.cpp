@@ -0,0 +1,40 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <numbers>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/util/stitch_solutions.hpp>
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("stitch_solutions - Shared samples and headings", "[TrajoptUtil]") {
+  auto make_solution = [](std::vector<double> dt, std::vector<double> x,
+                          std::vector<double> heading) {
+    std::vector<double> zeros(x.size(), 0.0);
+    return trajopt::DifferentialSolution{
+        dt,    x,     zeros, heading, zeros, zeros,
+        zeros, zeros, zeros, zeros,   zeros, zeros};
+  };
+
+  // The second part's heading is a whole turn off from where the first ends
+  auto first = make_solution({0.5, 0.5, 0.5}, {0.0, 1.0, 2.0}, {0.0, 0.5, 1.0});
+  auto second = make_solution({0.25, 0.25, 0.25}, {2.0, 2.5, 3.0},
+                              {1.0 - 2.0 * std::numbers::pi,
+                               1.5 - 2.0 * std::numbers::pi,
+                               2.0 - 2.0 * std::numbers::pi});
+
+  auto stitched = trajopt::stitch_solutions<trajopt::DifferentialSolution>(
+      {first, second});
+
+  CHECK(stitched.dt == std::vector<double>{0.5, 0.5, 0.25, 0.25, 0.25});
+  CHECK(stitched.x == std::vector<double>{0.0, 1.0, 2.0, 2.5, 3.0});
+  std::vector<double> expected_heading{0.0, 0.5, 1.0, 1.5, 2.0};
+  REQUIRE(stitched.heading.size() == expected_heading.size());
+  for (size_t i = 0; i < expected_heading.size(); ++i) {
+    CHECK_THAT(stitched.heading[i], WithinAbs(expected_heading[i], 1e-12));
+  }
+  CHECK(stitched.vl.size() == 5);
+}
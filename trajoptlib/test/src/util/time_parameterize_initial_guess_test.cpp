@@ -0,0 +1,73 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <trajopt/differential_trajectory_generator.hpp>
+#include <trajopt/swerve_trajectory_generator.hpp>
+#include <trajopt/util/generate_linear_initial_guess.hpp>
+#include <trajopt/util/time_parameterize_initial_guess.hpp>
+
+#include "test_fixtures.hpp"
+
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+TEST_CASE("time_parameterize_initial_guess - Swerve profile",
+          "[TrajoptUtil]") {
+  auto drivetrain = test_fixtures::swerve_drivetrain();
+  std::vector<std::vector<trajopt::Pose2d>> initial_guess_points{
+      {{0, 0, 0}}, {{4, 0, 0}}};
+  std::vector<size_t> control_interval_counts{10};
+
+  auto guess = trajopt::generate_linear_initial_guess<trajopt::SwerveSolution>(
+      initial_guess_points, control_interval_counts);
+  trajopt::time_parameterize_initial_guess(guess, control_interval_counts,
+                                           drivetrain);
+
+  REQUIRE(guess.x.size() == 11);
+  REQUIRE(guess.vx.size() == 11);
+  CHECK(guess.x.front() == 0.0);
+  CHECK_THAT(guess.x.back(), WithinAbs(4.0, 1e-12));
+  CHECK(guess.vx.front() == 0.0);
+  CHECK_THAT(guess.vx.back(), WithinAbs(0.0, 1e-12));
+  CHECK(guess.ax.front() > 0.0);
+  CHECK(guess.ax.back() < 0.0);
+
+  // Every interval takes the same time, and integrating the velocities over
+  // them covers the path
+  double distance = 0.0;
+  for (size_t index = 0; index < 10; ++index) {
+    CHECK(guess.dt[index] == guess.dt[0]);
+    CHECK(guess.x[index + 1] > guess.x[index]);
+    CHECK(guess.vx[index] <=
+          drivetrain.chassis_limits().max_velocity * (1.0 + 1e-9));
+    distance += (guess.vx[index] + guess.vx[index + 1]) / 2 * guess.dt[index];
+  }
+  CHECK_THAT(distance, WithinRel(4.0, 0.05));
+}
+
+TEST_CASE("time_parameterize_initial_guess - Differential wheel speeds",
+          "[TrajoptUtil]") {
+  auto drivetrain = test_fixtures::differential_drivetrain();
+  std::vector<std::vector<trajopt::Pose2d>> initial_guess_points{
+      {{0, 0, 0}}, {{0, 0, 1.0}}};
+  std::vector<size_t> control_interval_counts{8};
+
+  auto guess =
+      trajopt::generate_linear_initial_guess<trajopt::DifferentialSolution>(
+          initial_guess_points, control_interval_counts);
+  trajopt::time_parameterize_initial_guess(guess, control_interval_counts,
+                                           drivetrain);
+
+  // Turning in place drives the wheels in opposite directions
+  REQUIRE(guess.vl.size() == 9);
+  CHECK_THAT(guess.heading.back(), WithinAbs(1.0, 1e-12));
+  for (size_t index = 1; index < 8; ++index) {
+    CHECK(guess.vl[index] < 0.0);
+    CHECK_THAT(guess.vr[index], WithinAbs(-guess.vl[index], 1e-12));
+    CHECK_THAT(guess.angular_velocity[index],
+               WithinAbs((guess.vr[index] - guess.vl[index]) / 0.6, 1e-12));
+  }
+}
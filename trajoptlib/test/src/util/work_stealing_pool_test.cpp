@@ -0,0 +1,34 @@
+// Copyright (c) TrajoptLib contributors
+
+#include <atomic>
+
+#include <catch2/catch_test_macros.hpp>
+#include <trajopt/util/work_stealing_pool.hpp>
+
+TEST_CASE("WorkStealingPool - runs every task", "[WorkStealingPool]") {
+  trajopt::WorkStealingPool pool{4};
+  CHECK(pool.thread_count() == 4);
+
+  std::atomic<int> count = 0;
+  for (int i = 0; i < 100; ++i) {
+    pool.submit([&] { ++count; });
+  }
+  pool.wait();
+
+  CHECK(count == 100);
+}
+
+TEST_CASE("WorkStealingPool - tasks can submit tasks", "[WorkStealingPool]") {
+  trajopt::WorkStealingPool pool{2};
+
+  std::atomic<int> count = 0;
+  for (int i = 0; i < 10; ++i) {
+    pool.submit([&] {
+      ++count;
+      pool.submit([&] { ++count; });
+    });
+  }
+  pool.wait();
+
+  CHECK(count == 20);
+}